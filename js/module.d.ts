@@ -161,6 +161,11 @@ export declare const enum EFaderType {
     IEC = 1,
     Log = 2
 }
+export declare const enum EFaderField {
+    DeziBel = 0,
+    Deflection = 1,
+    Multiplier = 2
+}
 export declare const enum EColorFormat {
     Unknown = 0,
     A8 = 1,
@@ -341,6 +346,8 @@ export interface IIPC {
     connect(uri: string): void;
     host(uri: string): EIPCError;
     disconnect(): void;
+    enableSharedMemory(threshold?: number): boolean;
+    disableSharedMemory(): void;
 }
 export interface IGlobal {
     startup(locale: string, path?: string): void;
@@ -353,6 +360,9 @@ export interface IGlobal {
     readonly initialized: boolean;
     locale: string;
     multipleRendering: boolean;
+    outputStopDeadline: number;
+    readonly pendingOutputs: number;
+    encoderSharing: boolean;
     readonly version: number;
 }
 export interface IBooleanProperty extends IProperty {
@@ -438,6 +448,7 @@ export interface IFilter extends ISource {
 }
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
@@ -496,6 +507,8 @@ export interface IInput extends ISource {
     monitoringType: EMonitoringType;
     deinterlaceFieldOrder: EDeinterlaceFieldOrder;
     deinterlaceMode: EDeinterlaceMode;
+    getPropertiesAsync(): Promise<IProperties>;
+    getSettingsAsync(): Promise<ISettings>;
     duplicate(name?: string, isPrivate?: boolean): IInput;
     findFilter(name: string): IFilter;
     addFilter(filter: IFilter): void;
@@ -531,6 +544,7 @@ export interface IScene extends ISource {
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    getItemsAsync(): Promise<ISceneItem[]>;
 }
 export interface ISceneItem {
     readonly source: IInput;
@@ -566,6 +580,15 @@ export interface ITransitionFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): ITransition;
     createPrivate(id: string, name: string, settings?: ISettings): ITransition;
     fromName(name: string): ITransition;
+    preload(scene: IScene): IPreloadState;
+    releasePreload(scene: IScene): void;
+    preloadState(scene: IScene): IPreloadState;
+    warmCacheSize: number;
+}
+export interface IPreloadState {
+    readonly ready: boolean;
+    readonly readySources: number;
+    readonly totalSources: number;
 }
 export interface ITransition extends ISource {
     getActiveSource(): ISource;
@@ -595,6 +618,17 @@ export interface ISource extends IConfigurable, IReleasable {
 }
 export interface IFaderFactory {
     create(type: EFaderType): IFader;
+    getValues(faders: IFader[]): IFaderValues[];
+    setValues(faders: IFader[], field: EFaderField, values: number[]): IFaderValues[];
+    benchmarkSanitize(count: number, iterations: number): {
+        scalar: number;
+        simd: number;
+    };
+}
+export interface IFaderValues {
+    db: number;
+    deflection: number;
+    mul: number;
 }
 export interface IFader {
     db: number;
@@ -660,8 +694,16 @@ export interface IVideo {
     readonly skippedFrames: number;
     readonly encodedFrames: number;
 }
+export interface ICompositingStats {
+    readonly frames: number;
+    readonly renders: number;
+    readonly reuses: number;
+    readonly probed: number;
+}
 export interface IVideoFactory {
     create(): IVideo;
+    sharedCompositing: boolean;
+    readonly compositingStats: ICompositingStats;
 }
 export interface IAudio {
     sampleRate: (44100 | 48000);
@@ -686,6 +728,14 @@ export interface IModuleFactory extends IFactoryTypes {
     addPath(path: string, dataPath: string): void;
     logLoaded(): void;
     modules(): String[];
+    loadTimings(): IModuleLoadTiming[];
+}
+export interface IModuleLoadTiming {
+    readonly binPath: string;
+    readonly openTime: number;
+    readonly initTime: number;
+    readonly loaded: boolean;
+    readonly cached: boolean;
 }
 export interface IModule {
     initialize(): void;
@@ -697,7 +747,7 @@ export interface IModule {
     dataPath(): string;
     status(): number;
 }
-export declare function addItems(scene: IScene, sceneItems: ISceneItemInfo[]): ISceneItem[];
+export declare function addItems(scene: IScene, sceneItems: ISceneItemInfo[], canvas?: IVideo): ISceneItem[];
 export interface FilterInfo {
     name: string;
     type: string;
@@ -719,6 +769,27 @@ export interface SourceInfo {
     deinterlaceMode: EDeinterlaceMode;
     deinterlaceFieldOrder: EDeinterlaceFieldOrder;
 }
+export interface SceneCollectionInfo {
+    name: string;
+    scene?: IScene;
+    canvas?: IVideo;
+    items: ISceneItemInfo[];
+}
+export interface CollectionInfo {
+    sources: SourceInfo[];
+    scenes: SceneCollectionInfo[];
+    workers?: number;
+}
+export interface ICollectionLoadResult {
+    inputs: IInput[];
+    createTimes: number[];
+    scenes: {
+        scene: IScene;
+        items: ISceneItem[];
+    }[];
+    failed: string[];
+}
+export declare function loadCollection(collection: CollectionInfo): ICollectionLoadResult;
 export declare function createSources(sources: SourceInfo[]): IInput[];
 export interface ISourceSize {
     name: string;
@@ -792,8 +863,23 @@ export interface IStreaming {
     network: INetwork;
     video: IVideo;
     signalHandler: (signal: EOutputSignal) => void;
+    telemetryHandler: (samples: IOutputTelemetrySample[]) => void;
     start(): void;
     stop(force?: boolean): void;
+    getTelemetry(since?: number): IOutputTelemetrySample[];
+}
+export interface IOutputTelemetrySample {
+    sequence: number;
+    timestamp: number;
+    totalBytes: number;
+    kbitsPerSec: number;
+    congestion: number;
+    droppedFrames: number;
+    totalFrames: number;
+    skippedFrames: number;
+    encodedFrames: number;
+    laggedFrames: number;
+    renderedFrames: number;
 }
 export interface EOutputSignal {
     type: string;
@@ -832,6 +918,8 @@ export interface IFileOutput {
     muxerSettings: string;
     video: IVideo;
     lastFile(): string;
+    telemetryHandler: (samples: IOutputTelemetrySample[]) => void;
+    getTelemetry(since?: number): IOutputTelemetrySample[];
 }
 export interface IRecording extends IFileOutput {
     videoEncoder: IVideoEncoder;
@@ -871,6 +959,7 @@ export interface IAdvancedRecordingFactory {
 }
 export interface IReplayBuffer extends IFileOutput {
     duration: number;
+    maxSize: number;
     prefix: string;
     suffix: string;
     usesStream: boolean;
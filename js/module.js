@@ -43,44 +43,26 @@ exports.AdvancedReplayBufferFactory = obs.AdvancedReplayBuffer;
 ;
 ;
 ;
-function addItems(scene, sceneItems) {
-    const items = [];
-    if (Array.isArray(sceneItems)) {
-        sceneItems.forEach(function (sceneItem) {
-            const source = obs.Input.fromName(sceneItem.name);
-            const item = scene.add(source, sceneItem);
-            items.push(item);
-        });
+function addItems(scene, sceneItems, canvas) {
+    if (!Array.isArray(sceneItems)) {
+        return [];
     }
-    return items;
+    const result = obs.Collection.load({
+        sources: [],
+        scenes: [{ name: scene.name, scene: scene, canvas: canvas, items: sceneItems }]
+    });
+    return (result.scenes.length > 0 && result.scenes[0]) ? result.scenes[0].items : [];
 }
 exports.addItems = addItems;
+function loadCollection(collection) {
+    return obs.Collection.load(collection);
+}
+exports.loadCollection = loadCollection;
 function createSources(sources) {
-    const items = [];
-    if (Array.isArray(sources)) {
-        sources.forEach(function (source) {
-            const newSource = obs.Input.create(source.type, source.name, source.settings);
-            if (newSource.audioMixers) {
-                newSource.muted = (source.muted != null) ? source.muted : false;
-                newSource.volume = (source.volume != null) ? source.volume : 1;
-                newSource.syncOffset =
-                    (source.syncOffset != null) ? source.syncOffset : { sec: 0, nsec: 0 };
-            }
-            newSource.deinterlaceMode = source.deinterlaceMode;
-            newSource.deinterlaceFieldOrder = source.deinterlaceFieldOrder;
-            items.push(newSource);
-            const filters = source.filters;
-            if (Array.isArray(filters)) {
-                filters.forEach(function (filter) {
-                    const ObsFilter = obs.Filter.create(filter.type, filter.name, filter.settings);
-                    ObsFilter.enabled = (filter.enabled != null) ? filter.enabled : true;
-                    newSource.addFilter(ObsFilter);
-                    ObsFilter.release();
-                });
-            }
-        });
+    if (!Array.isArray(sources)) {
+        return [];
     }
-    return items;
+    return loadCollection({ sources: sources, scenes: [] }).inputs;
 }
 exports.createSources = createSources;
 function getSourcesSize(sourcesNames) {
@@ -226,6 +226,12 @@ export const enum EFaderType {
     Log /* Logarithmic */
 }
 
+export const enum EFaderField {
+    DeziBel,
+    Deflection,
+    Multiplier
+}
+
 export const enum EColorFormat {
 	Unknown,
 	A8,
@@ -474,6 +480,20 @@ export interface IIPC {
      * Disconnect from a server.
      */
 	disconnect(): void;
+
+    /**
+     * Hand large payloads (source settings, settings categories) over through
+     * a shared memory region instead of the socket. The region stays mapped
+     * until disconnect.
+     * @param threshold - Payloads of at least this many bytes use the region, defaults to 65536.
+     * @returns false if the region could not be created or attached by the server.
+     */
+	enableSharedMemory(threshold?: number): boolean;
+
+    /**
+     * Send every payload through the socket again.
+     */
+	disableSharedMemory(): void;
 }
  
 export interface IGlobal {
@@ -542,6 +562,24 @@ export interface IGlobal {
      */
     multipleRendering: boolean;
 
+    /**
+     * Milliseconds a destroyed or recreated output gets to stop on its own
+     * before it is force stopped. Teardown happens in the background, the
+     * output's signal handler receives its stop signals meanwhile.
+     */
+    outputStopDeadline: number;
+
+    /**
+     * Number of outputs still being stopped in the background
+     */
+    readonly pendingOutputs: number;
+
+    /**
+     * Outputs started with the same encoder settings on the same video
+     * context share one running encoder. Enabled by default.
+     */
+    encoderSharing: boolean;
+
     /**
      * Version of current libobs context.
      * Represented as a 32-bit unsigned integer.
@@ -740,6 +778,12 @@ export interface IInputFactory extends IFactoryTypes {
      */
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
 
+    /**
+     * Same as {@link create}, without blocking the event loop while the server builds the source
+     * @returns - Promise resolving to the instance, rejected on failure
+     */
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
+
     /**
      * Create a new instance of an ObsInput that's private
      * Private in this context means any function that returns an 
@@ -832,6 +876,16 @@ export interface IInput extends ISource {
     deinterlaceFieldOrder: EDeinterlaceFieldOrder;
     deinterlaceMode: EDeinterlaceMode;
 
+    /**
+     * Non-blocking {@link properties}, resolves from the cache when it is up to date
+     */
+    getPropertiesAsync(): Promise<IProperties>;
+
+    /**
+     * Non-blocking {@link settings}, resolves from the cache when it is up to date
+     */
+    getSettingsAsync(): Promise<ISettings>;
+
     /**
      * Create a new instance using the current instance. 
      * If no parameters are provide, an instance is created
@@ -1012,6 +1066,12 @@ export interface IScene extends ISource {
      * @returns - The array of item instances
      */
     getItems(): ISceneItem[];
+
+    /**
+     * Non-blocking {@link getItems}
+     * @returns - Promise resolving to the array of item instances
+     */
+    getItemsAsync(): Promise<ISceneItem[]>;
 }
 
 /**
@@ -1136,6 +1196,39 @@ export interface ITransitionFactory extends IFactoryTypes {
     createPrivate(id: string, name: string, settings?: ISettings): ITransition;
 
     fromName(name: string): ITransition;
+
+    /**
+     * Show a scene in the background so its sources load before a transition
+     * reaches it. The scene stays off program and out of the audio mix until
+     * released or transitioned to.
+     * @param scene - Scene to preload
+     * @returns - How many of its sources are ready so far
+     */
+    preload(scene: IScene): IPreloadState;
+
+    /**
+     * Stop keeping a preloaded scene loaded
+     */
+    releasePreload(scene: IScene): void;
+
+    /**
+     * Poll the loading progress of a scene's sources
+     */
+    preloadState(scene: IScene): IPreloadState;
+
+    /**
+     * Number of recently transitioned scenes kept loaded, 0 (the default) disables the warm cache
+     */
+    warmCacheSize: number;
+}
+
+export interface IPreloadState {
+    /**
+     * True once every source of the scene is ready
+     */
+    readonly ready: boolean;
+    readonly readySources: number;
+    readonly totalSources: number;
 }
 
 /**
@@ -1274,6 +1367,38 @@ export interface IFaderFactory {
      * @param type - What algorithm to use for new fader.
      */
     create(type: EFaderType): IFader;
+
+    /**
+     * Read the volume of many faders in one call
+     * @param faders - Faders to read, the result keeps their order
+     */
+    getValues(faders: IFader[]): IFaderValues[];
+
+    /**
+     * Set one volume field on many faders in one call
+     * @param faders - Faders to change
+     * @param field - Which of db, deflection or mul the values are given in
+     * @param values - One value per fader, non-finite values are clamped
+     * @returns The resulting volume of every fader
+     */
+    setValues(faders: IFader[], field: EFaderField, values: number[]): IFaderValues[];
+
+    /**
+     * Time the scalar and vectorized level sanitization on the server
+     * @param count - Number of levels per pass
+     * @param iterations - Number of passes
+     * @returns Nanoseconds spent by each implementation
+     */
+    benchmarkSanitize(count: number, iterations: number): { scalar: number, simd: number };
+}
+
+/**
+ * Volume of a fader in all three representations
+ */
+export interface IFaderValues {
+    db: number;
+    deflection: number;
+    mul: number;
 }
 
 /**
@@ -1443,8 +1568,41 @@ export interface IVideo {
      readonly encodedFrames: number;
 }
 
+export interface ICompositingStats {
+    /**
+     * Frames in which at least one shared input was drawn
+     */
+    readonly frames: number;
+
+    /**
+     * Shared inputs rendered into their cache texture
+     */
+    readonly renders: number;
+
+    /**
+     * Draws served from a cache texture already rendered this frame
+     */
+    readonly reuses: number;
+
+    /**
+     * Renders of sources below an osn_render_probe filter
+     */
+    readonly probed: number;
+}
+
 export interface IVideoFactory {
     create(): IVideo;
+
+    /**
+     * Render inputs shown on several video contexts only once per frame,
+     * each context samples the cached result with its own item transform
+     */
+    sharedCompositing: boolean;
+
+    /**
+     * Render counters of the shared compositing cache since startup
+     */
+    readonly compositingStats: ICompositingStats;
 }
 
 export interface IAudio {
@@ -1473,6 +1631,15 @@ export interface IModuleFactory extends IFactoryTypes {
     addPath(path: string, dataPath: string): void;
     logLoaded(): void;
     modules(): String[];
+    loadTimings(): IModuleLoadTiming[];
+}
+
+export interface IModuleLoadTiming {
+    readonly binPath: string;
+    readonly openTime: number; // ms, 0 when mapped by libobs itself
+    readonly initTime: number; // ms
+    readonly loaded: boolean;
+    readonly cached: boolean; // binary unchanged since the previous run
 }
 
 export interface IModule {
@@ -1486,16 +1653,20 @@ export interface IModule {
     status(): number;
 }
 
-export function addItems(scene: IScene, sceneItems: ISceneItemInfo[]): ISceneItem[] {
-    const items: ISceneItem[] = [];
-    if (Array.isArray(sceneItems)) {
-        sceneItems.forEach(function(sceneItem) {
-            const source = obs.Input.fromName(sceneItem.name);
-            const item = scene.add(source, sceneItem);
-            items.push(item);
-        });
+/**
+ * Adds the items to the scene in a single call to the server.
+ * Items whose source could not be found are null in the result.
+ * @param canvas - Video context the items are added to, the default one when omitted
+ */
+export function addItems(scene: IScene, sceneItems: ISceneItemInfo[], canvas?: IVideo): ISceneItem[] {
+    if (!Array.isArray(sceneItems)) {
+        return [];
     }
-    return items;
+    const result: ICollectionLoadResult = obs.Collection.load({
+        sources: [],
+        scenes: [{ name: scene.name, scene: scene, canvas: canvas, items: sceneItems }]
+    });
+    return (result.scenes.length > 0 && result.scenes[0]) ? result.scenes[0].items : [];
 }
 
 export interface FilterInfo {
@@ -1522,32 +1693,48 @@ export interface SourceInfo {
     deinterlaceFieldOrder: EDeinterlaceFieldOrder
 }
 
+export interface SceneCollectionInfo {
+    name: string,
+    /** Existing scene to add the items to, otherwise the scene is found by name or created */
+    scene?: IScene,
+    /** Video context the items are added to, the default one when omitted */
+    canvas?: IVideo,
+    items: ISceneItemInfo[]
+}
+
+export interface CollectionInfo {
+    sources: SourceInfo[],
+    scenes: SceneCollectionInfo[],
+    /** Number of threads constructing inputs concurrently, 0 or 1 loads them one at a time */
+    workers?: number
+}
+
+/**
+ * Every array follows the order of the description, entries that could not
+ * be created are null.
+ */
+export interface ICollectionLoadResult {
+    inputs: IInput[],
+    /** Time in milliseconds each input took to construct, in the same order as inputs */
+    createTimes: number[],
+    scenes: { scene: IScene, items: ISceneItem[] }[],
+    /** Names of the sources, scenes and items that could not be created */
+    failed: string[]
+}
+
+/**
+ * Creates all sources with their filters, then all scenes with their items,
+ * in a single call to the server.
+ */
+export function loadCollection(collection: CollectionInfo): ICollectionLoadResult {
+    return obs.Collection.load(collection);
+}
+
 export function createSources(sources: SourceInfo[]): IInput[] {
-    const items: IInput[] = [];
-    if (Array.isArray(sources)) {
-        sources.forEach(function (source) {
-            const newSource = obs.Input.create(source.type, source.name, source.settings);
-            if (newSource.audioMixers) {
-                newSource.muted = (source.muted != null) ? source.muted : false;
-                newSource.volume = (source.volume != null) ? source.volume : 1;
-                newSource.syncOffset =
-                (source.syncOffset != null) ? source.syncOffset : {sec: 0, nsec: 0};
-            }
-            newSource.deinterlaceMode = source.deinterlaceMode;
-            newSource.deinterlaceFieldOrder = source.deinterlaceFieldOrder;
-            items.push(newSource);
-            const filters = source.filters;
-            if (Array.isArray(filters)) {
-                    filters.forEach(function (filter) {
-                    const ObsFilter = obs.Filter.create(filter.type, filter.name, filter.settings);
-                    ObsFilter.enabled = (filter.enabled != null) ? filter.enabled : true;
-                    newSource.addFilter(ObsFilter);
-                    ObsFilter.release();
-                });
-            }
-        });
+    if (!Array.isArray(sources)) {
+        return [];
     }
-    return items;
+    return loadCollection({ sources: sources, scenes: [] }).inputs;
 }
 export interface ISourceSize {
     name: string,
@@ -1659,8 +1846,41 @@ export interface IStreaming {
     network: INetwork,
     video: IVideo,
     signalHandler: (signal: EOutputSignal) => void,
+    /**
+     * Called with the samples taken since the previous call while the output is live,
+     * set to null to stop receiving them
+     */
+    telemetryHandler: (samples: IOutputTelemetrySample[]) => void,
     start(): void,
     stop(force?: boolean): void,
+    /**
+     * Samples kept by the server for this output, oldest first
+     * @param since - Only return samples with a greater sequence number
+     */
+    getTelemetry(since?: number): IOutputTelemetrySample[],
+}
+
+/**
+ * One telemetry sample of a live output. Counters are cumulative since the
+ * output started, the server samples every output twice per second and keeps
+ * the last 240 samples.
+ */
+export interface IOutputTelemetrySample {
+    sequence: number,
+    /** Sample time in milliseconds */
+    timestamp: number,
+    totalBytes: number,
+    /** Bitrate since the previous sample */
+    kbitsPerSec: number,
+    congestion: number,
+    droppedFrames: number,
+    totalFrames: number,
+    /** Frames skipped by the video output of the output's canvas */
+    skippedFrames: number,
+    encodedFrames: number,
+    /** Frames the renderer missed */
+    laggedFrames: number,
+    renderedFrames: number
 }
 
 export interface EOutputSignal {
@@ -1704,7 +1924,17 @@ export interface IFileOutput {
     noSpace: boolean,
     muxerSettings: string,
     video: IVideo,
-    lastFile(): string
+    lastFile(): string,
+    /**
+     * Called with the samples taken since the previous call while the output is live,
+     * set to null to stop receiving them
+     */
+    telemetryHandler: (samples: IOutputTelemetrySample[]) => void,
+    /**
+     * Samples kept by the server for this output, oldest first
+     * @param since - Only return samples with a greater sequence number
+     */
+    getTelemetry(since?: number): IOutputTelemetrySample[]
 }
 
 export interface IRecording extends IFileOutput {
@@ -1750,12 +1980,21 @@ export interface IAdvancedRecordingFactory {
 
 export interface IReplayBuffer extends IFileOutput {
     duration: number,
+    /**
+     * Memory budget of the buffer in MB. Once exceeded the oldest packets
+     * are dropped up to the next keyframe.
+     */
+    maxSize: number,
     prefix: string,
     suffix: string,
     usesStream: boolean,
     signalHandler: (signal: EOutputSignal) => void,
     start(): void,
     stop(force?: boolean): void,
+    /**
+     * Writes the buffered packets to a file in the background, encoding is
+     * not interrupted. Completion is reported by the wrote signal.
+     */
     save(): void
 }
 
@@ -39,6 +39,7 @@ Napi::Object osn::AdvancedRecording::Init(Napi::Env env, Napi::Object exports)
 
 		 InstanceAccessor("videoEncoder", &osn::AdvancedRecording::GetVideoEncoder, &osn::AdvancedRecording::SetVideoEncoder),
 		 InstanceAccessor("signalHandler", &osn::AdvancedRecording::GetSignalHandler, &osn::AdvancedRecording::SetSignalHandler),
+		 InstanceAccessor("telemetryHandler", &osn::AdvancedRecording::GetTelemetryHandler, &osn::AdvancedRecording::SetTelemetryHandler),
 		 InstanceAccessor("mixer", &osn::AdvancedRecording::GetMixer, &osn::AdvancedRecording::SetMixer),
 		 InstanceAccessor("rescaling", &osn::AdvancedRecording::GetRescaling, &osn::AdvancedRecording::SetRescaling),
 		 InstanceAccessor("outputWidth", &osn::AdvancedRecording::GetOutputWidth, &osn::AdvancedRecording::SetOutputWidth),
@@ -53,6 +54,7 @@ Napi::Object osn::AdvancedRecording::Init(Napi::Env env, Napi::Object exports)
 
 		 InstanceMethod("start", &osn::AdvancedRecording::Start),
 		 InstanceMethod("stop", &osn::AdvancedRecording::Stop),
+		 InstanceMethod("getTelemetry", &osn::AdvancedRecording::GetTelemetry),
 		 InstanceMethod("splitFile", &osn::AdvancedRecording::SplitFile),
 
 		 StaticAccessor("legacySettings", &osn::AdvancedRecording::GetLegacySettings, &osn::AdvancedRecording::SetLegacySettings),
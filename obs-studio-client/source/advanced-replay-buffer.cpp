@@ -39,15 +39,18 @@ Napi::Object osn::AdvancedReplayBuffer::Init(Napi::Env env, Napi::Object exports
 			     InstanceAccessor("overwrite", &osn::AdvancedReplayBuffer::GetOverwrite, &osn::AdvancedReplayBuffer::SetOverwrite),
 			     InstanceAccessor("noSpace", &osn::AdvancedReplayBuffer::GetNoSpace, &osn::AdvancedReplayBuffer::SetNoSpace),
 			     InstanceAccessor("duration", &osn::AdvancedReplayBuffer::GetDuration, &osn::AdvancedReplayBuffer::SetDuration),
+			     InstanceAccessor("maxSize", &osn::AdvancedReplayBuffer::GetMaxSize, &osn::AdvancedReplayBuffer::SetMaxSize),
 			     InstanceAccessor("prefix", &osn::AdvancedReplayBuffer::GetPrefix, &osn::AdvancedReplayBuffer::SetPrefix),
 			     InstanceAccessor("suffix", &osn::AdvancedReplayBuffer::GetSuffix, &osn::AdvancedReplayBuffer::SetSuffix),
 			     InstanceAccessor("signalHandler", &osn::AdvancedReplayBuffer::GetSignalHandler, &osn::AdvancedReplayBuffer::SetSignalHandler),
+			     InstanceAccessor("telemetryHandler", &osn::AdvancedReplayBuffer::GetTelemetryHandler, &osn::AdvancedReplayBuffer::SetTelemetryHandler),
 			     InstanceAccessor("mixer", &osn::AdvancedReplayBuffer::GetMixer, &osn::AdvancedReplayBuffer::SetMixer),
 			     InstanceAccessor("usesStream", &osn::AdvancedReplayBuffer::GetUsesStream, &osn::AdvancedReplayBuffer::SetUsesStream),
 			     InstanceAccessor("video", &osn::AdvancedReplayBuffer::GetCanvas, &osn::AdvancedReplayBuffer::SetCanvas),
 
 			     InstanceMethod("start", &osn::AdvancedReplayBuffer::Start),
 			     InstanceMethod("stop", &osn::AdvancedReplayBuffer::Stop),
+			     InstanceMethod("getTelemetry", &osn::AdvancedReplayBuffer::GetTelemetry),
 
 			     InstanceMethod("save", &osn::AdvancedReplayBuffer::Save),
 			     InstanceMethod("lastFile", &osn::AdvancedReplayBuffer::GetLastFile),
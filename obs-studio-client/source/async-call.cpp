@@ -0,0 +1,111 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "async-call.hpp"
+#include "controller.hpp"
+#include "osn-error.hpp"
+
+// Same checks as ValidateResponse, reported as a message instead of a pending exception
+static std::string ResponseError(const std::vector<ipc::value> &response)
+{
+	if (response.size() == 0)
+		return "Failed to make IPC call, verify IPC status.";
+
+	if ((response.size() == 1) && (response[0].type == ipc::type::Null))
+		return response[0].value_str;
+
+	ErrorCode error = (ErrorCode)response[0].value_union.ui64;
+	if (error != ErrorCode::Ok) {
+		if (response.size() == 1)
+			return "IPC received error code " + std::to_string(uint64_t(error)) + ", no additional description provided.";
+		return response[1].value_str;
+	}
+
+	return "";
+}
+
+osn::AsyncCall::AsyncCall(Napi::Env env, const std::string &cname, const std::string &fname, std::vector<ipc::value> args, AsyncResolver resolver,
+			  AsyncFollowUp followUp)
+	: Napi::AsyncWorker(env, fname.c_str()),
+	  cname(cname),
+	  fname(fname),
+	  args(std::move(args)),
+	  resolver(resolver),
+	  followUp(followUp),
+	  deferred(Napi::Promise::Deferred::New(env))
+{
+}
+
+Napi::Promise osn::AsyncCall::Send(Napi::Env env, const std::string &cname, const std::string &fname, std::vector<ipc::value> args, AsyncResolver resolver,
+				   AsyncFollowUp followUp)
+{
+	// Queued fire-and-forget calls go first, the worker sends from another thread
+	Controller::GetInstance().FlushCalls();
+
+	// Deleted by the worker once the promise settles
+	AsyncCall *call = new AsyncCall(env, cname, fname, std::move(args), resolver, followUp);
+	Napi::Promise promise = call->deferred.Promise();
+	call->Queue();
+	return promise;
+}
+
+Napi::Promise osn::AsyncCall::Resolved(Napi::Env env, Napi::Value value)
+{
+	Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+	deferred.Resolve(value);
+	return deferred.Promise();
+}
+
+void osn::AsyncCall::Execute()
+{
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn) {
+		SetError("Failed to obtain IPC connection.");
+		return;
+	}
+
+	response = conn->call_synchronous_helper(cname, fname, args);
+
+	std::string error = ResponseError(response);
+	if (!error.empty()) {
+		SetError(error);
+		return;
+	}
+
+	if (followUp)
+		followUp(conn);
+}
+
+void osn::AsyncCall::OnOK()
+{
+	Napi::Env env = Env();
+	Napi::HandleScope scope(env);
+
+	Napi::Value value = resolver ? resolver(env, response) : env.Undefined();
+	if (env.IsExceptionPending()) {
+		deferred.Reject(env.GetAndClearPendingException().Value());
+		return;
+	}
+
+	deferred.Resolve(value);
+}
+
+void osn::AsyncCall::OnError(const Napi::Error &e)
+{
+	deferred.Reject(e.Value());
+}
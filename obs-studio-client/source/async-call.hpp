@@ -0,0 +1,61 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ipc-client.hpp"
+
+namespace osn {
+// Builds the resolved value from a successful response, runs on the JS thread
+typedef std::function<Napi::Value(Napi::Env env, std::vector<ipc::value> &response)> AsyncResolver;
+// Runs on the worker thread after a successful response, for follow-up requests the resolver needs
+typedef std::function<void(std::shared_ptr<ipc::client> conn)> AsyncFollowUp;
+
+// Sends one IPC request from the libuv thread pool and settles a promise with the
+// response, so the event loop never waits on the server. Each call has its own
+// request in flight, several may be pending at once (up to UV_THREADPOOL_SIZE).
+class AsyncCall : public Napi::AsyncWorker {
+public:
+	static Napi::Promise Send(Napi::Env env, const std::string &cname, const std::string &fname, std::vector<ipc::value> args,
+				   AsyncResolver resolver = nullptr, AsyncFollowUp followUp = nullptr);
+
+	// Promise settled on the spot, for calls answered from the client caches
+	static Napi::Promise Resolved(Napi::Env env, Napi::Value value);
+
+protected:
+	AsyncCall(Napi::Env env, const std::string &cname, const std::string &fname, std::vector<ipc::value> args, AsyncResolver resolver,
+		  AsyncFollowUp followUp);
+
+	void Execute() override;
+	void OnOK() override;
+	void OnError(const Napi::Error &e) override;
+
+private:
+	std::string cname;
+	std::string fname;
+	std::vector<ipc::value> args;
+	std::vector<ipc::value> response;
+	AsyncResolver resolver;
+	AsyncFollowUp followUp;
+	Napi::Promise::Deferred deferred;
+};
+}
@@ -18,6 +18,7 @@
 
 #include "callback-manager.hpp"
 #include "controller.hpp"
+#include "ipc-pack.hpp"
 #include "osn-error.hpp"
 #include "utility-v8.hpp"
 
@@ -138,67 +139,65 @@ void globalCallback::worker()
 			return;
 
 		mtx_volmeters.lock();
-		std::vector<char> volmeters_ids;
-		{
-			uint32_t index = 0;
-			volmeters_ids.resize(sizeof(uint64_t) * volmeters.size());
-			for (auto vol : volmeters) {
-				*reinterpret_cast<uint64_t *>(volmeters_ids.data() + index) = vol.first;
-				index += sizeof(uint64_t);
-			}
-		}
+		ipc_pack::Writer volmeters_ids(ipc_pack::Scratch());
+		volmeters_ids.reserve(sizeof(uint64_t) * volmeters.size());
+		for (auto &vol : volmeters)
+			volmeters_ids.put(vol.first);
 
 		{
 			std::vector<ipc::value> response = conn->call_synchronous_helper(
-				"CallbackManager", "GlobalQuery", {ipc::value((uint64_t)volmeters_ids.size()), ipc::value(volmeters_ids)});
+				"CallbackManager", "GlobalQuery", {ipc::value((uint64_t)(sizeof(uint64_t) * volmeters.size())), volmeters_ids.value()});
 			if (!response.size() || (response.size() == 1)) {
 				goto do_sleep;
 			}
 
-			uint32_t index = 1;
+			size_t resized = response[1].value_union.ui32;
+			if (response.size() < 3 + resized * 4)
+				goto do_sleep;
 
-			SourceSizeInfoData *data = new SourceSizeInfoData{{}};
-			for (int i = 2; i < (response[1].value_union.ui32 * 4) + 2; i++) {
-				SourceSizeInfo *item = new SourceSizeInfo;
+			if (resized > 0) {
+				SourceSizeInfoData *data = new SourceSizeInfoData{{}};
+				for (size_t i = 2; i < 2 + resized * 4; i += 4) {
+					SourceSizeInfo *item = new SourceSizeInfo;
 
-				item->name = response[i++].value_str;
-				item->width = response[i++].value_union.ui32;
-				item->height = response[i++].value_union.ui32;
-				item->flags = response[i].value_union.ui32;
-				data->items.push_back(item);
-				index = i;
-			}
+					item->name = response[i].value_str;
+					item->width = response[i + 1].value_union.ui32;
+					item->height = response[i + 2].value_union.ui32;
+					item->flags = response[i + 3].value_union.ui32;
+					data->items.push_back(item);
+				}
 
-			if (data->items.size() > 0) {
 				napi_status status = js_thread.NonBlockingCall(data, sources_callback);
 				if (status != napi_ok) {
 					delete data;
 				}
 			}
 
-			index++;
+			// One packed record per queried meter, in query order
+			ipc_pack::Reader meters(response[2 + resized * 4]);
+			for (auto &vol : volmeters) {
+				ipc_pack::MeterHeader header;
+				if (!meters.get(header))
+					break;
+				if (!header.channels || header.muted)
+					continue;
+
+				std::vector<ipc_pack::MeterChannel> levels(header.channels);
+				if (!meters.get(levels.data(), levels.size()))
+					break;
 
-			for (auto vol : volmeters) {
 				VolmeterData *data = new VolmeterData{{}, {}, {}};
-				size_t channels = response[index++].value_union.i32;
-				bool isMuted = response[index++].value_union.i32;
-				if (!channels)
-					continue;
-				if (!isMuted) {
-					data->magnitude.resize(channels);
-					data->peak.resize(channels);
-					data->input_peak.resize(channels);
-					for (size_t ch = 0; ch < channels; ch++) {
-						data->magnitude[ch] = response[index + ch * 3 + 0].value_union.fp32;
-						data->peak[ch] = response[index + ch * 3 + 1].value_union.fp32;
-						data->input_peak[ch] = response[index + ch * 3 + 2].value_union.fp32;
-					}
-					napi_status status = vol.second.NonBlockingCall(data, volmeter_callback);
-					if (status != napi_ok) {
-						delete data;
-					}
-
-					index += (3 * channels);
+				data->magnitude.resize(header.channels);
+				data->peak.resize(header.channels);
+				data->input_peak.resize(header.channels);
+				for (size_t ch = 0; ch < header.channels; ch++) {
+					data->magnitude[ch] = levels[ch].magnitude;
+					data->peak[ch] = levels[ch].peak;
+					data->input_peak[ch] = levels[ch].inputPeak;
+				}
+				napi_status status = vol.second.NonBlockingCall(data, volmeter_callback);
+				if (status != napi_ok) {
+					delete data;
 				}
 			}
 		}
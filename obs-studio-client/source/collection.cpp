@@ -0,0 +1,254 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "collection.hpp"
+#include <cmath>
+#include <ipc-value.hpp>
+#include "controller.hpp"
+#include "osn-error.hpp"
+#include "input.hpp"
+#include "scene.hpp"
+#include "sceneitem.hpp"
+#include "shared.hpp"
+#include "utility-v8.hpp"
+#include "video.hpp"
+
+Napi::FunctionReference osn::Collection::constructor;
+
+Napi::Object osn::Collection::Init(Napi::Env env, Napi::Object exports)
+{
+	Napi::HandleScope scope(env);
+	Napi::Function func = DefineClass(env, "Collection",
+					  {
+						  StaticMethod("load", &osn::Collection::Load),
+					  });
+	exports.Set("Collection", func);
+	osn::Collection::constructor = Napi::Persistent(func);
+	osn::Collection::constructor.SuppressDestruct();
+	return exports;
+}
+
+osn::Collection::Collection(const Napi::CallbackInfo &info) : Napi::ObjectWrap<osn::Collection>(info)
+{
+	Napi::Env env = info.Env();
+	Napi::HandleScope scope(env);
+}
+
+static Napi::Object GetItemTransform(const Napi::Object &scene, uint32_t index)
+{
+	Napi::Value items = scene.Get("items");
+	if (!items.IsArray())
+		return Napi::Object();
+
+	Napi::Value item = items.As<Napi::Array>().Get(index);
+	return item.IsObject() ? item.ToObject() : Napi::Object();
+}
+
+// Same defaults the server applies to missing fields
+static double GetNumber(const Napi::Object &object, const char *name, double defaultValue)
+{
+	// NaN goes out as null in the JSON, which the server treats as missing
+	Napi::Value value = object.Get(name);
+	double number = value.IsNumber() ? value.ToNumber().DoubleValue() : NAN;
+	return std::isnan(number) ? defaultValue : number;
+}
+
+static bool GetBoolean(const Napi::Object &object, const char *name, bool defaultValue)
+{
+	Napi::Value value = object.Get(name);
+	return value.IsBoolean() ? value.ToBoolean().Value() : defaultValue;
+}
+
+// Scenes and canvases are wrapped objects that do not serialize, the server gets their ids instead
+static Napi::Object DescribeCollection(Napi::Env env, const Napi::Object &collection, Napi::Array &sceneInfos)
+{
+	Napi::Object description = Napi::Object::New(env);
+	description.Set("sources", collection.Get("sources"));
+	description.Set("workers", collection.Get("workers"));
+
+	Napi::Array scenes = Napi::Array::New(env, sceneInfos.Length());
+	for (uint32_t i = 0; i < sceneInfos.Length(); i++) {
+		Napi::Value value = sceneInfos.Get(i);
+		if (!value.IsObject()) {
+			scenes.Set(i, Napi::Object::New(env));
+			continue;
+		}
+
+		Napi::Object sceneInfo = value.ToObject();
+		Napi::Object scene = Napi::Object::New(env);
+		scene.Set("name", sceneInfo.Get("name"));
+		scene.Set("items", sceneInfo.Get("items"));
+		if (sceneInfo.Get("scene").IsObject()) {
+			osn::Scene *existing = Napi::ObjectWrap<osn::Scene>::Unwrap(sceneInfo.Get("scene").ToObject());
+			if (existing)
+				scene.Set("sceneId", Napi::Number::New(env, (double)existing->sourceId));
+		}
+		if (sceneInfo.Get("canvas").IsObject()) {
+			osn::Video *canvas = Napi::ObjectWrap<osn::Video>::Unwrap(sceneInfo.Get("canvas").ToObject());
+			if (canvas)
+				scene.Set("canvasId", Napi::Number::New(env, (double)canvas->canvasId));
+		}
+		scenes.Set(i, scene);
+	}
+	description.Set("scenes", scenes);
+
+	return description;
+}
+
+Napi::Value osn::Collection::Load(const Napi::CallbackInfo &info)
+{
+	Napi::Object collection = info[0].ToObject();
+	Napi::Array sceneInfos = collection.Get("scenes").IsArray() ? collection.Get("scenes").As<Napi::Array>() : Napi::Array::New(info.Env());
+
+	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
+	std::string data = stringify.Call(json, {DescribeCollection(info.Env(), collection, sceneInfos)}).As<Napi::String>().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Collection", "Load", {ipc::value(data)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	size_t idx = 1;
+
+	// Inputs, their initial state goes straight into the cache
+	uint32_t inputCount = response[idx++].value_union.ui32;
+	Napi::Array inputs = Napi::Array::New(info.Env(), inputCount);
+	Napi::Array createTimes = Napi::Array::New(info.Env(), inputCount);
+	for (uint32_t i = 0; i < inputCount; i++) {
+		// Entries that failed to load only carry their name and show up as null
+		uint64_t sourceId = response[idx++].value_union.ui64;
+		std::string name = response[idx++].value_str;
+		if (sourceId == UINT64_MAX) {
+			inputs.Set(i, info.Env().Null());
+			createTimes.Set(i, info.Env().Null());
+			continue;
+		}
+
+		SourceDataInfo *sdi = new SourceDataInfo;
+		sdi->id = sourceId;
+		sdi->name = name;
+		sdi->obs_sourceId = response[idx++].value_str;
+		sdi->setting = response[idx++].value_str;
+		sdi->settingsChanged = false;
+		sdi->audioMixers = response[idx++].value_union.ui32;
+		sdi->audioMixersChanged = false;
+		sdi->deinterlaceMode = response[idx++].value_union.ui32;
+		sdi->deinterlaceModeChanged = false;
+		sdi->deinterlaceFieldOrder = response[idx++].value_union.ui32;
+		sdi->deinterlaceFieldOrderChanged = false;
+		sdi->isMuted = !!response[idx++].value_union.ui32;
+		sdi->mutedChanged = false;
+		createTimes.Set(i, Napi::Number::New(info.Env(), response[idx++].value_union.fp64));
+
+		CacheManager<SourceDataInfo *>::getInstance().Store(sdi->id, sdi->name, sdi);
+		inputs.Set(i, osn::Input::constructor.New({Napi::Number::New(info.Env(), sdi->id)}));
+	}
+	result.Set("inputs", inputs);
+	result.Set("createTimes", createTimes);
+
+	// Scenes and their items, in the order they were described
+	uint32_t sceneCount = response[idx++].value_union.ui32;
+	Napi::Array scenes = Napi::Array::New(info.Env(), sceneCount);
+	for (uint32_t i = 0; i < sceneCount; i++) {
+		uint64_t sceneId = response[idx++].value_union.ui64;
+		std::string name = response[idx++].value_str;
+		uint32_t itemCount = response[idx++].value_union.ui32;
+		if (sceneId == UINT64_MAX) {
+			scenes.Set(i, info.Env().Null());
+			continue;
+		}
+
+		SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(sceneId);
+		if (!si) {
+			si = new SceneInfo;
+			si->id = sceneId;
+			CacheManager<SceneInfo *>::getInstance().Store(sceneId, name, si);
+
+			SourceDataInfo *sdi = new SourceDataInfo;
+			sdi->name = name;
+			sdi->obs_sourceId = "scene";
+			sdi->id = sceneId;
+			CacheManager<SourceDataInfo *>::getInstance().Store(sceneId, name, sdi);
+		}
+
+		Napi::Object sceneInfo = i < sceneInfos.Length() && sceneInfos.Get(i).IsObject() ? sceneInfos.Get(i).ToObject() : Napi::Object();
+
+		Napi::Array items = Napi::Array::New(info.Env(), itemCount);
+		for (uint32_t j = 0; j < itemCount; j++) {
+			uint64_t id = response[idx++].value_union.ui64;
+			int64_t obs_id = response[idx++].value_union.i64;
+			uint32_t index = response[idx++].value_union.ui32;
+			if (id == UINT64_MAX) {
+				items.Set(j, info.Env().Null());
+				continue;
+			}
+
+			si->items.push_back(std::make_pair(obs_id, id));
+
+			SceneItemData *sid = new SceneItemData;
+			sid->obs_itemId = obs_id;
+			sid->scene_id = sceneId;
+
+			// Items missing from the description fall back to querying the server
+			Napi::Object transform = sceneInfo.IsEmpty() ? Napi::Object() : GetItemTransform(sceneInfo, index);
+			if (!transform.IsEmpty()) {
+				Napi::Object crop = transform.Get("crop").IsObject() ? transform.Get("crop").ToObject() : Napi::Object::New(info.Env());
+
+				sid->posX = (float)GetNumber(transform, "x", 0.0);
+				sid->posY = (float)GetNumber(transform, "y", 0.0);
+				sid->posChanged = false;
+				sid->scaleX = (float)GetNumber(transform, "scaleX", 1.0);
+				sid->scaleY = (float)GetNumber(transform, "scaleY", 1.0);
+				sid->scaleChanged = false;
+				sid->isVisible = GetBoolean(transform, "visible", true);
+				sid->visibleChanged = false;
+				sid->cropLeft = (int32_t)GetNumber(crop, "left", 0.0);
+				sid->cropTop = (int32_t)GetNumber(crop, "top", 0.0);
+				sid->cropRight = (int32_t)GetNumber(crop, "right", 0.0);
+				sid->cropBottom = (int32_t)GetNumber(crop, "bottom", 0.0);
+				sid->cropChanged = false;
+				sid->rotation = (float)GetNumber(transform, "rotation", 0.0);
+				sid->rotationChanged = false;
+			}
+
+			CacheManager<SceneItemData *>::getInstance().Store(id, sid);
+			items.Set(j, osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), id)}));
+		}
+		si->itemsOrderCached = true;
+
+		Napi::Object scene = Napi::Object::New(info.Env());
+		scene.Set("scene", osn::Scene::constructor.New({Napi::Number::New(info.Env(), sceneId)}));
+		scene.Set("items", items);
+		scenes.Set(i, scene);
+	}
+	result.Set("scenes", scenes);
+
+	uint32_t failedCount = response[idx++].value_union.ui32;
+	Napi::Array failed = Napi::Array::New(info.Env(), failedCount);
+	for (uint32_t i = 0; i < failedCount; i++)
+		failed.Set(i, Napi::String::New(info.Env(), response[idx++].value_str));
+	result.Set("failed", failed);
+
+	return result;
+}
@@ -17,12 +17,15 @@
 ******************************************************************************/
 
 #include "controller.hpp"
+#include <algorithm>
+#include <chrono>
 #include <codecvt>
 #include <fstream>
 #include <sstream>
 #include <locale>
 #include <sstream>
 #include <string>
+#include "ipc-batch.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -53,6 +56,9 @@ std::wstring utfWorkingDir = L"";
 #include <libproc.h>
 #include <iostream>
 #include <spawn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 extern char **environ;
 #endif
 
@@ -245,6 +251,16 @@ static void write_pid_file(std::string &pid_path, uint64_t pid)
 
 #endif
 
+#ifdef WIN32
+// Manual reset event the server sets once its socket is listening, see SignalSocketReady on the server side
+static HANDLE open_ready_event(const std::string &uri)
+{
+	std::string name = "Local\\osn-ready-" + uri;
+	std::replace(name.begin() + strlen("Local\\"), name.end(), '\\', '_');
+	return CreateEventW(NULL, TRUE, FALSE, std::wstring(name.begin(), name.end()).c_str());
+}
+#endif
+
 Controller::Controller() {}
 
 Controller::~Controller() {}
@@ -254,6 +270,12 @@ std::shared_ptr<ipc::client> Controller::host(const std::string &uri)
 	if (m_isServer)
 		return nullptr;
 
+	{
+		std::unique_lock<std::mutex> lock(m_startupMtx);
+		m_startupEvents.clear();
+		m_firstCallMarked = false;
+	}
+
 	const std::string version = GET_OSN_VERSION;
 
 	std::stringstream commandLine;
@@ -276,7 +298,9 @@ std::shared_ptr<ipc::client> Controller::host(const std::string &uri)
 
 	check_pid_file(pid_path);
 
+	uint64_t spawnStart = StartupClockNs();
 	procId = spawn(serverBinaryPath, commandLine.str(), workingDirectory);
+	MarkStartup("spawn", spawnStart, StartupClockNs());
 	if (procId.id == 0) {
 		return nullptr;
 	}
@@ -312,7 +336,28 @@ std::shared_ptr<ipc::client> Controller::host(const std::string &uri)
 	char *argv[] = {"obs64", uri_str.data(), (char *)version.c_str(), (char *)serverBinaryPath.c_str(), NULL};
 	remove(uri.c_str());
 
-	int ret = posix_spawnp(&pid, serverBinaryPath.c_str(), NULL, NULL, argv, environ);
+	// The server writes to this pipe once its socket is listening
+	int readyPipe[2] = {-1, -1};
+	std::string readyFdEnv;
+	std::vector<char *> envp;
+	for (char **env = environ; *env; env++)
+		envp.push_back(*env);
+	if (pipe(readyPipe) == 0) {
+		fcntl(readyPipe[0], F_SETFD, FD_CLOEXEC);
+		readyFdEnv = "OSN_READY_FD=" + std::to_string(readyPipe[1]);
+		envp.push_back((char *)readyFdEnv.c_str());
+	}
+	envp.push_back(NULL);
+
+	uint64_t spawnStart = StartupClockNs();
+	int ret = posix_spawnp(&pid, serverBinaryPath.c_str(), NULL, NULL, argv, envp.data());
+	MarkStartup("spawn", spawnStart, StartupClockNs());
+
+	if (readyPipe[1] != -1)
+		close(readyPipe[1]);
+	m_readyFd = ret == 0 ? readyPipe[0] : -1;
+	if (ret != 0 && readyPipe[0] != -1)
+		close(readyPipe[0]);
 	// Connect
 	std::shared_ptr<ipc::client> cl = connect(uri);
 	if (!cl) { // Assume the server broke or was not allowed to run.
@@ -336,8 +381,14 @@ std::shared_ptr<ipc::client> Controller::connect(const std::string &uri)
 	if (m_connection)
 		return nullptr;
 
+	uint64_t connectStart = StartupClockNs();
+	void *readyEvent = nullptr;
+#ifdef WIN32
+	readyEvent = open_ready_event(uri);
+#endif
+	bool ready = false;
+
 	std::shared_ptr<ipc::client> cl;
-	using std::chrono::high_resolution_clock;
 	while (!cl) {
 		try {
 			std::string path;
@@ -362,18 +413,46 @@ std::shared_ptr<ipc::client> Controller::connect(const std::string &uri)
 #endif
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		// Sleep until the server reports its socket is listening, the timeout
+		// only bounds how often a dead server gets noticed
+		if (!ready) {
+			ready = WaitSocketReady(readyEvent, 100);
+			if (ready) {
+				uint64_t now = StartupClockNs();
+				MarkStartup("ready notification", now, now);
+			}
+		} else {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
 	}
+
+#ifdef WIN32
+	if (readyEvent)
+		CloseHandle((HANDLE)readyEvent);
+#else
+	if (m_readyFd != -1) {
+		close(m_readyFd);
+		m_readyFd = -1;
+	}
+#endif
+
 	if (!cl) {
 		return nullptr;
 	}
 
+	MarkStartup("connect", connectStart, StartupClockNs());
 	m_connection = cl;
 	return m_connection;
 }
 
 void Controller::disconnect()
 {
+	FlushCalls();
+	if (m_shm.IsOpen()) {
+		if (m_connection)
+			m_connection->call_synchronous_helper("SharedMemory", "Detach", {});
+		m_shm.Close();
+	}
 	if (m_isServer) {
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
@@ -386,11 +465,136 @@ DWORD Controller::GetExitCode()
 	return procId.exit_code;
 }
 
+// Calls past this count go out right away instead of growing the batch further
+#define MAX_BATCHED_CALLS 512
+
+bool Controller::QueueCall(const std::string &cname, const std::string &fname, std::vector<ipc::value> args)
+{
+	bool opened = false;
+	{
+		std::unique_lock<std::mutex> lock(m_batchMtx);
+		opened = m_batch.empty();
+		m_batch.push_back({cname, fname, std::move(args)});
+		m_batchSize = m_batch.size();
+	}
+
+	if (m_batchSize >= MAX_BATCHED_CALLS)
+		FlushCalls();
+	return opened;
+}
+
+void Controller::FlushCalls()
+{
+	if (m_batchSize == 0)
+		return;
+
+	// Held while sending so a concurrent flush cannot overtake this batch
+	std::unique_lock<std::mutex> lock(m_batchMtx);
+	if (m_batch.empty() || !m_connection)
+		return;
+
+	if (m_batch.size() == 1) {
+		m_connection->call(m_batch[0].cname, m_batch[0].fname, std::move(m_batch[0].args));
+	} else {
+		std::vector<char> buffer;
+		for (auto &call : m_batch)
+			ipc_batch::Append(buffer, call.cname, call.fname, call.args);
+		m_connection->call("Batch", "Apply", {ipc::value(buffer)});
+	}
+
+	m_batch.clear();
+	m_batchSize = 0;
+}
+
+// Enough for the largest settings blobs, a payload that does not fit or finds
+// every slot busy simply goes inline
+#define SHARED_MEMORY_SLOTS 8
+#define SHARED_MEMORY_SLOT_SIZE (2 * 1024 * 1024)
+
+bool Controller::EnableSharedMemory(uint32_t threshold)
+{
+	if (!m_connection || threshold == 0)
+		return false;
+
+	if (!m_shm.IsOpen()) {
+#ifdef WIN32
+		std::string name = "osn-shm-" + std::to_string(GetCurrentProcessId());
+#else
+		std::string name = "osn-shm-" + std::to_string(getpid());
+#endif
+		if (!m_shm.Create(name, SHARED_MEMORY_SLOTS, SHARED_MEMORY_SLOT_SIZE))
+			return false;
+
+		std::vector<ipc::value> response = m_connection->call_synchronous_helper("SharedMemory", "Attach", {ipc::value(name)});
+		if (response.size() == 0 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok) {
+			m_shm.Close();
+			return false;
+		}
+
+		// Both sides hold the mapping now, nothing else needs to find it by name
+		m_shm.Unlink();
+	}
+
+	m_shm.SetThreshold(threshold);
+	return true;
+}
+
+void Controller::DisableSharedMemory()
+{
+	m_shm.SetThreshold(0);
+}
+
+bool Controller::WaitSocketReady(void *readyEvent, uint32_t timeoutMs)
+{
+#ifdef WIN32
+	if (readyEvent)
+		return WaitForSingleObject((HANDLE)readyEvent, timeoutMs) == WAIT_OBJECT_0;
+#else
+	if (m_readyFd != -1) {
+		struct pollfd pfd = {m_readyFd, POLLIN, 0};
+		if (poll(&pfd, 1, (int)timeoutMs) <= 0)
+			return false;
+
+		char signal = 0;
+		if (read(m_readyFd, &signal, 1) == 1)
+			return true;
+
+		// The server closed the pipe without signalling, fall back to polling the socket
+		close(m_readyFd);
+		m_readyFd = -1;
+		return false;
+	}
+#endif
+	std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+	return false;
+}
+
 std::shared_ptr<ipc::client> Controller::GetConnection()
 {
+	if (!m_firstCallMarked.load(std::memory_order_relaxed) && m_connection && !m_firstCallMarked.exchange(true)) {
+		uint64_t now = StartupClockNs();
+		MarkStartup("first ipc call", now, now);
+	}
 	return m_connection;
 }
 
+uint64_t Controller::StartupClockNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Controller::MarkStartup(const std::string &name, uint64_t startNs, uint64_t endNs)
+{
+	std::unique_lock<std::mutex> lock(m_startupMtx);
+	m_startupEvents.push_back({name, startNs, endNs - startNs});
+}
+
+std::vector<StartupEvent> Controller::GetStartupTimeline()
+{
+	std::unique_lock<std::mutex> lock(m_startupMtx);
+	return m_startupEvents;
+}
+
 Napi::Value js_setServerPath(const Napi::CallbackInfo &info)
 {
 	if (info.Length() == 0) {
@@ -481,6 +685,29 @@ Napi::Value js_disconnect(const Napi::CallbackInfo &info)
 	return info.Env().Undefined();
 }
 
+Napi::Value js_enableSharedMemory(const Napi::CallbackInfo &info)
+{
+	uint32_t threshold = 64 * 1024;
+	if (info.Length() > 1) {
+		Napi::Error::New(info.Env(), "Too many arguments.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	} else if (info.Length() == 1) {
+		if (!info[0].IsNumber()) {
+			Napi::Error::New(info.Env(), "Argument 'threshold' must be of type 'Number'.").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+		threshold = info[0].ToNumber().Uint32Value();
+	}
+
+	return Napi::Boolean::New(info.Env(), Controller::GetInstance().EnableSharedMemory(threshold));
+}
+
+Napi::Value js_disableSharedMemory(const Napi::CallbackInfo &info)
+{
+	Controller::GetInstance().DisableSharedMemory();
+	return info.Env().Undefined();
+}
+
 void Controller::Init(Napi::Env env, Napi::Object exports)
 {
 	auto obj = Napi::Object::New(env);
@@ -488,5 +715,7 @@ void Controller::Init(Napi::Env env, Napi::Object exports)
 	obj.Set(Napi::String::New(env, "connect"), Napi::Function::New(env, js_connect));
 	obj.Set(Napi::String::New(env, "host"), Napi::Function::New(env, js_host));
 	obj.Set(Napi::String::New(env, "disconnect"), Napi::Function::New(env, js_disconnect));
+	obj.Set(Napi::String::New(env, "enableSharedMemory"), Napi::Function::New(env, js_enableSharedMemory));
+	obj.Set(Napi::String::New(env, "disableSharedMemory"), Napi::Function::New(env, js_disableSharedMemory));
 	exports.Set("IPC", obj);
 }
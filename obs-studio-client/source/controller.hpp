@@ -17,13 +17,29 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "ipc.hpp"
 #include "ipc-client.hpp"
+#include "ipc-shm.hpp"
 #include <napi.h>
 
+struct QueuedCall {
+	std::string cname;
+	std::string fname;
+	std::vector<ipc::value> args;
+};
+
+struct StartupEvent {
+	std::string name;
+	uint64_t startNs;
+	uint64_t durationNs;
+};
+
 class Controller {
 public:
 	static Controller &GetInstance()
@@ -53,8 +69,40 @@ public:
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	// Fire-and-forget calls are held back and sent together as one Batch.Apply
+	// message, QueueCall returns true when it opened a new batch
+	bool QueueCall(const std::string &cname, const std::string &fname, std::vector<ipc::value> args);
+	void FlushCalls();
+
+	// Opt-in region for large payloads, mapped on first enable and kept until
+	// disconnect so responses still in flight stay readable
+	bool EnableSharedMemory(uint32_t threshold);
+	void DisableSharedMemory();
+	ipc_shm::Region &SharedMemory()
+	{
+		return m_shm;
+	}
+
+	// Client side of the startup timeline, on the same clock as the server's os_gettime_ns
+	static uint64_t StartupClockNs();
+	void MarkStartup(const std::string &name, uint64_t startNs, uint64_t endNs);
+	std::vector<StartupEvent> GetStartupTimeline();
+
 private:
+	bool WaitSocketReady(void *readyEvent, uint32_t timeoutMs);
+
 	bool m_isServer = false;
 	std::shared_ptr<ipc::client> m_connection;
 	ipc::ProcessInfo procId;
+	int m_readyFd = -1;
+
+	std::mutex m_batchMtx;
+	std::vector<QueuedCall> m_batch;
+	std::atomic<size_t> m_batchSize{0};
+
+	ipc_shm::Region m_shm;
+
+	std::mutex m_startupMtx;
+	std::vector<StartupEvent> m_startupEvents;
+	std::atomic<bool> m_firstCallMarked{false};
 };
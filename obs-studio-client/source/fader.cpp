@@ -23,6 +23,7 @@
 #include "osn-error.hpp"
 #include "input.hpp"
 #include "shared.hpp"
+#include "ipc-pack.hpp"
 #include <iostream>
 
 Napi::FunctionReference osn::Fader::constructor;
@@ -33,6 +34,9 @@ Napi::Object osn::Fader::Init(Napi::Env env, Napi::Object exports)
 	Napi::Function func = DefineClass(env, "Fader",
 					  {
 						  StaticMethod("create", &osn::Fader::Create),
+						  StaticMethod("getValues", &osn::Fader::GetValues),
+						  StaticMethod("setValues", &osn::Fader::SetValues),
+						  StaticMethod("benchmarkSanitize", &osn::Fader::BenchmarkSanitize),
 
 						  InstanceMethod("destroy", &osn::Fader::Destroy),
 						  InstanceMethod("attach", &osn::Fader::Attach),
@@ -85,6 +89,121 @@ Napi::Value osn::Fader::Create(const Napi::CallbackInfo &info)
 	return instance;
 }
 
+// Packs the uids of an array of faders for the bulk calls, throws if an element is not a fader
+static bool FaderUids(Napi::Env env, const Napi::Array &faders, ipc::value &packed)
+{
+	std::vector<char> buffer;
+	ipc_pack::Writer uids(buffer);
+	uids.reserve(faders.Length() * sizeof(uint64_t));
+	for (uint32_t i = 0; i < faders.Length(); i++) {
+		Napi::Value element = faders.Get(i);
+		osn::Fader *fader = element.IsObject() ? Napi::ObjectWrap<osn::Fader>::Unwrap(element.ToObject()) : nullptr;
+		if (!fader) {
+			Napi::TypeError::New(env, "Invalid fader argument").ThrowAsJavaScriptException();
+			return false;
+		}
+		uids.put(fader->uid);
+	}
+	packed = uids.value();
+	return true;
+}
+
+static Napi::Array FaderValuesToArray(Napi::Env env, const ipc::value &packed)
+{
+	ipc_pack::Reader reader(packed);
+	Napi::Array array = Napi::Array::New(env, reader.remaining() / sizeof(ipc_pack::FaderValues));
+
+	ipc_pack::FaderValues values;
+	for (uint32_t i = 0; reader.get(values); i++) {
+		Napi::Object object = Napi::Object::New(env);
+		object.Set("db", Napi::Number::New(env, values.db));
+		object.Set("deflection", Napi::Number::New(env, values.deflection));
+		object.Set("mul", Napi::Number::New(env, values.mul));
+		array.Set(i, object);
+	}
+	return array;
+}
+
+Napi::Value osn::Fader::GetValues(const Napi::CallbackInfo &info)
+{
+	if (info.Length() < 1 || !info[0].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Array of faders expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	ipc::value uids;
+	if (!FaderUids(info.Env(), info[0].As<Napi::Array>(), uids))
+		return info.Env().Undefined();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "GetValues", {uids});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return FaderValuesToArray(info.Env(), response[1]);
+}
+
+Napi::Value osn::Fader::SetValues(const Napi::CallbackInfo &info)
+{
+	if (info.Length() < 3 || !info[0].IsArray() || !info[2].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Faders, field and values expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Array faders = info[0].As<Napi::Array>();
+	Napi::Array values = info[2].As<Napi::Array>();
+	if (faders.Length() != values.Length()) {
+		Napi::TypeError::New(info.Env(), "One value per fader expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	ipc::value uids;
+	if (!FaderUids(info.Env(), faders, uids))
+		return info.Env().Undefined();
+
+	std::vector<char> buffer;
+	ipc_pack::Writer packed(buffer);
+	packed.reserve(values.Length() * sizeof(float));
+	for (uint32_t i = 0; i < values.Length(); i++)
+		packed.put(values.Get(i).ToNumber().FloatValue());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("Fader", "SetValues", {ipc::value(info[1].ToNumber().Int32Value()), uids, packed.value()});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return FaderValuesToArray(info.Env(), response[1]);
+}
+
+Napi::Value osn::Fader::BenchmarkSanitize(const Napi::CallbackInfo &info)
+{
+	uint32_t count = info[0].ToNumber().Uint32Value();
+	uint32_t iterations = info[1].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Fader", "BenchmarkSanitize", {ipc::value(count), ipc::value(iterations)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object timing = Napi::Object::New(info.Env());
+	timing.Set("scalar", Napi::Number::New(info.Env(), response[1].value_union.ui64));
+	timing.Set("simd", Napi::Number::New(info.Env(), response[2].value_union.ui64));
+	return timing;
+}
+
 Napi::Value osn::Fader::GetDeziBel(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
@@ -106,11 +225,7 @@ void osn::Fader::SetDezibel(const Napi::CallbackInfo &info, const Napi::Value &v
 {
 	float_t db = value.ToNumber().FloatValue();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetDeziBel", {ipc::value(this->uid), ipc::value(db)});
+	QueueCall(info, "Fader", "SetDeziBel", {ipc::value(this->uid), ipc::value(db)});
 }
 
 Napi::Value osn::Fader::GetDeflection(const Napi::CallbackInfo &info)
@@ -134,11 +249,7 @@ void osn::Fader::SetDeflection(const Napi::CallbackInfo &info, const Napi::Value
 {
 	float_t deflection = value.ToNumber().FloatValue();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetDeflection", {ipc::value(this->uid), ipc::value(deflection)});
+	QueueCall(info, "Fader", "SetDeflection", {ipc::value(this->uid), ipc::value(deflection)});
 }
 
 Napi::Value osn::Fader::GetMultiplier(const Napi::CallbackInfo &info)
@@ -162,11 +273,7 @@ void osn::Fader::SetMultiplier(const Napi::CallbackInfo &info, const Napi::Value
 {
 	float_t mul = value.ToNumber().FloatValue();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Fader", "SetMultiplier", {ipc::value(this->uid), ipc::value(mul)});
+	QueueCall(info, "Fader", "SetMultiplier", {ipc::value(this->uid), ipc::value(mul)});
 }
 
 Napi::Value osn::Fader::Destroy(const Napi::CallbackInfo &info)
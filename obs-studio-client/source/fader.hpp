@@ -32,6 +32,9 @@ public:
 	Fader(const Napi::CallbackInfo &info);
 
 	static Napi::Value Create(const Napi::CallbackInfo &info);
+	static Napi::Value GetValues(const Napi::CallbackInfo &info);
+	static Napi::Value SetValues(const Napi::CallbackInfo &info);
+	static Napi::Value BenchmarkSanitize(const Napi::CallbackInfo &info);
 
 	Napi::Value GetDeziBel(const Napi::CallbackInfo &info);
 	void SetDezibel(const Napi::CallbackInfo &info, const Napi::Value &value);
@@ -202,4 +202,19 @@ Napi::Value osn::FileOutput::GetLastFile(const Napi::CallbackInfo &info)
 		return info.Env().Undefined();
 
 	return Napi::String::New(info.Env(), response[1].value_str);
+}
+
+Napi::Value osn::FileOutput::GetTelemetry(const Napi::CallbackInfo &info)
+{
+	return getTelemetry(info, this->uid);
+}
+
+Napi::Value osn::FileOutput::GetTelemetryHandler(const Napi::CallbackInfo &info)
+{
+	return getTelemetryHandler(info);
+}
+
+void osn::FileOutput::SetTelemetryHandler(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	setTelemetryHandler(info, value, this->uid);
 }
\ No newline at end of file
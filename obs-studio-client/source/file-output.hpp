@@ -19,12 +19,13 @@
 #pragma once
 #include <napi.h>
 #include "worker-signals.hpp"
+#include "worker-telemetry.hpp"
 
 namespace osn {
-class FileOutput {
+class FileOutput : public WorkerTelemetry {
 public:
 	uint64_t uid;
-	FileOutput(){};
+	FileOutput() : WorkerTelemetry("FileOutput"){};
 
 protected:
 	Napi::Value GetPath(const Napi::CallbackInfo &info);
@@ -43,5 +44,8 @@ protected:
 	void SetMuxerSettings(const Napi::CallbackInfo &info, const Napi::Value &value);
 
 	Napi::Value GetLastFile(const Napi::CallbackInfo &info);
+	Napi::Value GetTelemetry(const Napi::CallbackInfo &info);
+	Napi::Value GetTelemetryHandler(const Napi::CallbackInfo &info);
+	void SetTelemetryHandler(const Napi::CallbackInfo &info, const Napi::Value &value);
 };
 }
\ No newline at end of file
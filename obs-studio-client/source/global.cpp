@@ -43,6 +43,9 @@ Napi::Object osn::Global::Init(Napi::Env env, Napi::Object exports)
 
 						  StaticAccessor("locale", &osn::Global::getLocale, &osn::Global::setLocale),
 						  StaticAccessor("multipleRendering", &osn::Global::getMultipleRendering, &osn::Global::setMultipleRendering),
+						  StaticAccessor("outputStopDeadline", &osn::Global::getOutputStopDeadline, &osn::Global::setOutputStopDeadline),
+						  StaticAccessor("pendingOutputs", &osn::Global::getPendingOutputs, nullptr),
+						  StaticAccessor("encoderSharing", &osn::Global::getEncoderSharing, &osn::Global::setEncoderSharing),
 					  });
 	exports.Set("Global", func);
 	osn::Global::constructor = Napi::Persistent(func);
@@ -191,3 +194,63 @@ void osn::Global::setMultipleRendering(const Napi::CallbackInfo &info, const Nap
 
 	conn->call("Global", "SetMultipleRendering", {ipc::value(value.ToBoolean().Value())});
 }
+
+Napi::Value osn::Global::getOutputStopDeadline(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetOutputStopDeadline", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
+}
+
+void osn::Global::setOutputStopDeadline(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call("Global", "SetOutputStopDeadline", {ipc::value(value.ToNumber().Uint32Value())});
+}
+
+Napi::Value osn::Global::getPendingOutputs(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetPendingOutputs", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
+}
+
+Napi::Value osn::Global::getEncoderSharing(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Global", "GetEncoderSharing", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), response[1].value_union.i32);
+}
+
+void osn::Global::setEncoderSharing(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call("Global", "SetEncoderSharing", {ipc::value(value.ToBoolean().Value())});
+}
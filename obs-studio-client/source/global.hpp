@@ -35,5 +35,10 @@ public:
 	static void setLocale(const Napi::CallbackInfo &info, const Napi::Value &value);
 	static Napi::Value getMultipleRendering(const Napi::CallbackInfo &info);
 	static void setMultipleRendering(const Napi::CallbackInfo &info, const Napi::Value &value);
+	static Napi::Value getOutputStopDeadline(const Napi::CallbackInfo &info);
+	static void setOutputStopDeadline(const Napi::CallbackInfo &info, const Napi::Value &value);
+	static Napi::Value getPendingOutputs(const Napi::CallbackInfo &info);
+	static Napi::Value getEncoderSharing(const Napi::CallbackInfo &info);
+	static void setEncoderSharing(const Napi::CallbackInfo &info, const Napi::Value &value);
 };
 }
@@ -22,6 +22,7 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "filter.hpp"
@@ -38,6 +39,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 		DefineClass(env, "Input",
 			    {StaticMethod("types", &osn::Input::Types),
 			     StaticMethod("create", &osn::Input::Create),
+			     StaticMethod("createAsync", &osn::Input::CreateAsync),
 			     StaticMethod("createPrivate", &osn::Input::CreatePrivate),
 			     StaticMethod("fromName", &osn::Input::FromName),
 			     StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
@@ -91,7 +93,9 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 			     InstanceMethod("restart", &osn::Input::Restart),
 			     InstanceMethod("stop", &osn::Input::Stop),
 			     InstanceMethod("getMediaState", &osn::Input::GetMediaState),
-			     InstanceMethod("callHandler", &osn::Input::CallCallHandler)});
+			     InstanceMethod("callHandler", &osn::Input::CallCallHandler),
+			     InstanceMethod("getPropertiesAsync", &osn::Input::CallGetPropertiesAsync),
+			     InstanceMethod("getSettingsAsync", &osn::Input::CallGetSettingsAsync)});
 	exports.Set("Input", func);
 	osn::Input::constructor = Napi::Persistent(func);
 	osn::Input::constructor.SuppressDestruct();
@@ -132,7 +136,8 @@ Napi::Value osn::Input::Types(const Napi::CallbackInfo &info)
 	return utilv8::ToValue<std::string>(info, types);
 }
 
-Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
+// Arguments shared by create and createAsync: type, name[, settings[, hotkeys]]
+static std::vector<ipc::value> CreateParams(const Napi::CallbackInfo &info)
 {
 	std::string type = info[0].ToString().Utf8Value();
 	std::string name = info[1].ToString().Utf8Value();
@@ -156,10 +161,6 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 		}
 	}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
 	if (settings.Utf8Value().length() != 0) {
 		std::string value;
@@ -173,12 +174,11 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 			params.push_back(ipc::value(value));
 		}
 	}
+	return params;
+}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
+static Napi::Value CreateFromResponse(Napi::Env env, const std::string &type, const std::string &name, std::vector<ipc::value> &response)
+{
 	SourceDataInfo *sdi = new SourceDataInfo;
 	sdi->name = name;
 	sdi->obs_sourceId = type;
@@ -190,9 +190,35 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 
 	CacheManager<SourceDataInfo *>::getInstance().Store(response[1].value_union.ui64, name, sdi);
 
-	auto instance = osn::Input::constructor.New({Napi::Number::New(info.Env(), response[1].value_union.ui64)});
+	return osn::Input::constructor.New({Napi::Number::New(env, response[1].value_union.ui64)});
+}
 
-	return instance;
+Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
+{
+	std::string type = info[0].ToString().Utf8Value();
+	std::string name = info[1].ToString().Utf8Value();
+	auto params = CreateParams(info);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return CreateFromResponse(info.Env(), type, name, response);
+}
+
+Napi::Value osn::Input::CreateAsync(const Napi::CallbackInfo &info)
+{
+	std::string type = info[0].ToString().Utf8Value();
+	std::string name = info[1].ToString().Utf8Value();
+
+	return osn::AsyncCall::Send(info.Env(), "Input", "Create", CreateParams(info), [type, name](Napi::Env env, std::vector<ipc::value> &response) {
+		return CreateFromResponse(env, type, name, response);
+	});
 }
 
 Napi::Value osn::Input::CreatePrivate(const Napi::CallbackInfo &info)
@@ -390,11 +416,7 @@ Napi::Value osn::Input::GetVolume(const Napi::CallbackInfo &info)
 
 void osn::Input::SetVolume(const Napi::CallbackInfo &info, const Napi::Value &value)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Input", "SetVolume", {ipc::value((uint64_t)this->sourceId), ipc::value(value.ToNumber().FloatValue())});
+	QueueCall(info, "Input", "SetVolume", {ipc::value((uint64_t)this->sourceId), ipc::value(value.ToNumber().FloatValue())});
 }
 
 Napi::Value osn::Input::GetSyncOffset(const Napi::CallbackInfo &info)
@@ -697,6 +719,16 @@ Napi::Value osn::Input::CallGetSlowUncachedSettings(const Napi::CallbackInfo &in
 	return osn::ISource::GetSlowUncachedSettings(info, this->sourceId);
 }
 
+Napi::Value osn::Input::CallGetPropertiesAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
+Napi::Value osn::Input::CallGetSettingsAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetSettingsAsync(info, this->sourceId);
+}
+
 Napi::Value osn::Input::CallGetType(const Napi::CallbackInfo &info)
 {
 	return osn::ISource::GetType(info, this->sourceId);
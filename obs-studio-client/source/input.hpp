@@ -33,6 +33,7 @@ public:
 
 	static Napi::Value Types(const Napi::CallbackInfo &info);
 	static Napi::Value Create(const Napi::CallbackInfo &info);
+	static Napi::Value CreateAsync(const Napi::CallbackInfo &info);
 	static Napi::Value CreatePrivate(const Napi::CallbackInfo &info);
 	static Napi::Value FromName(const Napi::CallbackInfo &info);
 	static Napi::Value GetPublicSources(const Napi::CallbackInfo &info);
@@ -66,6 +67,8 @@ public:
 	Napi::Value CallGetProperties(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSettings(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSlowUncachedSettings(const Napi::CallbackInfo &info);
+	Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo &info);
+	Napi::Value CallGetSettingsAsync(const Napi::CallbackInfo &info);
 
 	Napi::Value CallGetType(const Napi::CallbackInfo &info);
 	Napi::Value CallGetName(const Napi::CallbackInfo &info);
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "isource.hpp"
+#include "async-call.hpp"
 #include "osn-error.hpp"
 #include <functional>
 #include "controller.hpp"
@@ -119,7 +120,8 @@ Napi::Value osn::ISource::GetSlowUncachedSettings(const Napi::CallbackInfo &info
 	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
 	Napi::Function parse = json.Get("parse").As<Napi::Function>();
 
-	Napi::String jsondata = Napi::String::New(info.Env(), response[1].value_str);
+	ipc_shm::View settings(Controller::GetInstance().SharedMemory(), response[1]);
+	Napi::String jsondata = Napi::String::New(info.Env(), settings.data(), settings.size());
 	Napi::Object jsonObj = parse.Call(json, {jsondata}).As<Napi::Object>();
 
 	return jsonObj;
@@ -151,17 +153,70 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo &info, uint64_t i
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::String jsondata = Napi::String::New(info.Env(), response[1].value_str);
+	ipc_shm::View settings(Controller::GetInstance().SharedMemory(), response[1]);
+	Napi::String jsondata = Napi::String::New(info.Env(), settings.data(), settings.size());
 	Napi::Object jsonObj = parse.Call(json, {jsondata}).As<Napi::Object>();
 
 	if (sdi) {
-		sdi->setting = response[1].value_str;
+		sdi->setting.assign(settings.data(), settings.size());
 		sdi->settingsChanged = false;
 	}
 
 	return jsonObj;
 }
 
+static Napi::Value PropertiesFromCache(Napi::Env env, uint64_t id, const property_map_t &properties)
+{
+	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(properties);
+	auto prop_ptr = Napi::External<property_map_t>::New(env, pSomeObject.get());
+	return osn::Properties::constructor.New({prop_ptr, Napi::Number::New(env, (uint32_t)id)});
+}
+
+Napi::Value osn::ISource::GetPropertiesAsync(const Napi::CallbackInfo &info, uint64_t id)
+{
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0)
+		return osn::AsyncCall::Resolved(info.Env(), PropertiesFromCache(info.Env(), id, sdi->properties));
+
+	return osn::AsyncCall::Send(info.Env(), "Source", "GetProperties", {ipc::value(id)}, [id](Napi::Env env, std::vector<ipc::value> &response) {
+		if (response.size() == 1)
+			return env.Null();
+
+		osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+
+		// The source may have been released while the request was in flight
+		SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+		if (sdi) {
+			sdi->properties = pmap;
+			sdi->propertiesChanged = false;
+		}
+		return PropertiesFromCache(env, id, pmap);
+	});
+}
+
+Napi::Value osn::ISource::GetSettingsAsync(const Napi::CallbackInfo &info, uint64_t id)
+{
+	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	if (sdi && !sdi->settingsChanged && sdi->setting.size() > 0) {
+		Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
+		Napi::Function parse = json.Get("parse").As<Napi::Function>();
+		return osn::AsyncCall::Resolved(info.Env(), parse.Call(json, {Napi::String::New(info.Env(), sdi->setting)}));
+	}
+
+	return osn::AsyncCall::Send(info.Env(), "Source", "GetSettings", {ipc::value(id)}, [id](Napi::Env env, std::vector<ipc::value> &response) {
+		Napi::Object json = env.Global().Get("JSON").As<Napi::Object>();
+		Napi::Function parse = json.Get("parse").As<Napi::Function>();
+
+		ipc_shm::View settings(Controller::GetInstance().SharedMemory(), response[1]);
+		SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+		if (sdi) {
+			sdi->setting.assign(settings.data(), settings.size());
+			sdi->settingsChanged = sdi->obs_sourceId.compare("screen_capture") == 0;
+		}
+		return parse.Call(json, {Napi::String::New(env, settings.data(), settings.size())});
+	});
+}
+
 void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 {
 	Napi::Object jsonObj = info[0].ToObject();
@@ -424,11 +479,7 @@ void osn::ISource::SetMuted(const Napi::CallbackInfo &info, const Napi::Value &v
 	if (!source)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Source", "SetMuted", {ipc::value(id), ipc::value(muted)});
+	QueueCall(info, "Source", "SetMuted", {ipc::value(id), ipc::value(muted)});
 
 	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 	if (sdi)
@@ -486,11 +537,7 @@ void osn::ISource::SetEnabled(const Napi::CallbackInfo &info, const Napi::Value
 	if (!source)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("Source", "SetEnabled", {ipc::value(id), ipc::value(enabled)});
+	QueueCall(info, "Source", "SetEnabled", {ipc::value(id), ipc::value(enabled)});
 }
 
 void osn::ISource::SendMouseClick(const Napi::CallbackInfo &info, uint64_t id)
@@ -46,6 +46,8 @@ public:
 	static Napi::Value GetProperties(const Napi::CallbackInfo &info, uint64_t id);
 	static Napi::Value GetSettings(const Napi::CallbackInfo &info, uint64_t id);
 	static Napi::Value GetSlowUncachedSettings(const Napi::CallbackInfo &info, uint64_t id);
+	static Napi::Value GetPropertiesAsync(const Napi::CallbackInfo &info, uint64_t id);
+	static Napi::Value GetSettingsAsync(const Napi::CallbackInfo &info, uint64_t id);
 
 	static Napi::Value GetType(const Napi::CallbackInfo &info, uint64_t id);
 	static Napi::Value GetName(const Napi::CallbackInfo &info, uint64_t id);
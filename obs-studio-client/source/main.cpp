@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <string>
+#include "collection.hpp"
 #include "controller.hpp"
 #include "fader.hpp"
 #include "filter.hpp"
@@ -115,6 +116,7 @@ Napi::Object main_node(Napi::Env env, Napi::Object exports)
 	osn::Global::Init(env, exports);
 	osn::Scene::Init(env, exports);
 	osn::SceneItem::Init(env, exports);
+	osn::Collection::Init(env, exports);
 	osn::Transition::Init(env, exports);
 	osn::Module::Init(env, exports);
 	osn::Video::Init(env, exports);
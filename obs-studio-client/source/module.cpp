@@ -35,6 +35,7 @@ Napi::Object osn::Module::Init(Napi::Env env, Napi::Object exports)
 					  {
 						  StaticMethod("open", &osn::Module::Open),
 						  StaticMethod("modules", &osn::Module::Modules),
+						  StaticMethod("loadTimings", &osn::Module::LoadTimings),
 
 						  InstanceMethod("initialize", &osn::Module::Initialize),
 
@@ -105,6 +106,35 @@ Napi::Value osn::Module::Modules(const Napi::CallbackInfo &info)
 	return modules;
 }
 
+Napi::Value osn::Module::LoadTimings(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Module", "LoadTimings", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint32_t count = response[1].value_union.ui32;
+	Napi::Array timings = Napi::Array::New(info.Env(), count);
+
+	size_t idx = 2;
+	for (uint32_t i = 0; i < count; i++) {
+		Napi::Object timing = Napi::Object::New(info.Env());
+		timing.Set("binPath", Napi::String::New(info.Env(), response[idx++].value_str));
+		timing.Set("openTime", Napi::Number::New(info.Env(), response[idx++].value_union.fp64));
+		timing.Set("initTime", Napi::Number::New(info.Env(), response[idx++].value_union.fp64));
+		timing.Set("loaded", Napi::Boolean::New(info.Env(), response[idx++].value_union.ui32));
+		timing.Set("cached", Napi::Boolean::New(info.Env(), response[idx++].value_union.ui32));
+
+		timings.Set(i, timing);
+	}
+
+	return timings;
+}
+
 Napi::Value osn::Module::Initialize(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
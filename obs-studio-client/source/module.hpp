@@ -32,6 +32,7 @@ public:
 
 	static Napi::Value Open(const Napi::CallbackInfo &info);
 	static Napi::Value Modules(const Napi::CallbackInfo &info);
+	static Napi::Value LoadTimings(const Napi::CallbackInfo &info);
 
 	Napi::Value Initialize(const Napi::CallbackInfo &info);
 
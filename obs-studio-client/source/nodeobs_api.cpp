@@ -16,9 +16,13 @@
 
 ******************************************************************************/
 
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "nodeobs_api.hpp"
+#include <algorithm>
+#include <fstream>
+#include <map>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
@@ -30,6 +34,84 @@
 
 Napi::ThreadSafeFunction js_thread;
 
+static std::string appdataPath;
+
+struct HotkeyEntry {
+	std::string objectName;
+	uint32_t objectType;
+	std::string hotkeyName;
+	std::string hotkeyDesc;
+};
+
+// Mirror of the server hotkey index, only changes since hotkeyRevision are fetched
+static std::map<uint64_t, HotkeyEntry> hotkeyCache;
+static uint64_t hotkeyRevision = 0;
+
+static void ResetHotkeyCache()
+{
+	hotkeyCache.clear();
+	hotkeyRevision = 0;
+}
+
+struct TimelineEntry {
+	StartupEvent event;
+	bool server;
+};
+
+// Client and server events share a clock, merge them in start order
+static std::vector<TimelineEntry> FetchStartupTimeline(std::shared_ptr<ipc::client> conn)
+{
+	std::vector<TimelineEntry> timeline;
+	for (auto &event : Controller::GetInstance().GetStartupTimeline())
+		timeline.push_back({event, false});
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_getStartupTimeline", {});
+	if (response.size() > 1 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok) {
+		uint32_t count = response[1].value_union.ui32;
+		for (uint32_t i = 0; i < count && 4 + i * 3 < response.size(); i++) {
+			StartupEvent event = {response[2 + i * 3].value_str, response[3 + i * 3].value_union.ui64, response[4 + i * 3].value_union.ui64};
+			timeline.push_back({event, true});
+		}
+	}
+
+	std::stable_sort(timeline.begin(), timeline.end(),
+			 [](const TimelineEntry &a, const TimelineEntry &b) { return a.event.startNs < b.event.startNs; });
+	return timeline;
+}
+
+// Chrome trace event format, loadable in chrome://tracing or Perfetto
+static void WriteStartupTrace(const std::vector<TimelineEntry> &timeline)
+{
+	if (appdataPath.empty() || timeline.empty())
+		return;
+
+	std::string tracePath = appdataPath + "/node-obs/startup-trace.json";
+#ifdef WIN32
+	std::ofstream trace(from_utf8_to_utf16_wide(tracePath.c_str()), std::ios::out | std::ios::trunc);
+#else
+	std::ofstream trace(tracePath, std::ios::out | std::ios::trunc);
+#endif
+	if (!trace)
+		return;
+
+	uint64_t origin = timeline.front().event.startNs;
+	trace << "{\"traceEvents\":[";
+	for (size_t i = 0; i < timeline.size(); i++) {
+		const StartupEvent &event = timeline[i].event;
+		std::string name = event.name;
+		name.erase(std::remove_if(name.begin(), name.end(), [](char c) { return c == '"' || c == '\\'; }), name.end());
+
+		trace << (i ? "," : "") << "{\"name\":\"" << name << "\",\"cat\":\"startup\",\"ph\":\"" << (event.durationNs ? "X" : "i")
+		      << "\",\"pid\":" << (timeline[i].server ? 2 : 1) << ",\"tid\":1,\"ts\":" << (event.startNs - origin) / 1000.0;
+		if (event.durationNs)
+			trace << ",\"dur\":" << event.durationNs / 1000.0;
+		else
+			trace << ",\"s\":\"p\"";
+		trace << "}";
+	}
+	trace << "],\"displayTimeUnit\":\"ms\"}";
+}
+
 Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo &info)
 {
 	std::string path;
@@ -63,9 +145,68 @@ Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo &info)
 		}
 	}
 
+	appdataPath = path;
+	ResetHotkeyCache();
+	WriteStartupTrace(FetchStartupTimeline(conn));
+
 	return Napi::Number::New(info.Env(), response[1].value_union.i32);
 }
 
+Napi::Value api::OBS_API_initAPIAsync(const Napi::CallbackInfo &info)
+{
+	std::string path;
+	std::string language;
+	std::string version;
+	std::string crashserverurl;
+
+	ASSERT_GET_VALUE(info, info[0], language);
+	ASSERT_GET_VALUE(info, info[1], path);
+	ASSERT_GET_VALUE(info, info[2], version);
+	if (info.Length() > 3)
+		ASSERT_GET_VALUE(info, info[3], crashserverurl);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->set_freez_callback(ipc_freez_callback, path);
+
+	// The timeline is fetched by the worker as well, only the trace is written on the JS thread
+	auto timeline = std::make_shared<std::vector<TimelineEntry>>();
+	return osn::AsyncCall::Send(
+		info.Env(), "API", "OBS_API_initAPI", {ipc::value(path), ipc::value(language), ipc::value(version), ipc::value(crashserverurl)},
+		[path, timeline](Napi::Env env, std::vector<ipc::value> &response) {
+			appdataPath = path;
+			WriteStartupTrace(*timeline);
+			return Napi::Number::New(env, response[1].value_union.i32);
+		},
+		[timeline](std::shared_ptr<ipc::client> conn) { *timeline = FetchStartupTimeline(conn); });
+}
+
+Napi::Value api::OBS_API_getStartupTimeline(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<TimelineEntry> timeline = FetchStartupTimeline(conn);
+	WriteStartupTrace(timeline);
+
+	// Times are reported in milliseconds from the earliest event, usually the process spawn
+	uint64_t origin = timeline.empty() ? 0 : timeline.front().event.startNs;
+	Napi::Array events = Napi::Array::New(info.Env(), timeline.size());
+	for (size_t i = 0; i < timeline.size(); i++) {
+		Napi::Object event = Napi::Object::New(info.Env());
+		event.Set("name", Napi::String::New(info.Env(), timeline[i].event.name));
+		event.Set("process", Napi::String::New(info.Env(), timeline[i].server ? "server" : "client"));
+		event.Set("start", Napi::Number::New(info.Env(), (timeline[i].event.startNs - origin) / 1000000.0));
+		event.Set("duration", Napi::Number::New(info.Env(), timeline[i].event.durationNs / 1000000.0));
+		events.Set(i, event);
+	}
+
+	return events;
+}
+
 Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
@@ -73,6 +214,7 @@ Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo &info)
 		return info.Env().Undefined();
 
 	conn->call("API", "OBS_API_destroyOBS_API", {});
+	ResetHotkeyCache();
 
 #ifdef __APPLE__
 	if (js_thread)
@@ -147,43 +289,98 @@ Napi::Value api::InitShutdownSequence(const Napi::CallbackInfo &info)
 	return info.Env().Undefined();
 }
 
+static Napi::Object HotkeyToObject(Napi::Env env, uint64_t hotkeyId, const HotkeyEntry &entry)
+{
+	Napi::Object object = Napi::Object::New(env);
+	object.Set(Napi::String::New(env, "ObjectName"), Napi::String::New(env, entry.objectName));
+	object.Set(Napi::String::New(env, "ObjectType"), Napi::Number::New(env, entry.objectType));
+	object.Set(Napi::String::New(env, "HotkeyName"), Napi::String::New(env, entry.hotkeyName));
+	object.Set(Napi::String::New(env, "HotkeyDesc"), Napi::String::New(env, entry.hotkeyDesc));
+	object.Set(Napi::String::New(env, "HotkeyId"), Napi::Number::New(env, hotkeyId));
+	return object;
+}
+
+// Reply layout: revision, reset, removed count, removed ids, then five values per changed hotkey
+static void ReadHotkeyChanges(const std::vector<ipc::value> &response, std::vector<uint64_t> &removed, std::vector<std::pair<uint64_t, HotkeyEntry>> &hotkeys)
+{
+	size_t index = 4;
+	uint32_t removedCount = response[3].value_union.ui32;
+	for (uint32_t i = 0; i < removedCount && index < response.size(); i++)
+		removed.push_back(response[index++].value_union.ui64);
+
+	for (; index + 5 <= response.size(); index += 5) {
+		HotkeyEntry entry;
+		entry.objectName = response[index + 0].value_str;
+		entry.objectType = response[index + 1].value_union.ui32;
+		entry.hotkeyName = response[index + 2].value_str;
+		entry.hotkeyDesc = response[index + 3].value_str;
+		hotkeys.emplace_back(response[index + 4].value_union.ui64, std::move(entry));
+	}
+}
+
 Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_QueryHotkeys", {});
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_QueryHotkeysSince", {ipc::value(hotkeyRevision)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::Array hotkeyInfos = Napi::Array::New(info.Env());
+	std::vector<uint64_t> removed;
+	std::vector<std::pair<uint64_t, HotkeyEntry>> hotkeys;
+	ReadHotkeyChanges(response, removed, hotkeys);
+
+	if (response[2].value_union.i32)
+		hotkeyCache.clear();
+	for (uint64_t hotkeyId : removed)
+		hotkeyCache.erase(hotkeyId);
+	for (auto &hotkey : hotkeys)
+		hotkeyCache[hotkey.first] = std::move(hotkey.second);
+	hotkeyRevision = response[1].value_union.ui64;
+
+	Napi::Array hotkeyInfos = Napi::Array::New(info.Env(), hotkeyCache.size());
+	uint32_t i = 0;
+	for (auto &hotkey : hotkeyCache)
+		hotkeyInfos.Set(i++, HotkeyToObject(info.Env(), hotkey.first, hotkey.second));
+
+	return hotkeyInfos;
+}
 
-	// For each hotkey info that we need to fill
-	for (int i = 0; i < (response.size() - 1) / 5; i++) {
-		int responseIndex = i * 5 + 1;
-		Napi::Object object = Napi::Object::New(info.Env());
-		std::string objectName = response[responseIndex + 0].value_str;
-		uint32_t objectType = response[responseIndex + 1].value_union.ui32;
-		std::string hotkeyName = response[responseIndex + 2].value_str;
-		std::string hotkeyDesc = response[responseIndex + 3].value_str;
-		uint64_t hotkeyId = response[responseIndex + 4].value_union.ui64;
+Napi::Value api::OBS_API_QueryHotkeysSince(const Napi::CallbackInfo &info)
+{
+	uint64_t revision;
+	ASSERT_GET_VALUE(info, info[0], revision);
 
-		object.Set(Napi::String::New(info.Env(), "ObjectName"), Napi::String::New(info.Env(), objectName));
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
 
-		object.Set(Napi::String::New(info.Env(), "ObjectType"), Napi::Number::New(info.Env(), objectType));
+	std::vector<ipc::value> response = conn->call_synchronous_helper("API", "OBS_API_QueryHotkeysSince", {ipc::value(revision)});
 
-		object.Set(Napi::String::New(info.Env(), "HotkeyName"), Napi::String::New(info.Env(), hotkeyName));
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
 
-		object.Set(Napi::String::New(info.Env(), "HotkeyDesc"), Napi::String::New(info.Env(), hotkeyDesc));
+	std::vector<uint64_t> removed;
+	std::vector<std::pair<uint64_t, HotkeyEntry>> hotkeys;
+	ReadHotkeyChanges(response, removed, hotkeys);
 
-		object.Set(Napi::String::New(info.Env(), "HotkeyId"), Napi::Number::New(info.Env(), hotkeyId));
+	Napi::Array removedIds = Napi::Array::New(info.Env(), removed.size());
+	for (uint32_t i = 0; i < removed.size(); i++)
+		removedIds.Set(i, Napi::Number::New(info.Env(), removed[i]));
 
-		hotkeyInfos.Set(i, object);
-	}
+	Napi::Array hotkeyInfos = Napi::Array::New(info.Env(), hotkeys.size());
+	for (uint32_t i = 0; i < hotkeys.size(); i++)
+		hotkeyInfos.Set(i, HotkeyToObject(info.Env(), hotkeys[i].first, hotkeys[i].second));
 
-	return hotkeyInfos;
+	Napi::Object changes = Napi::Object::New(info.Env());
+	changes.Set("revision", Napi::Number::New(info.Env(), response[1].value_union.ui64));
+	changes.Set("reset", Napi::Boolean::New(info.Env(), response[2].value_union.i32));
+	changes.Set("removed", removedIds);
+	changes.Set("hotkeys", hotkeyInfos);
+	return changes;
 }
 
 Napi::Value api::OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo &info)
@@ -558,11 +755,14 @@ Napi::Value api::GetForceGPURenderingLegacy(const Napi::CallbackInfo &info)
 void api::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(Napi::String::New(env, "OBS_API_initAPI"), Napi::Function::New(env, api::OBS_API_initAPI));
+	exports.Set(Napi::String::New(env, "OBS_API_initAPIAsync"), Napi::Function::New(env, api::OBS_API_initAPIAsync));
+	exports.Set(Napi::String::New(env, "OBS_API_getStartupTimeline"), Napi::Function::New(env, api::OBS_API_getStartupTimeline));
 	exports.Set(Napi::String::New(env, "OBS_API_destroyOBS_API"), Napi::Function::New(env, api::OBS_API_destroyOBS_API));
 	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceStatistics"), Napi::Function::New(env, api::OBS_API_getPerformanceStatistics));
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
 	exports.Set(Napi::String::New(env, "InitShutdownSequence"), Napi::Function::New(env, api::InitShutdownSequence));
 	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeys"), Napi::Function::New(env, api::OBS_API_QueryHotkeys));
+	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeysSince"), Napi::Function::New(env, api::OBS_API_QueryHotkeysSince));
 	exports.Set(Napi::String::New(env, "OBS_API_ProcessHotkeyStatus"), Napi::Function::New(env, api::OBS_API_ProcessHotkeyStatus));
 	exports.Set(Napi::String::New(env, "SetUsername"), Napi::Function::New(env, api::SetUsername));
 	exports.Set(Napi::String::New(env, "GetPermissionsStatus"), Napi::Function::New(env, api::GetPermissionsStatus));
@@ -29,11 +29,14 @@ namespace api {
 void Init(Napi::Env env, Napi::Object exports);
 
 Napi::Value OBS_API_initAPI(const Napi::CallbackInfo &info);
+Napi::Value OBS_API_initAPIAsync(const Napi::CallbackInfo &info);
+Napi::Value OBS_API_getStartupTimeline(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_destroyOBS_API(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo &info);
 Napi::Value SetWorkingDirectory(const Napi::CallbackInfo &info);
 Napi::Value InitShutdownSequence(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_QueryHotkeys(const Napi::CallbackInfo &info);
+Napi::Value OBS_API_QueryHotkeysSince(const Napi::CallbackInfo &info);
 Napi::Value OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo &info);
 Napi::Value SetUsername(const Napi::CallbackInfo &info);
 Napi::Value GetPermissionsStatus(const Napi::CallbackInfo &info);
@@ -24,15 +24,6 @@ bool autoConfig::worker_stop = true;
 uint32_t autoConfig::sleepIntervalMS = 33;
 Napi::ThreadSafeFunction autoConfig::js_thread;
 std::thread *autoConfig::worker_thread = nullptr;
-std::vector<std::thread *> autoConfig::ac_queue_task_workers;
-
-#ifdef WIN32
-const char *ac_sem_name = nullptr; // Not used on Windows
-HANDLE ac_sem;
-#else
-const char *ac_sem_name = "autoconfig-semaphore";
-sem_t *ac_sem;
-#endif
 
 void autoConfig::worker()
 {
@@ -40,6 +31,7 @@ void autoConfig::worker()
 
 	while (!worker_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
+		bool received = false;
 
 		auto conn = Controller::GetInstance().GetConnection();
 		if (!conn) {
@@ -48,22 +40,41 @@ void autoConfig::worker()
 
 		{
 			std::vector<ipc::value> response = conn->call_synchronous_helper("AutoConfig", "Query", {});
-			if (!response.size() || (response.size() == 1)) {
+			if (response.size() < 2) {
 				goto do_sleep;
 			}
 
 			ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-			if (error == ErrorCode::Ok) {
-				AutoConfigInfo *data = new AutoConfigInfo;
+			if (error != ErrorCode::Ok) {
+				goto do_sleep;
+			}
 
-				data->event = response[1].value_str;
-				data->description = response[2].value_str;
-				data->percentage = response[3].value_union.fp64;
-				ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, data));
+			// The server hands over every event queued since the last poll, in order
+			uint32_t count = response[1].value_union.ui32;
+			size_t idx = 2;
+			for (uint32_t i = 0; i < count && idx + 5 <= response.size(); i++) {
+				AutoConfigInfo *data = new AutoConfigInfo;
+				data->event = response[idx++].value_str;
+				data->description = response[idx++].value_str;
+				data->percentage = response[idx++].value_union.fp64;
+				data->candidate = response[idx++].value_str;
+				uint32_t measurements = response[idx++].value_union.ui32;
+				for (uint32_t j = 0; j < measurements && idx + 2 <= response.size(); j++) {
+					data->measurements.emplace_back(response[idx].value_str, response[idx + 1].value_union.fp64);
+					idx += 2;
+				}
+
+				if (!dispatch(data))
+					break;
+				received = true;
 			}
 		}
 
 	do_sleep:
+		// A running test usually produces several events in a row, poll again right away
+		if (received)
+			continue;
+
 		auto tp_end = std::chrono::high_resolution_clock::now();
 		auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
 		totalSleepMS = sleepIntervalMS - dur.count();
@@ -78,7 +89,6 @@ void autoConfig::start_worker()
 		return;
 
 	worker_stop = false;
-	ac_sem = create_semaphore(ac_sem_name);
 	worker_thread = new std::thread(&autoConfig::worker);
 }
 
@@ -91,12 +101,8 @@ void autoConfig::stop_worker()
 	if (worker_thread->joinable()) {
 		worker_thread->join();
 	}
-	for (auto queue_worker : ac_queue_task_workers) {
-		if (queue_worker->joinable()) {
-			queue_worker->join();
-		}
-	}
-	remove_semaphore(ac_sem, ac_sem_name);
+	delete worker_thread;
+	worker_thread = nullptr;
 	js_thread.Release();
 }
 
@@ -163,10 +169,8 @@ Napi::Value autoConfig::StartRecordingEncoderTest(const Napi::CallbackInfo &info
 	return info.Env().Undefined();
 }
 
-void autoConfig::queueTask(AutoConfigInfo *data)
+bool autoConfig::dispatch(AutoConfigInfo *data)
 {
-	wait_semaphore(ac_sem);
-
 	auto sources_callback = [](Napi::Env env, Napi::Function jsCallback, AutoConfigInfo *event_data) {
 		try {
 			Napi::Object result = Napi::Object::New(env);
@@ -179,27 +183,31 @@ void autoConfig::queueTask(AutoConfigInfo *data)
 			}
 			result.Set(Napi::String::New(env, "continent"), Napi::String::New(env, ""));
 
+			if (!event_data->candidate.empty()) {
+				result.Set(Napi::String::New(env, "candidate"), Napi::String::New(env, event_data->candidate));
+
+				Napi::Object measurements = Napi::Object::New(env);
+				for (auto &measurement : event_data->measurements)
+					measurements.Set(Napi::String::New(env, measurement.first), Napi::Number::New(env, measurement.second));
+				result.Set(Napi::String::New(env, "measurements"), measurements);
+			}
+
 			jsCallback.Call({result});
 		} catch (...) {
 		}
 		delete event_data;
 	};
 
-	napi_status status = js_thread.NonBlockingCall(data, sources_callback);
+	napi_status status = js_thread.BlockingCall(data, sources_callback);
 	if (status != napi_ok) {
 		delete data;
+		return false;
 	}
-	release_semaphore(ac_sem);
+	return true;
 }
 
 Napi::Value autoConfig::StartCheckSettings(const Napi::CallbackInfo &info)
 {
-	AutoConfigInfo *startData = new AutoConfigInfo;
-	startData->event = "starting_step";
-	startData->description = "checking_settings";
-	startData->percentage = 0;
-	ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, startData));
-
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -209,19 +217,6 @@ Napi::Value autoConfig::StartCheckSettings(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	bool success = (bool)response[1].value_union.ui32;
-	AutoConfigInfo *stopData = new AutoConfigInfo;
-	if (!success) {
-		stopData->event = "error";
-		stopData->description = "invalid_settings";
-	} else {
-		stopData->event = "stopping_step";
-		stopData->description = "checking_settings";
-	}
-
-	stopData->percentage = 100;
-	ac_queue_task_workers.push_back(new std::thread(&autoConfig::queueTask, stopData));
-
 	return info.Env().Undefined();
 }
 
@@ -18,37 +18,26 @@
 #pragma once
 #include <napi.h>
 #include "utility-v8.hpp"
-#ifdef WIN32
-#include <windows.h>
-#else
-#include <semaphore.h>
-#endif
 
 struct AutoConfigInfo {
 	std::string event;
 	std::string description;
 	double percentage;
+	std::string candidate;
+	std::vector<std::pair<std::string, double>> measurements;
 };
 
-extern const char *ac_sem_name;
-#ifdef WIN32
-extern HANDLE ac_sem;
-#else
-extern sem_t *ac_sem;
-#endif
-
 namespace autoConfig {
 extern bool isWorkerRunning;
 extern bool worker_stop;
 extern uint32_t sleepIntervalMS;
 extern Napi::ThreadSafeFunction js_thread;
 extern std::thread *worker_thread;
-extern std::vector<std::thread *> ac_queue_task_workers;
 
 void worker(void);
 void start_worker(void);
 void stop_worker(void);
-void queueTask(AutoConfigInfo *data);
+bool dispatch(AutoConfigInfo *data);
 
 void Init(Napi::Env env, Napi::Object exports);
 
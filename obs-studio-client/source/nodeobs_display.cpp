@@ -184,6 +184,78 @@ Napi::Value display::OBS_content_createSourcePreviewDisplay(const Napi::Callback
 	return info.Env().Undefined();
 }
 
+Napi::Value display::OBS_content_createOffscreenDisplay(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+	uint32_t width = info[1].ToNumber().Uint32Value();
+	uint32_t height = info[2].ToNumber().Uint32Value();
+	int32_t mode = (info.Length() > 3) ? info[3].ToNumber().Int32Value() : 0;
+
+	uint64_t canvasId = osn::Video::nonCavasId;
+	if (info.Length() > 4) {
+		osn::Video *video = Napi::ObjectWrap<osn::Video>::Unwrap(info[4].ToObject());
+		if (video)
+			canvasId = video->canvasId;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+		"Display", "OBS_content_createOffscreenDisplay", {ipc::value(key), ipc::value(width), ipc::value(height), ipc::value(mode), ipc::value(canvasId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return info.Env().Undefined();
+}
+
+Napi::Value display::OBS_content_readOffscreenDisplay(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Display", "OBS_content_readOffscreenDisplay", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	const std::vector<char> &pixels = response[4].value_bin;
+
+	Napi::Object frame = Napi::Object::New(info.Env());
+	frame.Set("width", Napi::Number::New(info.Env(), response[1].value_union.ui32));
+	frame.Set("height", Napi::Number::New(info.Env(), response[2].value_union.ui32));
+	frame.Set("renderTime", Napi::Number::New(info.Env(), double(response[3].value_union.ui64) / 1000000.0));
+	frame.Set("pixels", Napi::Buffer<char>::Copy(info.Env(), pixels.data(), pixels.size()));
+	return frame;
+}
+
+Napi::Value display::OBS_content_getDisplayFrameTiming(const Napi::CallbackInfo &info)
+{
+	std::string key = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Display", "OBS_content_getDisplayFrameTiming", {ipc::value(key)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	// Times are reported in milliseconds
+	Napi::Object timing = Napi::Object::New(info.Env());
+	timing.Set("frames", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	timing.Set("last", Napi::Number::New(info.Env(), double(response[2].value_union.ui64) / 1000000.0));
+	timing.Set("average", Napi::Number::New(info.Env(), double(response[3].value_union.ui64) / 1000000.0));
+	timing.Set("max", Napi::Number::New(info.Env(), double(response[4].value_union.ui64) / 1000000.0));
+	return timing;
+}
+
 Napi::Value display::OBS_content_resizeDisplay(const Napi::CallbackInfo &info)
 {
 	std::string key = info[0].ToString().Utf8Value();
@@ -347,6 +419,9 @@ void display::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_content_getDisplayPreviewSize"), Napi::Function::New(env, display::OBS_content_getDisplayPreviewSize));
 	exports.Set(Napi::String::New(env, "OBS_content_createSourcePreviewDisplay"),
 		    Napi::Function::New(env, display::OBS_content_createSourcePreviewDisplay));
+	exports.Set(Napi::String::New(env, "OBS_content_createOffscreenDisplay"), Napi::Function::New(env, display::OBS_content_createOffscreenDisplay));
+	exports.Set(Napi::String::New(env, "OBS_content_readOffscreenDisplay"), Napi::Function::New(env, display::OBS_content_readOffscreenDisplay));
+	exports.Set(Napi::String::New(env, "OBS_content_getDisplayFrameTiming"), Napi::Function::New(env, display::OBS_content_getDisplayFrameTiming));
 	exports.Set(Napi::String::New(env, "OBS_content_resizeDisplay"), Napi::Function::New(env, display::OBS_content_resizeDisplay));
 	exports.Set(Napi::String::New(env, "OBS_content_moveDisplay"), Napi::Function::New(env, display::OBS_content_moveDisplay));
 	exports.Set(Napi::String::New(env, "OBS_content_setPaddingSize"), Napi::Function::New(env, display::OBS_content_setPaddingSize));
@@ -27,6 +27,9 @@ Napi::Value OBS_content_destroyDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_getDisplayPreviewOffset(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_getDisplayPreviewSize(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_createSourcePreviewDisplay(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_createOffscreenDisplay(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_readOffscreenDisplay(const Napi::CallbackInfo &info);
+Napi::Value OBS_content_getDisplayFrameTiming(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_resizeDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_moveDisplay(const Napi::CallbackInfo &info);
 Napi::Value OBS_content_setPaddingSize(const Napi::CallbackInfo &info);
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_settings.hpp"
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "utility-v8.hpp"
@@ -27,7 +28,7 @@
 #include "shared.hpp"
 #include "utility.hpp"
 
-std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, const char *buffer)
 {
 	std::vector<settings::SubCategory> category;
 
@@ -35,76 +36,76 @@ std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount
 	for (int i = 0; i < int(subCategoriesCount); i++) {
 		settings::SubCategory sc;
 
-		uint64_t *sizeMessage = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+		uint64_t *sizeMessage = reinterpret_cast<uint64_t *>(buffer + indexData);
 		indexData += sizeof(uint64_t);
 
-		std::string name(buffer.data() + indexData, *sizeMessage);
+		std::string name(buffer + indexData, *sizeMessage);
 		indexData += uint32_t(*sizeMessage);
 
-		uint32_t *paramsCount = reinterpret_cast<uint32_t *>(buffer.data() + indexData);
+		uint32_t *paramsCount = reinterpret_cast<uint32_t *>(buffer + indexData);
 		indexData += sizeof(uint32_t);
 
 		settings::Parameter param;
 		for (int j = 0; j < *paramsCount; j++) {
-			uint64_t *sizeName = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeName = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string name(buffer.data() + indexData, *sizeName);
+			std::string name(buffer + indexData, *sizeName);
 			indexData += uint32_t(*sizeName);
 
-			uint64_t *sizeDescription = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeDescription = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string description(buffer.data() + indexData, *sizeDescription);
+			std::string description(buffer + indexData, *sizeDescription);
 			indexData += uint32_t(*sizeDescription);
 
-			uint64_t *sizeType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeType = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string type(buffer.data() + indexData, *sizeType);
+			std::string type(buffer + indexData, *sizeType);
 			indexData += uint32_t(*sizeType);
 
-			uint64_t *sizeSubType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeSubType = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string subType(buffer.data() + indexData, *sizeSubType);
+			std::string subType(buffer + indexData, *sizeSubType);
 			indexData += uint32_t(*sizeSubType);
 
-			bool *enabled = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *enabled = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *masked = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *masked = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *visible = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *visible = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			double *minVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *minVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *maxVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *maxVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *stepVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *stepVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			uint64_t *sizeOfCurrentValue = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeOfCurrentValue = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> currentValue;
 			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
+			memcpy(currentValue.data(), buffer + indexData, *sizeOfCurrentValue);
 			indexData += uint32_t(*sizeOfCurrentValue);
 
-			uint64_t *sizeOfValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeOfValues = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			uint64_t *countValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *countValues = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> values;
 			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
+			memcpy(values.data(), buffer + indexData, *sizeOfValues);
 			indexData += uint32_t(*sizeOfValues);
 
 			param.name = name;
@@ -130,98 +131,86 @@ std::vector<settings::SubCategory> serializeCategory(uint32_t subCategoriesCount
 	return category;
 }
 
-Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
+static Napi::Value settingsFromResponse(Napi::Env env, std::vector<ipc::value> &response)
 {
-	std::string category = info[0].ToString().Utf8Value();
-	std::vector<std::string> listSettings = getListCategories();
-	std::vector<std::string>::iterator it = std::find(listSettings.begin(), listSettings.end(), category);
-
-	if (it == listSettings.end())
-		return Napi::Array::New(info.Env());
-
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Settings", "OBS_settings_getSettings", {ipc::value(category)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	Napi::Array array = Napi::Array::New(info.Env());
-	Napi::Object settings = Napi::Object::New(info.Env());
-
-	std::vector<settings::SubCategory> categorySettings =
-		serializeCategory(uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), response[3].value_bin);
+	Napi::Array array = Napi::Array::New(env);
+	Napi::Object settings = Napi::Object::New(env);
+
+	std::vector<settings::SubCategory> categorySettings;
+	{
+		ipc_shm::View buffer(Controller::GetInstance().SharedMemory(), response[3]);
+		if (buffer.size() >= response[2].value_union.ui64)
+			categorySettings = serializeCategory(uint32_t(response[1].value_union.ui64), uint32_t(response[2].value_union.ui64), buffer.data());
+	}
 
 	for (int i = 0; i < categorySettings.size(); i++) {
-		Napi::Object subCategory = Napi::Object::New(info.Env());
-		Napi::Array subCategoryParameters = Napi::Array::New(info.Env());
+		Napi::Object subCategory = Napi::Object::New(env);
+		Napi::Array subCategoryParameters = Napi::Array::New(env);
 		std::vector<settings::Parameter> params = categorySettings.at(i).params;
 
 		for (int j = 0; j < params.size(); j++) {
-			Napi::Object parameter = Napi::Object::New(info.Env());
+			Napi::Object parameter = Napi::Object::New(env);
 
-			parameter.Set("name", Napi::String::New(info.Env(), params.at(j).name));
-			parameter.Set("type", Napi::String::New(info.Env(), params.at(j).type));
-			parameter.Set("description", Napi::String::New(info.Env(), params.at(j).description));
-			parameter.Set("subType", Napi::String::New(info.Env(), params.at(j).subType));
+			parameter.Set("name", Napi::String::New(env, params.at(j).name));
+			parameter.Set("type", Napi::String::New(env, params.at(j).type));
+			parameter.Set("description", Napi::String::New(env, params.at(j).description));
+			parameter.Set("subType", Napi::String::New(env, params.at(j).subType));
 
 			if (params.at(j).currentValue.size() > 0) {
 				if (params.at(j).type.compare("OBS_PROPERTY_EDIT_TEXT") == 0 || params.at(j).type.compare("OBS_PROPERTY_PATH") == 0 ||
 				    params.at(j).type.compare("OBS_PROPERTY_TEXT") == 0 || params.at(j).type.compare("OBS_INPUT_RESOLUTION_LIST") == 0) {
 
 					std::string value(params.at(j).currentValue.begin(), params.at(j).currentValue.end());
-					parameter.Set("currentValue", Napi::String::New(info.Env(), value));
+					parameter.Set("currentValue", Napi::String::New(env, value));
 				} else if (params.at(j).type.compare("OBS_PROPERTY_INT") == 0) {
 					int64_t value = *reinterpret_cast<int64_t *>(params.at(j).currentValue.data());
-					parameter.Set("currentValue", Napi::Number::New(info.Env(), value));
-					parameter.Set("minVal", Napi::Number::New(info.Env(), params.at(j).minVal));
-					parameter.Set("maxVal", Napi::Number::New(info.Env(), params.at(j).maxVal));
-					parameter.Set("stepVal", Napi::Number::New(info.Env(), params.at(j).stepVal));
+					parameter.Set("currentValue", Napi::Number::New(env, value));
+					parameter.Set("minVal", Napi::Number::New(env, params.at(j).minVal));
+					parameter.Set("maxVal", Napi::Number::New(env, params.at(j).maxVal));
+					parameter.Set("stepVal", Napi::Number::New(env, params.at(j).stepVal));
 				} else if (params.at(j).type.compare("OBS_PROPERTY_UINT") == 0 || params.at(j).type.compare("OBS_PROPERTY_BITMASK") == 0) {
 					uint64_t value = *reinterpret_cast<uint64_t *>(params.at(j).currentValue.data());
-					parameter.Set("currentValue", Napi::Number::New(info.Env(), value));
-					parameter.Set("minVal", Napi::Number::New(info.Env(), params.at(j).minVal));
-					parameter.Set("maxVal", Napi::Number::New(info.Env(), params.at(j).maxVal));
-					parameter.Set("stepVal", Napi::Number::New(info.Env(), params.at(j).stepVal));
+					parameter.Set("currentValue", Napi::Number::New(env, value));
+					parameter.Set("minVal", Napi::Number::New(env, params.at(j).minVal));
+					parameter.Set("maxVal", Napi::Number::New(env, params.at(j).maxVal));
+					parameter.Set("stepVal", Napi::Number::New(env, params.at(j).stepVal));
 				} else if (params.at(j).type.compare("OBS_PROPERTY_BOOL") == 0) {
 					bool value = *reinterpret_cast<bool *>(params.at(j).currentValue.data());
-					parameter.Set("currentValue", Napi::Boolean::New(info.Env(), value));
+					parameter.Set("currentValue", Napi::Boolean::New(env, value));
 				} else if (params.at(j).type.compare("OBS_PROPERTY_DOUBLE") == 0) {
 					double value = *reinterpret_cast<double *>(params.at(j).currentValue.data());
-					parameter.Set("currentValue", Napi::Number::New(info.Env(), value));
-					parameter.Set("minVal", Napi::Number::New(info.Env(), params.at(j).minVal));
-					parameter.Set("maxVal", Napi::Number::New(info.Env(), params.at(j).maxVal));
-					parameter.Set("stepVal", Napi::Number::New(info.Env(), params.at(j).stepVal));
+					parameter.Set("currentValue", Napi::Number::New(env, value));
+					parameter.Set("minVal", Napi::Number::New(env, params.at(j).minVal));
+					parameter.Set("maxVal", Napi::Number::New(env, params.at(j).maxVal));
+					parameter.Set("stepVal", Napi::Number::New(env, params.at(j).stepVal));
 				} else if (params.at(j).type.compare("OBS_PROPERTY_LIST") == 0) {
 					if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
 						int64_t value = *reinterpret_cast<int64_t *>(params.at(j).currentValue.data());
-						parameter.Set("currentValue", Napi::Number::New(info.Env(), value));
-						parameter.Set("minVal", Napi::Number::New(info.Env(), params.at(j).minVal));
-						parameter.Set("maxVal", Napi::Number::New(info.Env(), params.at(j).maxVal));
-						parameter.Set("stepVal", Napi::Number::New(info.Env(), params.at(j).stepVal));
+						parameter.Set("currentValue", Napi::Number::New(env, value));
+						parameter.Set("minVal", Napi::Number::New(env, params.at(j).minVal));
+						parameter.Set("maxVal", Napi::Number::New(env, params.at(j).maxVal));
+						parameter.Set("stepVal", Napi::Number::New(env, params.at(j).stepVal));
 					} else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
 						double value = *reinterpret_cast<double *>(params.at(j).currentValue.data());
-						parameter.Set("currentValue", Napi::Number::New(info.Env(), value));
-						parameter.Set("minVal", Napi::Number::New(info.Env(), params.at(j).minVal));
-						parameter.Set("maxVal", Napi::Number::New(info.Env(), params.at(j).maxVal));
-						parameter.Set("stepVal", Napi::Number::New(info.Env(), params.at(j).stepVal));
+						parameter.Set("currentValue", Napi::Number::New(env, value));
+						parameter.Set("minVal", Napi::Number::New(env, params.at(j).minVal));
+						parameter.Set("maxVal", Napi::Number::New(env, params.at(j).maxVal));
+						parameter.Set("stepVal", Napi::Number::New(env, params.at(j).stepVal));
 					} else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_STRING") == 0) {
 						std::string value(params.at(j).currentValue.begin(), params.at(j).currentValue.end());
-						parameter.Set("currentValue", Napi::String::New(info.Env(), value));
+						parameter.Set("currentValue", Napi::String::New(env, value));
 					}
 				}
 			} else {
-				parameter.Set("currentValue", Napi::String::New(info.Env(), ""));
+				parameter.Set("currentValue", Napi::String::New(env, ""));
 			}
 
 			// Values
-			Napi::Array values = Napi::Array::New(info.Env());
+			Napi::Array values = Napi::Array::New(env);
 			uint32_t indexData = 0;
 
 			for (int k = 0; k < params.at(j).countValues; k++) {
-				Napi::Object valueObject = Napi::Object::New(info.Env());
+				Napi::Object valueObject = Napi::Object::New(env);
 
 				if (params.at(j).subType.compare("OBS_COMBO_FORMAT_INT") == 0) {
 					uint64_t *sizeName = reinterpret_cast<uint64_t *>(params.at(j).values.data() + indexData);
@@ -233,7 +222,7 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 
 					indexData += sizeof(int64_t);
 
-					valueObject.Set(name, Napi::Number::New(info.Env(), value));
+					valueObject.Set(name, Napi::Number::New(env, value));
 				} else if (params.at(j).subType.compare("OBS_COMBO_FORMAT_FLOAT") == 0) {
 					uint64_t *sizeName = reinterpret_cast<uint64_t *>(params.at(j).values.data() + indexData);
 					indexData += sizeof(uint64_t);
@@ -244,7 +233,7 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 
 					indexData += sizeof(double);
 
-					valueObject.Set(name, Napi::Number::New(info.Env(), value));
+					valueObject.Set(name, Napi::Number::New(env, value));
 				} else {
 					uint64_t *sizeName = reinterpret_cast<uint64_t *>(params.at(j).values.data() + indexData);
 					indexData += sizeof(uint64_t);
@@ -256,7 +245,7 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 					std::string value(params.at(j).values.data() + indexData, *sizeValue);
 					indexData += uint32_t(*sizeValue);
 
-					valueObject.Set(name, Napi::String::New(info.Env(), value));
+					valueObject.Set(name, Napi::String::New(env, value));
 				}
 				values.Set(k, valueObject);
 			}
@@ -273,23 +262,56 @@ Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
 				std::string value(params.at(j).values.data() + indexData, *sizeValue);
 				indexData += uint32_t(*sizeValue);
 
-				parameter.Set("currentValue", Napi::String::New(info.Env(), value));
+				parameter.Set("currentValue", Napi::String::New(env, value));
 			}
 			parameter.Set("values", values);
-			parameter.Set("visible", Napi::Boolean::New(info.Env(), params.at(j).visible));
-			parameter.Set("enabled", Napi::Boolean::New(info.Env(), params.at(j).enabled));
-			parameter.Set("masked", Napi::Boolean::New(info.Env(), params.at(j).masked));
+			parameter.Set("visible", Napi::Boolean::New(env, params.at(j).visible));
+			parameter.Set("enabled", Napi::Boolean::New(env, params.at(j).enabled));
+			parameter.Set("masked", Napi::Boolean::New(env, params.at(j).masked));
 			subCategoryParameters.Set(j, parameter);
 		}
-		subCategory.Set("nameSubCategory", Napi::String::New(info.Env(), categorySettings.at(i).name));
+		subCategory.Set("nameSubCategory", Napi::String::New(env, categorySettings.at(i).name));
 		subCategory.Set("parameters", subCategoryParameters);
 		array.Set(i, subCategory);
 		settings.Set("data", array);
-		settings.Set("type", Napi::Number::New(info.Env(), response[4].value_union.ui32));
+		settings.Set("type", Napi::Number::New(env, response[4].value_union.ui32));
 	}
 	return settings;
 }
 
+Napi::Value settings::OBS_settings_getSettings(const Napi::CallbackInfo &info)
+{
+	std::string category = info[0].ToString().Utf8Value();
+	std::vector<std::string> listSettings = getListCategories();
+	std::vector<std::string>::iterator it = std::find(listSettings.begin(), listSettings.end(), category);
+
+	if (it == listSettings.end())
+		return Napi::Array::New(info.Env());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Settings", "OBS_settings_getSettings", {ipc::value(category)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return settingsFromResponse(info.Env(), response);
+}
+
+Napi::Value settings::OBS_settings_getSettingsAsync(const Napi::CallbackInfo &info)
+{
+	std::string category = info[0].ToString().Utf8Value();
+	std::vector<std::string> listSettings = getListCategories();
+	std::vector<std::string>::iterator it = std::find(listSettings.begin(), listSettings.end(), category);
+
+	if (it == listSettings.end())
+		return osn::AsyncCall::Resolved(info.Env(), Napi::Array::New(info.Env()));
+
+	return osn::AsyncCall::Send(info.Env(), "Settings", "OBS_settings_getSettings", {ipc::value(category)}, settingsFromResponse);
+}
+
 std::vector<char> deserializeCategory(uint32_t *subCategoriesCount, uint32_t *sizeStruct, Napi::Array settings)
 {
 	std::vector<char> buffer;
@@ -396,8 +418,16 @@ void settings::OBS_settings_saveSettings(const Napi::CallbackInfo &info)
 	if (!conn)
 		return;
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper(
-		"Settings", "OBS_settings_saveSettings", {ipc::value(category), ipc::value(subCategoriesCount), ipc::value(sizeStruct), ipc::value(buffer)});
+	// Large categories are handed over through the shared memory region, the
+	// server frees the slot once it has read them
+	uint32_t slot = 0;
+	char *shared = Controller::GetInstance().SharedMemory().Claim(buffer.size(), slot);
+	ipc::value data = shared ? ipc::value(ipc_shm::Region::Descriptor(slot, buffer.size())) : ipc::value(buffer);
+	if (shared)
+		memcpy(shared, buffer.data(), buffer.size());
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Settings", "OBS_settings_saveSettings",
+									 {ipc::value(category), ipc::value(subCategoriesCount), ipc::value(sizeStruct), data});
 
 	if (!ValidateResponse(info, response))
 		return;
@@ -494,6 +524,7 @@ Napi::Value settings::OBS_settings_getVideoDevices(const Napi::CallbackInfo &inf
 void settings::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(Napi::String::New(env, "OBS_settings_getSettings"), Napi::Function::New(env, settings::OBS_settings_getSettings));
+	exports.Set(Napi::String::New(env, "OBS_settings_getSettingsAsync"), Napi::Function::New(env, settings::OBS_settings_getSettingsAsync));
 	exports.Set(Napi::String::New(env, "OBS_settings_saveSettings"), Napi::Function::New(env, settings::OBS_settings_saveSettings));
 	exports.Set(Napi::String::New(env, "OBS_settings_getListCategories"), Napi::Function::New(env, settings::OBS_settings_getListCategories));
 	exports.Set(Napi::String::New(env, "OBS_settings_getInputAudioDevices"), Napi::Function::New(env, settings::OBS_settings_getInputAudioDevices));
@@ -132,6 +132,7 @@ struct SubCategory {
 void Init(Napi::Env env, Napi::Object exports);
 
 Napi::Value OBS_settings_getSettings(const Napi::CallbackInfo &info);
+Napi::Value OBS_settings_getSettingsAsync(const Napi::CallbackInfo &info);
 void OBS_settings_saveSettings(const Napi::CallbackInfo &info);
 Napi::Value OBS_settings_getListCategories(const Napi::CallbackInfo &info);
 
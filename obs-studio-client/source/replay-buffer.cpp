@@ -43,6 +43,29 @@ void osn::ReplayBuffer::SetDuration(const Napi::CallbackInfo &info, const Napi::
 	conn->call_synchronous_helper(className, "SetDuration", {ipc::value(this->uid), ipc::value(value.ToNumber().Uint32Value())});
 }
 
+Napi::Value osn::ReplayBuffer::GetMaxSize(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(className, "GetMaxSize", {ipc::value(this->uid)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
+}
+
+void osn::ReplayBuffer::SetMaxSize(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call_synchronous_helper(className, "SetMaxSize", {ipc::value(this->uid), ipc::value(value.ToNumber().Uint32Value())});
+}
+
 Napi::Value osn::ReplayBuffer::GetPrefix(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
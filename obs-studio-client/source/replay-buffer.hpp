@@ -32,6 +32,8 @@ protected:
 
 	Napi::Value GetDuration(const Napi::CallbackInfo &info);
 	void SetDuration(const Napi::CallbackInfo &info, const Napi::Value &value);
+	Napi::Value GetMaxSize(const Napi::CallbackInfo &info);
+	void SetMaxSize(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetPrefix(const Napi::CallbackInfo &info);
 	void SetPrefix(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetSuffix(const Napi::CallbackInfo &info);
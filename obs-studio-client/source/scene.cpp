@@ -20,10 +20,12 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "input.hpp"
 #include "video.hpp"
+#include "ipc-pack.hpp"
 #include "ipc-value.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
@@ -49,6 +51,7 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports)
 						  InstanceMethod("orderItems", &osn::Scene::OrderItems),
 						  InstanceMethod("getItemAtIdx", &osn::Scene::GetItemAtIndex),
 						  InstanceMethod("getItems", &osn::Scene::GetItems),
+						  InstanceMethod("getItemsAsync", &osn::Scene::GetItemsAsync),
 						  InstanceMethod("getItemsInRange", &osn::Scene::GetItemsInRange),
 
 						  InstanceAccessor("configurable", &osn::Scene::CallIsConfigurable, nullptr),
@@ -407,6 +410,19 @@ Napi::Value osn::Scene::FindItem(const Napi::CallbackInfo &info)
 	return instance;
 }
 
+// GetItems, MoveItem and OrderItems reply with one packed entry per item
+static std::vector<ipc_pack::SceneItemEntry> SceneItemEntries(std::vector<ipc::value> &response)
+{
+	std::vector<ipc_pack::SceneItemEntry> entries;
+	if (response.size() < 2)
+		return entries;
+
+	ipc_pack::Reader reader(response[1]);
+	entries.resize(reader.remaining() / sizeof(ipc_pack::SceneItemEntry));
+	reader.get(entries.data(), entries.size());
+	return entries;
+}
+
 Napi::Value osn::Scene::MoveItem(const Napi::CallbackInfo &info)
 {
 	int from = info[0].ToNumber().Int64Value();
@@ -424,12 +440,11 @@ Napi::Value osn::Scene::MoveItem(const Napi::CallbackInfo &info)
 
 	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
-	if (si && response.size() > 2) {
+	std::vector<ipc_pack::SceneItemEntry> entries = SceneItemEntries(response);
+	if (si && entries.size() > 0) {
 		si->items.clear();
-
-		for (size_t i = 1; i < response.size(); i += 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
-		}
+		for (auto &entry : entries)
+			si->items.push_back(std::make_pair(entry.itemId, entry.uid));
 		si->itemsOrderCached = true;
 	}
 	return info.Env().Undefined();
@@ -462,12 +477,11 @@ Napi::Value osn::Scene::OrderItems(const Napi::CallbackInfo &info)
 
 	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
-	if (si && response.size() > 2) {
+	std::vector<ipc_pack::SceneItemEntry> entries = SceneItemEntries(response);
+	if (si && entries.size() > 0) {
 		si->items.clear();
-
-		for (size_t i = 1; i < response.size(); i += 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
-		}
+		for (auto &entry : entries)
+			si->items.push_back(std::make_pair(entry.itemId, entry.uid));
 		si->itemsOrderCached = true;
 	}
 
@@ -495,12 +509,13 @@ Napi::Value osn::Scene::GetItemAtIndex(const Napi::CallbackInfo &info)
 	return instance;
 }
 
-Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
+// Items from the cached order, undefined when the order is unknown or stale
+static Napi::Value ItemsFromCache(Napi::Env env, uint64_t sourceId)
 {
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
+	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(sourceId);
 
 	if (si && si->itemsOrderCached) {
-		Napi::Array array = Napi::Array::New(info.Env(), int(si->items.size()) - 1);
+		Napi::Array array = Napi::Array::New(env, int(si->items.size()) - 1);
 		size_t index = 0;
 		bool itemRemoved = false;
 
@@ -510,7 +525,7 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
 				itemRemoved = true;
 				break;
 			}
-			auto instance = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), item.second)});
+			auto instance = osn::SceneItem::constructor.New({Napi::Number::New(env, item.second)});
 			array.Set(uint32_t(index++), instance);
 		}
 		if (!itemRemoved) {
@@ -518,6 +533,36 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
 		}
 	}
 
+	return env.Undefined();
+}
+
+static Napi::Value ItemsFromResponse(Napi::Env env, uint64_t sourceId, std::vector<ipc::value> &response)
+{
+	std::vector<ipc_pack::SceneItemEntry> entries = SceneItemEntries(response);
+
+	Napi::Array array = Napi::Array::New(env, entries.size());
+	for (size_t i = 0; i < entries.size(); i++) {
+		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(env, entries[i].uid)});
+		array.Set(uint32_t(i), instance);
+	}
+
+	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(sourceId);
+	if (si) {
+		si->items.clear();
+		for (auto &entry : entries)
+			si->items.push_back(std::make_pair(entry.itemId, entry.uid));
+		si->itemsOrderCached = true;
+	}
+
+	return array;
+}
+
+Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
+{
+	Napi::Value cached = ItemsFromCache(info.Env(), this->sourceId);
+	if (!cached.IsUndefined())
+		return cached;
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -527,24 +572,18 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::Array array = Napi::Array::New(info.Env(), int((response.size()) - 1) / 2);
-	size_t index = 0;
-	for (size_t i = 1; i < response.size(); i++) {
-		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[i++].value_union.ui64)});
-		array.Set(uint32_t(index++), instance);
-	}
-
-	if (si) {
-		si->items.clear();
-
-		for (size_t i = 1; i < response.size(); i += 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
-		}
+	return ItemsFromResponse(info.Env(), this->sourceId, response);
+}
 
-		si->itemsOrderCached = true;
-	}
+Napi::Value osn::Scene::GetItemsAsync(const Napi::CallbackInfo &info)
+{
+	Napi::Value cached = ItemsFromCache(info.Env(), this->sourceId);
+	if (!cached.IsUndefined())
+		return osn::AsyncCall::Resolved(info.Env(), cached);
 
-	return array;
+	uint64_t sourceId = this->sourceId;
+	return osn::AsyncCall::Send(info.Env(), "Scene", "GetItems", {ipc::value(sourceId)},
+				    [sourceId](Napi::Env env, std::vector<ipc::value> &response) { return ItemsFromResponse(env, sourceId, response); });
 }
 
 Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo &info)
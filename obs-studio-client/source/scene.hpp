@@ -47,6 +47,7 @@ public:
 	Napi::Value OrderItems(const Napi::CallbackInfo &info);
 	Napi::Value GetItemAtIndex(const Napi::CallbackInfo &info);
 	Napi::Value GetItems(const Napi::CallbackInfo &info);
+	Napi::Value GetItemsAsync(const Napi::CallbackInfo &info);
 	Napi::Value GetItemsInRange(const Napi::CallbackInfo &info);
 
 	Napi::Value CallIsConfigurable(const Napi::CallbackInfo &info);
@@ -176,11 +176,7 @@ void osn::SceneItem::SetVisible(const Napi::CallbackInfo &info, const Napi::Valu
 	if (sid && visible == sid->isVisible)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
+	QueueCall(info, "SceneItem", "SetVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
 
 	sid->isVisible = visible;
 }
@@ -223,11 +219,7 @@ void osn::SceneItem::SetSelected(const Napi::CallbackInfo &info, const Napi::Val
 		return;
 	}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetSelected", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(selected)});
+	QueueCall(info, "SceneItem", "SetSelected", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(selected)});
 
 	sid->selectedChanged = true;
 	sid->cached = true;
@@ -273,11 +265,7 @@ void osn::SceneItem::SetStreamVisible(const Napi::CallbackInfo &info, const Napi
 		return;
 	}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetStreamVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(streamVisible)});
+	QueueCall(info, "SceneItem", "SetStreamVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(streamVisible)});
 
 	sid->streamVisibleChanged = true;
 	sid->isStreamVisible = streamVisible;
@@ -321,11 +309,7 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo &info, const N
 		return;
 	}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetRecordingVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(recordingVisible)});
+	QueueCall(info, "SceneItem", "SetRecordingVisible", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(recordingVisible)});
 
 	if (sid) {
 		sid->recordingVisibleChanged = true;
@@ -377,11 +361,7 @@ void osn::SceneItem::SetPosition(const Napi::CallbackInfo &info, const Napi::Val
 	if (sid && x == sid->posX && y == sid->posY)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	QueueCall(info, "SceneItem", "SetPosition", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
 	sid->posX = x;
 	sid->posY = y;
@@ -451,11 +431,7 @@ void osn::SceneItem::SetRotation(const Napi::CallbackInfo &info, const Napi::Val
 	if (sid && vector == sid->rotation)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(vector)});
+	QueueCall(info, "SceneItem", "SetRotation", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(vector)});
 
 	sid->rotation = vector;
 }
@@ -504,11 +480,7 @@ void osn::SceneItem::SetScale(const Napi::CallbackInfo &info, const Napi::Value
 	if (sid && x == sid->scaleX && y == sid->scaleY)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	QueueCall(info, "SceneItem", "SetScale", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 
 	sid->scaleX = x;
 	sid->scaleY = y;
@@ -545,11 +517,7 @@ void osn::SceneItem::SetScaleFilter(const Napi::CallbackInfo &info, const Napi::
 	if (sid && sid->scaleFilter == filter)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(filter)});
+	QueueCall(info, "SceneItem", "SetScaleFilter", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(filter)});
 
 	sid->scaleFilter = filter;
 	sid->scaleFilterChanged = false;
@@ -575,11 +543,7 @@ void osn::SceneItem::SetAlignment(const Napi::CallbackInfo &info, const Napi::Va
 {
 	uint32_t flag = value.ToNumber().Uint32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(flag)});
+	QueueCall(info, "SceneItem", "SetAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(flag)});
 }
 
 Napi::Value osn::SceneItem::GetBounds(const Napi::CallbackInfo &info)
@@ -607,11 +571,7 @@ void osn::SceneItem::SetBounds(const Napi::CallbackInfo &info, const Napi::Value
 	float_t x = vector.Get("x").ToNumber().FloatValue();
 	float_t y = vector.Get("y").ToNumber().FloatValue();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetBounds", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
+	QueueCall(info, "SceneItem", "SetBounds", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(x), ipc::value(y)});
 }
 
 Napi::Value osn::SceneItem::GetBoundsAlignment(const Napi::CallbackInfo &info)
@@ -633,11 +593,7 @@ void osn::SceneItem::SetBoundsAlignment(const Napi::CallbackInfo &info, const Na
 {
 	uint32_t visible = value.ToNumber().Uint32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetBoundsAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
+	QueueCall(info, "SceneItem", "SetBoundsAlignment", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(visible)});
 }
 
 Napi::Value osn::SceneItem::GetBoundsType(const Napi::CallbackInfo &info)
@@ -659,11 +615,7 @@ void osn::SceneItem::SetBoundsType(const Napi::CallbackInfo &info, const Napi::V
 {
 	int32_t boundsType = value.ToNumber().Int32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(boundsType)});
+	QueueCall(info, "SceneItem", "SetBoundsType", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(boundsType)});
 }
 
 Napi::Value osn::SceneItem::GetCrop(const Napi::CallbackInfo &info)
@@ -721,12 +673,8 @@ void osn::SceneItem::SetCrop(const Napi::CallbackInfo &info, const Napi::Value &
 	if (sid && left == sid->cropLeft && top == sid->cropTop && right == sid->cropRight && bottom == sid->cropBottom)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetCrop",
-		   std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(left), ipc::value(top), ipc::value(right), ipc::value(bottom)});
+	QueueCall(info, "SceneItem", "SetCrop",
+		  std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(left), ipc::value(top), ipc::value(right), ipc::value(bottom)});
 
 	sid->cropLeft = left;
 	sid->cropTop = top;
@@ -782,12 +730,7 @@ void osn::SceneItem::SetTransformInfo(const Napi::CallbackInfo &info, const Napi
 	const auto boundsAlignment = vector.Get("boundsAlignment").ToNumber().Uint32Value();
 	const auto bounds = vector.Get("bounds").ToObject();
 
-	auto conn = GetConnection(info);
-	if (!conn) {
-		return;
-	}
-
-	const auto params = std::vector<ipc::value>{
+	auto params = std::vector<ipc::value>{
 		this->itemId,
 		pos.Get("x").ToNumber().FloatValue(),
 		pos.Get("y").ToNumber().FloatValue(),
@@ -800,7 +743,7 @@ void osn::SceneItem::SetTransformInfo(const Napi::CallbackInfo &info, const Napi
 		bounds.Get("x").ToNumber().FloatValue(),
 		bounds.Get("y").ToNumber().FloatValue(),
 	};
-	const auto b = conn->call("SceneItem", "SetTransformInfo", std::move(params));
+	QueueCall(info, "SceneItem", "SetTransformInfo", std::move(params));
 }
 
 Napi::Value osn::SceneItem::GetId(const Napi::CallbackInfo &info)
@@ -829,41 +772,25 @@ Napi::Value osn::SceneItem::GetId(const Napi::CallbackInfo &info)
 
 Napi::Value osn::SceneItem::MoveUp(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "MoveUp", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "MoveUp", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::SceneItem::MoveDown(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "MoveDown", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "MoveDown", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::SceneItem::MoveTop(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "MoveTop", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "MoveTop", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::SceneItem::MoveBottom(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "MoveBottom", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "MoveBottom", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
@@ -871,31 +798,19 @@ Napi::Value osn::SceneItem::Move(const Napi::CallbackInfo &info)
 {
 	int32_t position = info[0].ToNumber().Int32Value();
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "Move", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(position)});
+	QueueCall(info, "SceneItem", "Move", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(position)});
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::SceneItem::DeferUpdateBegin(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "DeferUpdateBegin", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "DeferUpdateBegin", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
 Napi::Value osn::SceneItem::DeferUpdateEnd(const Napi::CallbackInfo &info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	conn->call("SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(this->itemId)});
+	QueueCall(info, "SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
 
@@ -930,11 +845,7 @@ void osn::SceneItem::SetBlendingMethod(const Napi::CallbackInfo &info, const Nap
 	if (sid && sid->blendingMethod == method)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetBlendingMethod", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(method)});
+	QueueCall(info, "SceneItem", "SetBlendingMethod", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(method)});
 
 	sid->blendingMethod = method;
 	sid->blendingMethodChanged = false;
@@ -971,11 +882,7 @@ void osn::SceneItem::SetBlendingMode(const Napi::CallbackInfo &info, const Napi:
 	if (sid && sid->blendingMode == mode)
 		return;
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return;
-
-	conn->call("SceneItem", "SetBlendingMode", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(mode)});
+	QueueCall(info, "SceneItem", "SetBlendingMode", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(mode)});
 
 	sid->blendingMode = mode;
 	sid->blendingModeChanged = false;
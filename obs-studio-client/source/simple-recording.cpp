@@ -41,6 +41,7 @@ Napi::Object osn::SimpleRecording::Init(Napi::Env env, Napi::Object exports)
 			InstanceAccessor("muxerSettings", &osn::SimpleRecording::GetMuxerSettings, &osn::SimpleRecording::SetMuxerSettings),
 			InstanceAccessor("videoEncoder", &osn::SimpleRecording::GetVideoEncoder, &osn::SimpleRecording::SetVideoEncoder),
 			InstanceAccessor("signalHandler", &osn::SimpleRecording::GetSignalHandler, &osn::SimpleRecording::SetSignalHandler),
+			InstanceAccessor("telemetryHandler", &osn::SimpleRecording::GetTelemetryHandler, &osn::SimpleRecording::SetTelemetryHandler),
 			InstanceAccessor("quality", &osn::SimpleRecording::GetQuality, &osn::SimpleRecording::SetQuality),
 			InstanceAccessor("audioEncoder", &osn::SimpleRecording::GetAudioEncoder, &osn::SimpleRecording::SetAudioEncoder),
 			InstanceAccessor("fileFormat", &osn::SimpleRecording::GetFileFormat, &osn::SimpleRecording::SetFileFormat),
@@ -57,6 +58,7 @@ Napi::Object osn::SimpleRecording::Init(Napi::Env env, Napi::Object exports)
 
 			InstanceMethod("start", &osn::SimpleRecording::Start),
 			InstanceMethod("stop", &osn::SimpleRecording::Stop),
+			InstanceMethod("getTelemetry", &osn::SimpleRecording::GetTelemetry),
 			InstanceMethod("splitFile", &osn::SimpleRecording::SplitFile),
 
 			StaticAccessor("legacySettings", &osn::SimpleRecording::GetLegacySettings, &osn::SimpleRecording::SetLegacySettings),
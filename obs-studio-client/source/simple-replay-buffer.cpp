@@ -39,9 +39,11 @@ Napi::Object osn::SimpleReplayBuffer::Init(Napi::Env env, Napi::Object exports)
 			     InstanceAccessor("overwrite", &osn::SimpleReplayBuffer::GetOverwrite, &osn::SimpleReplayBuffer::SetOverwrite),
 			     InstanceAccessor("noSpace", &osn::SimpleReplayBuffer::GetNoSpace, &osn::SimpleReplayBuffer::SetNoSpace),
 			     InstanceAccessor("duration", &osn::SimpleReplayBuffer::GetDuration, &osn::SimpleReplayBuffer::SetDuration),
+			     InstanceAccessor("maxSize", &osn::SimpleReplayBuffer::GetMaxSize, &osn::SimpleReplayBuffer::SetMaxSize),
 			     InstanceAccessor("prefix", &osn::SimpleReplayBuffer::GetPrefix, &osn::SimpleReplayBuffer::SetPrefix),
 			     InstanceAccessor("suffix", &osn::SimpleReplayBuffer::GetSuffix, &osn::SimpleReplayBuffer::SetSuffix),
 			     InstanceAccessor("signalHandler", &osn::SimpleReplayBuffer::GetSignalHandler, &osn::SimpleReplayBuffer::SetSignalHandler),
+			     InstanceAccessor("telemetryHandler", &osn::SimpleReplayBuffer::GetTelemetryHandler, &osn::SimpleReplayBuffer::SetTelemetryHandler),
 			     InstanceAccessor("usesStream", &osn::SimpleReplayBuffer::GetUsesStream, &osn::SimpleReplayBuffer::SetUsesStream),
 			     InstanceAccessor("streaming", &osn::SimpleReplayBuffer::GetStreaming, &osn::SimpleReplayBuffer::SetStreaming),
 			     InstanceAccessor("recording", &osn::SimpleReplayBuffer::GetRecording, &osn::SimpleReplayBuffer::SetRecording),
@@ -49,6 +51,7 @@ Napi::Object osn::SimpleReplayBuffer::Init(Napi::Env env, Napi::Object exports)
 
 			     InstanceMethod("start", &osn::SimpleReplayBuffer::Start),
 			     InstanceMethod("stop", &osn::SimpleReplayBuffer::Stop),
+			     InstanceMethod("getTelemetry", &osn::SimpleReplayBuffer::GetTelemetry),
 
 			     InstanceMethod("save", &osn::SimpleReplayBuffer::Save),
 			     InstanceMethod("lastFile", &osn::SimpleReplayBuffer::GetLastFile),
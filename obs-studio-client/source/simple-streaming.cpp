@@ -42,12 +42,14 @@ Napi::Object osn::SimpleStreaming::Init(Napi::Env env, Napi::Object exports)
 		 InstanceAccessor("useAdvanced", &osn::SimpleStreaming::GetUseAdvanced, &osn::SimpleStreaming::SetUseAdvanced),
 		 InstanceAccessor("customEncSettings", &osn::SimpleStreaming::GetCustomEncSettings, &osn::SimpleStreaming::SetCustomEncSettings),
 		 InstanceAccessor("signalHandler", &osn::SimpleStreaming::GetSignalHandler, &osn::SimpleStreaming::SetSignalHandler),
+		 InstanceAccessor("telemetryHandler", &osn::SimpleStreaming::GetTelemetryHandler, &osn::SimpleStreaming::SetTelemetryHandler),
 		 InstanceAccessor("delay", &osn::SimpleStreaming::GetDelay, &osn::SimpleStreaming::SetDelay),
 		 InstanceAccessor("reconnect", &osn::SimpleStreaming::GetReconnect, &osn::SimpleStreaming::SetReconnect),
 		 InstanceAccessor("network", &osn::SimpleStreaming::GetNetwork, &osn::SimpleStreaming::SetNetwork),
 		 InstanceAccessor("video", &osn::SimpleStreaming::GetCanvas, &osn::SimpleStreaming::SetCanvas),
 
 		 InstanceMethod("start", &osn::SimpleStreaming::Start), InstanceMethod("stop", &osn::SimpleStreaming::Stop),
+		 InstanceMethod("getTelemetry", &osn::SimpleStreaming::GetTelemetry),
 
 		 StaticAccessor("legacySettings", &osn::SimpleStreaming::GetLegacySettings, &osn::SimpleStreaming::SetLegacySettings)});
 
@@ -282,6 +282,21 @@ void osn::Streaming::SetSignalHandler(const Napi::CallbackInfo &info, const Napi
 	this->cb.SuppressDestruct();
 }
 
+Napi::Value osn::Streaming::GetTelemetry(const Napi::CallbackInfo &info)
+{
+	return getTelemetry(info, this->uid);
+}
+
+Napi::Value osn::Streaming::GetTelemetryHandler(const Napi::CallbackInfo &info)
+{
+	return getTelemetryHandler(info);
+}
+
+void osn::Streaming::SetTelemetryHandler(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	setTelemetryHandler(info, value, this->uid);
+}
+
 void osn::Streaming::Start(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
@@ -19,12 +19,13 @@
 #pragma once
 #include <napi.h>
 #include "worker-signals.hpp"
+#include "worker-telemetry.hpp"
 
 namespace osn {
-class Streaming : public WorkerSignals {
+class Streaming : public WorkerSignals, public WorkerTelemetry {
 public:
 	uint64_t uid;
-	Streaming() : WorkerSignals(){};
+	Streaming() : WorkerSignals(), WorkerTelemetry("Streaming"){};
 
 protected:
 	Napi::Function signalHandler;
@@ -48,6 +49,9 @@ protected:
 	void SetNetwork(const Napi::CallbackInfo &info, const Napi::Value &value);
 	Napi::Value GetSignalHandler(const Napi::CallbackInfo &info);
 	void SetSignalHandler(const Napi::CallbackInfo &info, const Napi::Value &value);
+	Napi::Value GetTelemetry(const Napi::CallbackInfo &info);
+	Napi::Value GetTelemetryHandler(const Napi::CallbackInfo &info);
+	void SetTelemetryHandler(const Napi::CallbackInfo &info, const Napi::Value &value);
 
 	void Start(const Napi::CallbackInfo &info);
 	void Stop(const Napi::CallbackInfo &info);
@@ -37,6 +37,10 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports)
 						  StaticMethod("create", &osn::Transition::Create),
 						  StaticMethod("createPrivate", &osn::Transition::CreatePrivate),
 						  StaticMethod("fromName", &osn::Transition::FromName),
+						  StaticMethod("preload", &osn::Transition::Preload),
+						  StaticMethod("releasePreload", &osn::Transition::ReleasePreload),
+						  StaticMethod("preloadState", &osn::Transition::PreloadState),
+						  StaticAccessor("warmCacheSize", &osn::Transition::GetWarmCacheSize, &osn::Transition::SetWarmCacheSize),
 
 						  InstanceMethod("getActiveSource", &osn::Transition::GetActiveSource),
 						  InstanceMethod("start", &osn::Transition::Start),
@@ -283,6 +287,82 @@ Napi::Value osn::Transition::Start(const Napi::CallbackInfo &info)
 	return Napi::Boolean::New(info.Env(), !!response[1].value_union.i32);
 }
 
+static Napi::Value PreloadStateToObject(const Napi::CallbackInfo &info, const std::vector<ipc::value> &response)
+{
+	uint32_t readySources = response[1].value_union.ui32;
+	uint32_t totalSources = response[2].value_union.ui32;
+
+	Napi::Object state = Napi::Object::New(info.Env());
+	state.Set("ready", Napi::Boolean::New(info.Env(), readySources == totalSources));
+	state.Set("readySources", Napi::Number::New(info.Env(), readySources));
+	state.Set("totalSources", Napi::Number::New(info.Env(), totalSources));
+	return state;
+}
+
+Napi::Value osn::Transition::Preload(const Napi::CallbackInfo &info)
+{
+	osn::Scene *scene = Napi::ObjectWrap<osn::Scene>::Unwrap(info[0].ToObject());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Preload", {ipc::value(scene->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+	return PreloadStateToObject(info, response);
+}
+
+Napi::Value osn::Transition::ReleasePreload(const Napi::CallbackInfo &info)
+{
+	osn::Scene *scene = Napi::ObjectWrap<osn::Scene>::Unwrap(info[0].ToObject());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	conn->call("Transition", "ReleasePreload", {ipc::value(scene->sourceId)});
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Transition::PreloadState(const Napi::CallbackInfo &info)
+{
+	osn::Scene *scene = Napi::ObjectWrap<osn::Scene>::Unwrap(info[0].ToObject());
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "GetPreloadState", {ipc::value(scene->sourceId)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+	return PreloadStateToObject(info, response);
+}
+
+Napi::Value osn::Transition::GetWarmCacheSize(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "GetWarmCacheSize", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
+}
+
+void osn::Transition::SetWarmCacheSize(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call("Transition", "SetWarmCacheSize", {ipc::value(value.ToNumber().Uint32Value())});
+}
+
 Napi::Value osn::Transition::CallIsConfigurable(const Napi::CallbackInfo &info)
 {
 	return osn::ISource::IsConfigurable(info, this->sourceId);
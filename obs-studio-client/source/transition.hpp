@@ -37,6 +37,11 @@ public:
 	static Napi::Value Create(const Napi::CallbackInfo &info);
 	static Napi::Value CreatePrivate(const Napi::CallbackInfo &info);
 	static Napi::Value FromName(const Napi::CallbackInfo &info);
+	static Napi::Value Preload(const Napi::CallbackInfo &info);
+	static Napi::Value ReleasePreload(const Napi::CallbackInfo &info);
+	static Napi::Value PreloadState(const Napi::CallbackInfo &info);
+	static Napi::Value GetWarmCacheSize(const Napi::CallbackInfo &info);
+	static void SetWarmCacheSize(const Napi::CallbackInfo &info, const Napi::Value &value);
 
 	Napi::Value GetActiveSource(const Napi::CallbackInfo &info);
 	Napi::Value Clear(const Napi::CallbackInfo &info);
@@ -83,6 +83,30 @@ void utility::SetThreadName(const char *threadName)
 
 static thread_local std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
 
+static Napi::Value FlushQueuedCalls(const Napi::CallbackInfo &info)
+{
+	Controller::GetInstance().FlushCalls();
+	return info.Env().Undefined();
+}
+
+void QueueCall(const Napi::CallbackInfo &info, const std::string &cname, const std::string &fname, std::vector<ipc::value> args)
+{
+	if (!Controller::GetInstance().GetConnection()) {
+		Napi::Error::New(info.Env(), "Failed to obtain IPC connection.").ThrowAsJavaScriptException();
+		exit(1);
+	}
+
+	if (!Controller::GetInstance().QueueCall(cname, fname, std::move(args)))
+		return;
+
+	// A new batch goes out from a microtask, after the task that queued it
+	Napi::Env env = info.Env();
+	Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+	deferred.Resolve(env.Undefined());
+	Napi::Promise promise = deferred.Promise();
+	promise.Get("then").As<Napi::Function>().Call(promise, {Napi::Function::New(env, FlushQueuedCalls)});
+}
+
 std::string from_utf16_wide_to_utf8(const wchar_t *from, size_t length)
 {
 	const wchar_t *from_end;
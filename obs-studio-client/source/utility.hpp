@@ -125,9 +125,14 @@ static FORCE_INLINE std::shared_ptr<ipc::client> GetConnection(const Napi::Callb
 		Napi::Error::New(info.Env(), "Failed to obtain IPC connection.").ThrowAsJavaScriptException();
 		exit(1);
 	}
+	// Anything queued must reach the server before this call does
+	Controller::GetInstance().FlushCalls();
 	return conn;
 }
 
+// Queues a fire-and-forget call, batched with the others made before the current JS task ends
+void QueueCall(const Napi::CallbackInfo &info, const std::string &cname, const std::string &fname, std::vector<ipc::value> args);
+
 namespace utility {
 template<typename T> inline std::string TypeOf(T v)
 {
@@ -31,6 +31,8 @@ Napi::Object osn::Video::Init(Napi::Env env, Napi::Object exports)
 	Napi::Function func = DefineClass(env, "Video",
 					  {
 						  StaticMethod("create", &osn::Video::Create),
+						  StaticAccessor("sharedCompositing", &osn::Video::GetSharedCompositing, &osn::Video::SetSharedCompositing),
+						  StaticAccessor("compositingStats", &osn::Video::GetCompositingStats, nullptr),
 						  InstanceMethod("destroy", &osn::Video::Destroy),
 
 						  InstanceAccessor("video", &osn::Video::get, &osn::Video::set),
@@ -81,6 +83,48 @@ Napi::Value osn::Video::GetEncodedFrames(const Napi::CallbackInfo &info)
 	return Napi::Number::New(info.Env(), response[1].value_union.ui32);
 }
 
+Napi::Value osn::Video::GetSharedCompositing(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Video", "GetSharedCompositing", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), response[1].value_union.i32);
+}
+
+void osn::Video::SetSharedCompositing(const Napi::CallbackInfo &info, const Napi::Value &value)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	conn->call("Video", "SetSharedCompositing", {ipc::value((int32_t)value.ToBoolean().Value())});
+}
+
+Napi::Value osn::Video::GetCompositingStats(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Video", "GetCompositingStats", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object stats = Napi::Object::New(info.Env());
+	stats.Set("frames", Napi::Number::New(info.Env(), response[1].value_union.ui64));
+	stats.Set("renders", Napi::Number::New(info.Env(), response[2].value_union.ui64));
+	stats.Set("reuses", Napi::Number::New(info.Env(), response[3].value_union.ui64));
+	stats.Set("probed", Napi::Number::New(info.Env(), response[4].value_union.ui64));
+	return stats;
+}
+
 Napi::Value osn::Video::Create(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
@@ -38,6 +38,10 @@ public:
 	Napi::Value GetSkippedFrames(const Napi::CallbackInfo &info);
 	Napi::Value GetEncodedFrames(const Napi::CallbackInfo &info);
 
+	static Napi::Value GetSharedCompositing(const Napi::CallbackInfo &info);
+	static void SetSharedCompositing(const Napi::CallbackInfo &info, const Napi::Value &value);
+	static Napi::Value GetCompositingStats(const Napi::CallbackInfo &info);
+
 	static Napi::Value Create(const Napi::CallbackInfo &info);
 	void Destroy(const Napi::CallbackInfo &info);
 
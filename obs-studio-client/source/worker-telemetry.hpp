@@ -0,0 +1,173 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <napi.h>
+#include <atomic>
+#include <thread>
+#include "ipc-pack.hpp"
+#include "osn-error.hpp"
+#include "utility.hpp"
+
+// Output telemetry: history fetched on demand and an optional handler fed from
+// a poll thread. The server keeps every sample in a bounded ring, so the poll
+// only asks for what came after the last sample it has seen.
+class WorkerTelemetry {
+public:
+	WorkerTelemetry(const std::string &kind) : telemetryKind(kind){};
+	~WorkerTelemetry()
+	{
+		stopTelemetryWorker();
+	};
+
+protected:
+	std::string telemetryKind;
+	std::atomic<bool> telemetryStop = true;
+	std::thread telemetryThread;
+	Napi::ThreadSafeFunction telemetryJsThread;
+	Napi::FunctionReference telemetryCb;
+	uint32_t telemetryIntervalMS = 500;
+
+	static bool fetchTelemetry(std::shared_ptr<ipc::client> conn, const std::string &kind, uint64_t refID, uint64_t after,
+				   std::vector<ipc_pack::OutputSample> &samples, uint64_t *last = nullptr)
+	{
+		std::vector<ipc::value> response =
+			conn->call_synchronous_helper("OutputTelemetry", "GetHistory", {ipc::value(kind), ipc::value(refID), ipc::value(after)});
+		if (response.size() < 3 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+			return false;
+
+		if (last)
+			*last = response[1].value_union.ui64;
+		ipc_pack::Reader reader(response[2]);
+		samples.resize(reader.remaining() / sizeof(ipc_pack::OutputSample));
+		reader.get(samples.data(), samples.size());
+		return true;
+	}
+
+	static Napi::Array telemetryToArray(Napi::Env env, const std::vector<ipc_pack::OutputSample> &samples)
+	{
+		Napi::Array array = Napi::Array::New(env, samples.size());
+		for (size_t i = 0; i < samples.size(); i++) {
+			const ipc_pack::OutputSample &sample = samples[i];
+			Napi::Object object = Napi::Object::New(env);
+			object.Set("sequence", Napi::Number::New(env, (double)sample.sequence));
+			object.Set("timestamp", Napi::Number::New(env, (double)sample.timestamp / 1000000.0));
+			object.Set("totalBytes", Napi::Number::New(env, (double)sample.totalBytes));
+			object.Set("kbitsPerSec", Napi::Number::New(env, sample.kbitsPerSec));
+			object.Set("congestion", Napi::Number::New(env, sample.congestion));
+			object.Set("droppedFrames", Napi::Number::New(env, sample.droppedFrames));
+			object.Set("totalFrames", Napi::Number::New(env, sample.totalFrames));
+			object.Set("skippedFrames", Napi::Number::New(env, sample.skippedFrames));
+			object.Set("encodedFrames", Napi::Number::New(env, sample.encodedFrames));
+			object.Set("laggedFrames", Napi::Number::New(env, sample.laggedFrames));
+			object.Set("renderedFrames", Napi::Number::New(env, sample.renderedFrames));
+			array.Set((uint32_t)i, object);
+		}
+		return array;
+	}
+
+	Napi::Value getTelemetry(const Napi::CallbackInfo &info, uint64_t refID)
+	{
+		uint64_t after = 0;
+		if (info.Length() >= 1 && info[0].IsNumber())
+			after = (uint64_t)info[0].ToNumber().Int64Value();
+
+		auto conn = GetConnection(info);
+		if (!conn)
+			return info.Env().Undefined();
+
+		std::vector<ipc_pack::OutputSample> samples;
+		if (!fetchTelemetry(conn, telemetryKind, refID, after, samples)) {
+			Napi::Error::New(info.Env(), "Failed to fetch output telemetry").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+
+		return telemetryToArray(info.Env(), samples);
+	}
+
+	Napi::Value getTelemetryHandler(const Napi::CallbackInfo &info)
+	{
+		if (telemetryCb.IsEmpty())
+			return info.Env().Undefined();
+
+		return telemetryCb.Value();
+	}
+
+	// A function starts the poll thread right away, null or undefined stops it
+	void setTelemetryHandler(const Napi::CallbackInfo &info, const Napi::Value &value, uint64_t refID)
+	{
+		stopTelemetryWorker();
+		telemetryCb.Reset();
+
+		if (!value.IsFunction())
+			return;
+
+		telemetryCb = Napi::Persistent(value.As<Napi::Function>());
+		telemetryCb.SuppressDestruct();
+
+		telemetryStop = false;
+		telemetryJsThread = Napi::ThreadSafeFunction::New(info.Env(), telemetryCb.Value(), telemetryKind.c_str(), 0, 1, [](Napi::Env) {});
+		telemetryThread = std::thread(&WorkerTelemetry::telemetryWorker, this, refID);
+	}
+
+	void telemetryWorker(uint64_t refID)
+	{
+		auto callback = [](Napi::Env env, Napi::Function jsCallback, std::vector<ipc_pack::OutputSample> *data) {
+			try {
+				jsCallback.Call({telemetryToArray(env, *data)});
+			} catch (...) {
+			}
+			delete data;
+		};
+
+		uint64_t sequence = 0;
+		while (!telemetryStop) {
+			auto conn = Controller::GetInstance().GetConnection();
+			if (conn) {
+				auto samples = new std::vector<ipc_pack::OutputSample>();
+				uint64_t last = 0;
+				bool fetched = fetchTelemetry(conn, telemetryKind, refID, sequence, *samples, &last);
+
+				// A recreated output counts again from one, pick it up on the next poll
+				if (fetched && last < sequence)
+					sequence = 0;
+
+				if (fetched && !samples->empty()) {
+					sequence = samples->back().sequence;
+					if (telemetryJsThread.BlockingCall(samples, callback) != napi_ok)
+						delete samples;
+				} else {
+					delete samples;
+				}
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(telemetryIntervalMS));
+		}
+	}
+
+	void stopTelemetryWorker()
+	{
+		if (telemetryStop)
+			return;
+
+		telemetryStop = true;
+		if (telemetryThread.joinable())
+			telemetryThread.join();
+		telemetryJsThread.Release();
+	}
+};
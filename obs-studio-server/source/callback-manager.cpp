@@ -22,6 +22,7 @@
 #include <windows.h>
 #endif
 #include "osn-error.hpp"
+#include "ipc-view.hpp"
 #include "shared.hpp"
 #include "osn-source.hpp"
 #include "osn-volmeter.hpp"
@@ -38,13 +39,18 @@ void CallbackManager::Register(ipc::server &srv)
 
 void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	// Volmeter ids are read in place from the binary argument
+	ipc_view::span<uint64_t> volmeters = ipc_view::array<uint64_t>(args[1], args[0].value_union.ui64);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	// Placeholder for the count of resized sources, patched once it is known
+	rval.push_back(ipc::value((uint32_t)0));
 
 	if (!sources.empty()) {
-		sources_sizes_mtx.lock();
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
 		uint32_t size = 0;
 
-		for (auto item : sources) {
+		for (auto &item : sources) {
 			SourceSizeInfo *si = item.second;
 			// See if width or height changed here
 			uint32_t newWidth = obs_source_get_width(si->source);
@@ -65,26 +71,15 @@ void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vecto
 			}
 		}
 
-		rval.insert(rval.begin() + 1, ipc::value(size));
-		sources_sizes_mtx.unlock();
-	} else {
-		rval.insert(rval.begin() + 1, ipc::value((uint32_t)0));
+		rval[1] = ipc::value(size);
 	}
 
-	uint64_t size_buffer = args[0].value_union.ui64;
-
-	std::vector<char> buffer;
-	buffer.resize(size_buffer);
-	memcpy(buffer.data(), args[1].value_bin.data(), size_buffer);
-
-	uint64_t nb_volmeters = size_buffer / sizeof(uint64_t);
-	uint64_t index = 0;
-
-	for (int i = 0; i < nb_volmeters; i++) {
-		uint64_t id = *reinterpret_cast<uint64_t *>(buffer.data() + index);
-		osn::Volmeter::getAudioData(id, rval);
-		index += sizeof(uint64_t);
-	}
+	// Levels of every meter travel as one packed binary after the resized sources
+	ipc_pack::Writer meters(ipc_pack::Scratch());
+	meters.reserve(volmeters.size() * (sizeof(ipc_pack::MeterHeader) + sizeof(ipc_pack::MeterChannel) * MAX_AUDIO_CHANNELS));
+	for (uint64_t volmeter : volmeters)
+		osn::Volmeter::getAudioData(volmeter, meters);
+	rval.push_back(meters.value());
 
 	AUTO_DEBUG;
 }
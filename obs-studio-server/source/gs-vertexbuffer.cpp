@@ -26,6 +26,21 @@ extern "C" {
 #pragma warning(pop)
 }
 
+// Draw callbacks already own the graphics context, entering it again only costs a lock.
+struct ScopedGraphics final {
+	bool m_entered;
+	ScopedGraphics() : m_entered(gs_get_context() == nullptr)
+	{
+		if (m_entered)
+			obs_enter_graphics();
+	}
+	~ScopedGraphics()
+	{
+		if (m_entered)
+			obs_leave_graphics();
+	}
+};
+
 GS::VertexBuffer::~VertexBuffer()
 {
 	m_positions = nullptr;
@@ -41,30 +56,30 @@ GS::VertexBuffer::~VertexBuffer()
 	m_layerdata = nullptr;
 
 	if (m_vertexbuffer) {
-		obs_enter_graphics();
+		ScopedGraphics graphics;
 		gs_vertexbuffer_destroy(m_vertexbuffer);
-		obs_leave_graphics();
 		m_vertexbuffer = nullptr;
 	}
 }
 
-GS::VertexBuffer::VertexBuffer(uint32_t maximumVertices)
+GS::VertexBuffer::VertexBuffer(uint32_t maximumVertices, uint32_t attributes)
 {
-	SetupVertexBuffer(maximumVertices);
+	SetupVertexBuffer(maximumVertices, attributes);
 
 	// In case of device being removed, try again to create VertexBuffer
 	// after manually rebuilding GPU device
 	if (!m_vertexbuffer) {
 		blog(LOG_ERROR, "GS::VertexBuffer: fail to create buffer, trying to rebuild device");
 
-		obs_enter_graphics();
-		gs_rebuild_device();
-		obs_leave_graphics();
+		{
+			ScopedGraphics graphics;
+			gs_rebuild_device();
+		}
 
 		// in case the exception is thrown during m_vertexbuffer creation,
 		// it would delete the m_vertexbufferdata as well,
 		// thus, need to recreate everything from scratch.
-		SetupVertexBuffer(maximumVertices);
+		SetupVertexBuffer(maximumVertices, attributes);
 
 		if (!m_vertexbuffer) {
 			throw std::runtime_error("Failed to create vertex buffer.");
@@ -102,16 +117,22 @@ GS::VertexBuffer::VertexBuffer(gs_vertbuffer_t *vb)
 	}
 }
 
-GS::VertexBuffer::VertexBuffer(VertexBuffer const &other) : VertexBuffer(other.m_capacity)
+GS::VertexBuffer::VertexBuffer(VertexBuffer const &other) : VertexBuffer(other.m_capacity, other.m_attributes)
 {
 	// Copy Constructor
+	m_size = other.m_size;
 	memcpy(m_positions, other.m_positions, m_capacity * sizeof(vec3));
-	memcpy(m_normals, other.m_normals, m_capacity * sizeof(vec3));
-	memcpy(m_tangents, other.m_tangents, m_capacity * sizeof(vec3));
-	memcpy(m_colors, other.m_colors, m_capacity * sizeof(vec3));
+	if (m_normals)
+		memcpy(m_normals, other.m_normals, m_capacity * sizeof(vec3));
+	if (m_tangents)
+		memcpy(m_tangents, other.m_tangents, m_capacity * sizeof(vec3));
+	if (m_colors)
+		memcpy(m_colors, other.m_colors, m_capacity * sizeof(uint32_t));
 	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
-		memcpy(m_uvs[n], other.m_uvs[n], m_capacity * sizeof(vec3));
+		if (m_uvs[n])
+			memcpy(m_uvs[n], other.m_uvs[n], m_capacity * sizeof(vec4));
 	}
+	m_dirty = true;
 }
 
 GS::VertexBuffer::VertexBuffer(VertexBuffer const &&other)
@@ -120,6 +141,8 @@ GS::VertexBuffer::VertexBuffer(VertexBuffer const &&other)
 	m_capacity = other.m_capacity;
 	m_size = other.m_size;
 	m_layers = other.m_layers;
+	m_attributes = other.m_attributes;
+	m_dirty = other.m_dirty;
 	m_positions = other.m_positions;
 	m_normals = other.m_normals;
 	m_tangents = other.m_tangents;
@@ -137,9 +160,8 @@ void GS::VertexBuffer::operator=(VertexBuffer const &&other)
 	// Move Assignment
 	/// First self-destruct (semi-destruct itself).
 	if (m_vertexbuffer) {
-		obs_enter_graphics();
+		ScopedGraphics graphics;
 		gs_vertexbuffer_destroy(m_vertexbuffer);
-		obs_leave_graphics();
 		m_vertexbuffer = nullptr;
 	}
 
@@ -147,6 +169,8 @@ void GS::VertexBuffer::operator=(VertexBuffer const &&other)
 	m_capacity = other.m_capacity;
 	m_size = other.m_size;
 	m_layers = other.m_layers;
+	m_attributes = other.m_attributes;
+	m_dirty = other.m_dirty;
 	m_positions = other.m_positions;
 	m_normals = other.m_normals;
 	m_tangents = other.m_tangents;
@@ -164,6 +188,8 @@ void GS::VertexBuffer::Resize(uint32_t new_size)
 	if (new_size > m_capacity) {
 		throw std::out_of_range("new_size out of range");
 	}
+	if (m_size != new_size)
+		m_dirty = true;
 	m_size = new_size;
 }
 
@@ -172,6 +198,11 @@ uint32_t GS::VertexBuffer::Size()
 	return m_size;
 }
 
+uint32_t GS::VertexBuffer::Capacity()
+{
+	return m_capacity;
+}
+
 bool GS::VertexBuffer::Empty()
 {
 	return m_size == 0;
@@ -183,9 +214,12 @@ const GS::Vertex GS::VertexBuffer::At(uint32_t idx)
 		throw std::out_of_range("idx out of range");
 	}
 
-	GS::Vertex vtx(&m_positions[idx], &m_normals[idx], &m_tangents[idx], &m_colors[idx], nullptr);
+	m_dirty = true;
+
+	GS::Vertex vtx(&m_positions[idx], m_normals ? &m_normals[idx] : nullptr, m_tangents ? &m_tangents[idx] : nullptr,
+		       m_colors ? &m_colors[idx] : nullptr, nullptr);
 	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
-		vtx.uv[n] = &m_uvs[n][idx];
+		vtx.uv[n] = m_uvs[n] ? &m_uvs[n][idx] : nullptr;
 	}
 	return vtx;
 }
@@ -205,23 +239,37 @@ uint32_t GS::VertexBuffer::GetUVLayers()
 	return m_layers;
 }
 
+uint32_t GS::VertexBuffer::GetAttributes()
+{
+	return m_attributes;
+}
+
+void GS::VertexBuffer::MarkDirty()
+{
+	m_dirty = true;
+}
+
 vec3 *GS::VertexBuffer::GetPositions()
 {
+	m_dirty = true;
 	return m_positions;
 }
 
 vec3 *GS::VertexBuffer::GetNormals()
 {
+	m_dirty = true;
 	return m_normals;
 }
 
 vec3 *GS::VertexBuffer::GetTangents()
 {
+	m_dirty = true;
 	return m_tangents;
 }
 
 uint32_t *GS::VertexBuffer::GetColors()
 {
+	m_dirty = true;
 	return m_colors;
 }
 
@@ -230,42 +278,49 @@ vec4 *GS::VertexBuffer::GetUVLayer(size_t idx)
 	if ((idx < 0) || (idx >= m_layers)) {
 		throw std::out_of_range("idx out of range");
 	}
+	m_dirty = true;
 	return m_uvs[idx];
 }
 
 gs_vertbuffer_t *GS::VertexBuffer::Update(bool refreshGPU)
 {
-	if (!refreshGPU)
+	if (!refreshGPU || !m_dirty)
 		return m_vertexbuffer;
 
 	if (m_size > m_capacity)
 		throw std::out_of_range("size is larger than capacity");
 
-	// Update VertexBuffer data.
+	// libobs always maps the whole buffer for writing and copies vb_data->num
+	// vertices from the start, so the smallest valid upload is the used part.
 	m_vertexbufferdata = gs_vertexbuffer_get_data(m_vertexbuffer);
-	memset(m_vertexbufferdata, 0, sizeof(gs_vb_data));
-	m_vertexbufferdata->num = m_capacity;
+	m_vertexbufferdata->num = m_size;
 	m_vertexbufferdata->points = m_positions;
 	m_vertexbufferdata->normals = m_normals;
 	m_vertexbufferdata->tangents = m_tangents;
 	m_vertexbufferdata->colors = m_colors;
-	m_vertexbufferdata->num_tex = m_layers;
+	m_vertexbufferdata->num_tex = m_layerdata ? m_layers : 0;
 	m_vertexbufferdata->tvarray = m_layerdata;
-	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
-		m_layerdata[n].array = m_uvs[n];
-		m_layerdata[n].width = 4;
+	if (m_layerdata) {
+		for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+			m_layerdata[n].array = m_uvs[n];
+			m_layerdata[n].width = 4;
+		}
 	}
 
 	// Update GPU
-	obs_enter_graphics();
-	gs_vertexbuffer_flush(m_vertexbuffer);
-	obs_leave_graphics();
+	if (m_size > 0) {
+		ScopedGraphics graphics;
+		gs_vertexbuffer_flush(m_vertexbuffer);
+	}
+	m_dirty = false;
 
 	// WORKAROUND: OBS Studio 20.x and below incorrectly deletes data that it doesn't own.
 	m_vertexbufferdata->num = m_capacity;
-	m_vertexbufferdata->num_tex = m_layers;
-	for (uint32_t n = 0; n < m_layers; n++) {
-		m_layerdata[n].width = 4;
+	m_vertexbufferdata->num_tex = m_layerdata ? m_layers : 0;
+	if (m_layerdata) {
+		for (uint32_t n = 0; n < m_layers; n++) {
+			m_layerdata[n].width = 4;
+		}
 	}
 
 	return m_vertexbuffer;
@@ -276,38 +331,58 @@ gs_vertbuffer_t *GS::VertexBuffer::Update()
 	return Update(true);
 }
 
-void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices)
+void GS::VertexBuffer::SetupVertexBuffer(uint32_t maximumVertices, uint32_t attributes)
 {
 	if (maximumVertices > MAXIMUM_VERTICES) {
 		throw std::out_of_range("maximumVertices out of range");
 	}
 
 	m_size = 0;
+	m_dirty = false;
 	// Assign limits.
 	m_capacity = maximumVertices;
-	m_layers = MAXIMUM_UVW_LAYERS;
+	m_attributes = attributes | ATTRIBUTE_POSITION;
+	m_layers = (m_attributes & ATTRIBUTE_UV) ? MAXIMUM_UVW_LAYERS : 0;
 
-	// Allocate memory for data.
+	// Allocate memory for data, only for the attributes in use since libobs
+	// creates and flushes one GPU buffer per non-null array.
 	m_vertexbufferdata = gs_vbdata_create();
 	m_vertexbufferdata->num = m_capacity;
 	m_vertexbufferdata->points = m_positions = (vec3 *)bmalloc(sizeof(vec3) * m_capacity);
 	memset(m_positions, 0, sizeof(vec3) * m_capacity);
-	m_vertexbufferdata->normals = m_normals = (vec3 *)bmalloc(sizeof(vec3) * m_capacity);
-	memset(m_normals, 0, sizeof(vec3) * m_capacity);
-	m_vertexbufferdata->tangents = m_tangents = (vec3 *)bmalloc(sizeof(vec3) * m_capacity);
-	memset(m_tangents, 0, sizeof(vec3) * m_capacity);
-	m_vertexbufferdata->colors = m_colors = (uint32_t *)bmalloc(sizeof(uint32_t) * m_capacity);
-	memset(m_colors, 0, sizeof(uint32_t) * m_capacity);
+	m_normals = nullptr;
+	if (m_attributes & ATTRIBUTE_NORMAL) {
+		m_normals = (vec3 *)bmalloc(sizeof(vec3) * m_capacity);
+		memset(m_normals, 0, sizeof(vec3) * m_capacity);
+	}
+	m_vertexbufferdata->normals = m_normals;
+	m_tangents = nullptr;
+	if (m_attributes & ATTRIBUTE_TANGENT) {
+		m_tangents = (vec3 *)bmalloc(sizeof(vec3) * m_capacity);
+		memset(m_tangents, 0, sizeof(vec3) * m_capacity);
+	}
+	m_vertexbufferdata->tangents = m_tangents;
+	m_colors = nullptr;
+	if (m_attributes & ATTRIBUTE_COLOR) {
+		m_colors = (uint32_t *)bmalloc(sizeof(uint32_t) * m_capacity);
+		memset(m_colors, 0, sizeof(uint32_t) * m_capacity);
+	}
+	m_vertexbufferdata->colors = m_colors;
 	m_vertexbufferdata->num_tex = m_layers;
-	m_vertexbufferdata->tvarray = m_layerdata = (gs_tvertarray *)bmalloc(sizeof(gs_tvertarray) * m_layers);
-	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
-		m_layerdata[n].array = m_uvs[n] = (vec4 *)bmalloc(sizeof(vec4) * m_capacity);
-		m_layerdata[n].width = 4;
-		memset(m_uvs[n], 0, sizeof(vec4) * m_capacity);
+	m_layerdata = nullptr;
+	for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++)
+		m_uvs[n] = nullptr;
+	if (m_layers > 0) {
+		m_layerdata = (gs_tvertarray *)bmalloc(sizeof(gs_tvertarray) * m_layers);
+		for (size_t n = 0; n < MAXIMUM_UVW_LAYERS; n++) {
+			m_layerdata[n].array = m_uvs[n] = (vec4 *)bmalloc(sizeof(vec4) * m_capacity);
+			m_layerdata[n].width = 4;
+			memset(m_uvs[n], 0, sizeof(vec4) * m_capacity);
+		}
 	}
+	m_vertexbufferdata->tvarray = m_layerdata;
 
 	// Allocate GPU
-	obs_enter_graphics();
+	ScopedGraphics graphics;
 	m_vertexbuffer = gs_vertexbuffer_create(m_vertexbufferdata, GS_DYNAMIC);
-	obs_leave_graphics();
 }
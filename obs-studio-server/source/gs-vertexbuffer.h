@@ -29,6 +29,15 @@ extern "C" {
 }
 
 namespace GS {
+enum VertexAttribute : uint32_t {
+	ATTRIBUTE_POSITION = 1 << 0,
+	ATTRIBUTE_NORMAL = 1 << 1,
+	ATTRIBUTE_TANGENT = 1 << 2,
+	ATTRIBUTE_COLOR = 1 << 3,
+	ATTRIBUTE_UV = 1 << 4,
+	ATTRIBUTE_ALL = ATTRIBUTE_POSITION | ATTRIBUTE_NORMAL | ATTRIBUTE_TANGENT | ATTRIBUTE_COLOR | ATTRIBUTE_UV,
+};
+
 class VertexBuffer {
 public:
 	virtual ~VertexBuffer();
@@ -37,8 +46,9 @@ public:
 		* \brief Create a Vertex Buffer with a specific number of Vertices.
 		*
 		* \param maximumVertices Maximum amount of vertices to store.
+		* \param attributes Combination of VertexAttribute, attributes left out are neither allocated nor uploaded.
 		*/
-	VertexBuffer(uint32_t maximumVertices);
+	VertexBuffer(uint32_t maximumVertices, uint32_t attributes = ATTRIBUTE_ALL);
 
 	/*!
 		* \brief Create a Vertex Buffer with the maximum number of Vertices.
@@ -95,6 +105,8 @@ public:
 
 	uint32_t Size();
 
+	uint32_t Capacity();
+
 	bool Empty();
 
 	const GS::Vertex At(uint32_t idx);
@@ -105,6 +117,14 @@ public:
 
 	uint32_t GetUVLayers();
 
+	uint32_t GetAttributes();
+
+	/*!
+		* \brief Flag the vertex data as modified
+		* Done automatically by At() and the Get* accessors, the next Update() will upload it.
+		*/
+	void MarkDirty();
+
 	/*!
 		* \brief Directly access the positions buffer
 		* Returns the internal memory that is assigned to hold all vertex positions.
@@ -145,17 +165,25 @@ public:
 		*/
 	vec4 *GetUVLayer(size_t idx);
 
+	/*!
+		* \brief Upload the vertex data to the GPU if it was modified
+		* Only the used part of the buffer (Size() vertices) is uploaded.
+		*
+		* \return The GPU vertex buffer.
+		*/
 	gs_vertbuffer_t *Update();
 
 	gs_vertbuffer_t *Update(bool refreshGPU);
 
 private:
-	void SetupVertexBuffer(uint32_t maximumVertices);
+	void SetupVertexBuffer(uint32_t maximumVertices, uint32_t attributes);
 
 private:
 	uint32_t m_size;
 	uint32_t m_capacity;
 	uint32_t m_layers;
+	uint32_t m_attributes;
+	bool m_dirty;
 
 	// Memory Storage
 	vec3 *m_positions;
@@ -170,4 +198,13 @@ public:
 	gs_vertbuffer_t *m_vertexbuffer;
 	gs_tvertarray *m_layerdata;
 };
+
+/*!
+	* \brief Vertex Buffer holding only positions and colors
+	* Meant for solid geometry (outlines, boxes, handles) drawn with the solid effect.
+	*/
+class SolidVertexBuffer : public VertexBuffer {
+public:
+	SolidVertexBuffer(uint32_t maximumVertices) : VertexBuffer(maximumVertices, ATTRIBUTE_POSITION | ATTRIBUTE_COLOR){};
+};
 } // namespace GS
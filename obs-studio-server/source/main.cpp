@@ -16,6 +16,8 @@
 
 ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <inttypes.h>
 #include <iostream>
@@ -26,6 +28,9 @@
 #include <memory>
 #include <thread>
 #include <vector>
+#include "osn-batch.hpp"
+#include "osn-shared-memory.hpp"
+#include "osn-collection.hpp"
 #include "osn-error.hpp"
 #include "nodeobs_api.h"
 #include "nodeobs_autoconfig.h"
@@ -60,6 +65,11 @@
 #include "osn-simple-replay-buffer.hpp"
 #include "osn-advanced-replay-buffer.hpp"
 #include "osn-file-output.hpp"
+#include "osn-output-reaper.hpp"
+#include "osn-render-cache.hpp"
+#include "osn-hotkey-index.hpp"
+#include "osn-scene-preloader.hpp"
+#include "osn-output-telemetry.hpp"
 
 #include "util-crashmanager.h"
 #include "shared.hpp"
@@ -151,6 +161,31 @@ void ServerDisconnectHandler(void *data, int64_t)
 	sd->count_connected--;
 }
 
+#ifdef WIN32
+static HANDLE socketReadyEvent = NULL;
+#endif
+
+// Tells a client waiting in Controller::connect that the socket is listening, see controller.cpp
+static void SignalSocketReady(const std::string &uri)
+{
+#ifdef WIN32
+	std::string name = "Local\\osn-ready-" + uri;
+	std::replace(name.begin() + strlen("Local\\"), name.end(), '\\', '_');
+	socketReadyEvent = CreateEventW(NULL, TRUE, FALSE, std::wstring(name.begin(), name.end()).c_str());
+	if (socketReadyEvent)
+		SetEvent(socketReadyEvent);
+#elif defined(__APPLE__)
+	const char *readyFd = getenv("OSN_READY_FD");
+	if (readyFd) {
+		int fd = atoi(readyFd);
+		if (fd > STDERR_FILENO) {
+			write(fd, "1", 1);
+			close(fd);
+		}
+	}
+#endif
+}
+
 namespace System {
 static void Shutdown(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
@@ -166,6 +201,8 @@ static void Shutdown(void *data, const int64_t id, const std::vector<ipc::value>
 
 int main(int argc, char *argv[])
 {
+	OBS_API::MarkStartupEvent("process start");
+
 #ifdef __APPLE__
 	// Reuse file discriptors 1 and 2 in case they not open at launch so output to stdout and stderr not redirected to unexpected file
 	struct stat sb;
@@ -235,6 +272,8 @@ int main(int argc, char *argv[])
 	};
 
 	/// OBS Studio Node
+	osn::Batch::Register(myServer);
+	osn::SharedMemory::Register(myServer);
 	osn::Global::Register(myServer);
 	osn::Source::Register(myServer);
 	osn::Input::Register(myServer);
@@ -242,6 +281,7 @@ int main(int argc, char *argv[])
 	osn::Transition::Register(myServer);
 	osn::Scene::Register(myServer);
 	osn::SceneItem::Register(myServer);
+	osn::Collection::Register(myServer);
 	osn::Fader::Register(myServer);
 	osn::Volmeter::Register(myServer);
 	osn::Properties::Register(myServer);
@@ -269,6 +309,7 @@ int main(int argc, char *argv[])
 	osn::ISimpleReplayBuffer::Register(myServer);
 	osn::IAdvancedReplayBuffer::Register(myServer);
 	osn::IFileOutput::Register(myServer);
+	osn::OutputTelemetry::Register(myServer);
 
 	OBS_API::CreateCrashHandlerExitPipe();
 
@@ -276,6 +317,15 @@ int main(int argc, char *argv[])
 	myServer.set_connect_handler(ServerConnectHandler, &sd);
 	myServer.set_disconnect_handler(ServerDisconnectHandler, &sd);
 
+	// Only used to time the first call, initAPI replaces it with the crash manager callbacks in release builds
+	myServer.set_pre_callback(
+		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
+			static std::atomic<bool> firstCall{true};
+			if (firstCall.load(std::memory_order_relaxed) && firstCall.exchange(false))
+				OBS_API::MarkStartupEvent("first ipc call");
+		},
+		nullptr);
+
 	// Initialize Server
 	try {
 		myServer.initialize(socketPath.c_str());
@@ -287,6 +337,9 @@ int main(int argc, char *argv[])
 		return ipc::ProcessInfo::ExitCode::OTHER_ERROR;
 	}
 
+	OBS_API::MarkStartupEvent("socket ready");
+	SignalSocketReady(argv[1]);
+
 	// Reset Connect/Disconnect time.
 	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
 
@@ -315,9 +368,18 @@ int main(int argc, char *argv[])
 	OBS_API::WaitCrashHandlerClose(waitBeforeClosing);
 #endif
 	osn::Source::finalize_global_signals();
+	osn::HotkeyIndex::Stop();
+	osn::OutputTelemetry::Stop();
+	osn::OutputReaper::Stop();
+	osn::RenderCache::Stop();
+	osn::ScenePreloader::Stop();
 
 	// First, be sure there are no connected clients
 	myServer.finalize();
+#ifdef WIN32
+	if (socketReadyEvent)
+		CloseHandle(socketReadyEvent);
+#endif
 
 	// Then, shutdown OBS
 	OBS_API::destroyOBS_API();
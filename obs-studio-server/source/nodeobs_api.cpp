@@ -26,6 +26,7 @@
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
 #include "nodeobs_autoconfig.h"
+#include "osn-module.hpp"
 #include "util/lexer.h"
 #include "util-crashmanager.h"
 #include "util-metricsprovider.h"
@@ -39,9 +40,15 @@
 #include "osn-reconnect.hpp"
 #include "osn-network.hpp"
 #include "osn-audio-track.hpp"
+#include "osn-hotkey-index.hpp"
+#include "osn-scene-preloader.hpp"
+#include "osn-render-cache.hpp"
+#include "osn-batch.hpp"
 #include "memory-manager.h"
 
 #include <sys/types.h>
+#include <atomic>
+#include <mutex>
 
 #ifdef __APPLE
 #include <unistd.h>
@@ -106,6 +113,12 @@ struct NodeOBSLogParam final {
 	bool enableDebugLogs = true;
 };
 
+struct StartupPhase {
+	std::string name;
+	uint64_t startNs;
+	uint64_t durationNs;
+};
+
 std::string g_moduleDirectory = "";
 os_cpu_usage_info_t *cpuUsageInfo = nullptr;
 #ifdef WIN32
@@ -132,6 +145,57 @@ static bool lowLatencyAudioBuffering = false;
 static bool forceGPURendering = true;
 static std::string processPriority = "Normal";
 
+// Startup events and initAPI phases, timestamps come from os_gettime_ns which shares its
+// clock with the client's steady_clock so both timelines can be merged
+static std::mutex startupMtx;
+static std::vector<StartupPhase> startupTimeline;
+static size_t startupPhaseFirst = 0;
+static uint64_t startupPhaseStart = 0;
+static std::atomic<bool> firstFrameRendered{false};
+
+void OBS_API::MarkStartupEvent(const std::string &name)
+{
+	std::unique_lock<std::mutex> ulock(startupMtx);
+	startupTimeline.push_back({name, os_gettime_ns(), 0});
+}
+
+static void BeginStartupProfile()
+{
+	std::unique_lock<std::mutex> ulock(startupMtx);
+	startupPhaseFirst = startupTimeline.size();
+	startupPhaseStart = os_gettime_ns();
+}
+
+static void EndStartupPhase(const char *name)
+{
+	std::unique_lock<std::mutex> ulock(startupMtx);
+	uint64_t now = os_gettime_ns();
+	startupTimeline.push_back({name, startupPhaseStart, now - startupPhaseStart});
+	startupPhaseStart = now;
+}
+
+// Phases are timed before the log handler exists, so they are only printed once initAPI is done
+static void LogStartupProfile()
+{
+	std::unique_lock<std::mutex> ulock(startupMtx);
+	uint64_t total = 0;
+	for (size_t idx = startupPhaseFirst; idx < startupTimeline.size(); idx++)
+		total += startupTimeline[idx].durationNs;
+
+	blog(LOG_INFO, "Startup profile: %.1f ms", double(total) / 1000000.0);
+	for (size_t idx = startupPhaseFirst; idx < startupTimeline.size(); idx++)
+		blog(LOG_INFO, "    %-24s %8.1f ms", startupTimeline[idx].name.c_str(), double(startupTimeline[idx].durationNs) / 1000000.0);
+}
+
+static void FirstFrameCallback(void *param, uint32_t cx, uint32_t cy)
+{
+	if (firstFrameRendered.load(std::memory_order_relaxed))
+		return;
+
+	if (!firstFrameRendered.exchange(true))
+		OBS_API::MarkStartupEvent("first frame");
+}
+
 void OBS_API::Register(ipc::server &srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("API");
@@ -140,9 +204,11 @@ void OBS_API::Register(ipc::server &srv)
 		"OBS_API_initAPI", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String, ipc::type::String}, OBS_API_initAPI));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_destroyOBS_API", std::vector<ipc::type>{}, OBS_API_destroyOBS_API));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_getPerformanceStatistics", std::vector<ipc::type>{}, OBS_API_getPerformanceStatistics));
+	cls->register_function(std::make_shared<ipc::function>("OBS_API_getStartupTimeline", std::vector<ipc::type>{}, OBS_API_getStartupTimeline));
 	cls->register_function(std::make_shared<ipc::function>("SetWorkingDirectory", std::vector<ipc::type>{ipc::type::String}, SetWorkingDirectory));
 	cls->register_function(std::make_shared<ipc::function>("StopCrashHandler", std::vector<ipc::type>{}, StopCrashHandler));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeys", std::vector<ipc::type>{}, QueryHotkeys));
+	cls->register_function(std::make_shared<ipc::function>("OBS_API_QueryHotkeysSince", std::vector<ipc::type>{ipc::type::UInt64}, QueryHotkeysSince));
 	cls->register_function(std::make_shared<ipc::function>("OBS_API_ProcessHotkeyStatus", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32},
 							       ProcessHotkeyStatus));
 	cls->register_function(std::make_shared<ipc::function>("SetUsername", std::vector<ipc::type>{ipc::type::String}, SetUsername));
@@ -794,6 +860,8 @@ void addModulePaths()
 
 void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	BeginStartupProfile();
+
 	writeCrashHandler(registerProcess());
 
 	/* Map base DLLs as soon as possible into the current process space.
@@ -820,22 +888,18 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 		}
 	}
 
-#ifdef WIN32
 	// Register the pre and post server callbacks to log the data into the crashmanager
 	g_server->set_pre_callback(
 		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
-			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
-			crashManager.ProcessPreServerCall(cname, fname, args);
+			util::CrashManager::ProcessPreServerCall(cname, fname, args);
 		},
-		&crashManager);
+		nullptr);
 	g_server->set_post_callback(
 		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
-			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
-			crashManager.ProcessPostServerCall(cname, fname, args);
+			util::CrashManager::ProcessPostServerCall(cname, fname, args);
 		},
-		&crashManager);
-
-#endif
+		nullptr);
+	osn::Batch::SetCallHooks(util::CrashManager::ProcessPreServerCall, util::CrashManager::ProcessPostServerCall);
 #endif
 
 #ifdef WIN32
@@ -849,6 +913,8 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 		func();
 	}
 #endif
+	EndStartupPhase("crash handler");
+
 	obs_add_data_path((g_moduleDirectory + "/data/libobs/").c_str());
 	slobs_plugin = appdata.substr(0, appdata.size() - strlen("/slobs-client"));
 	slobs_plugin.append("/slobs-plugins");
@@ -866,6 +932,7 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 		util::CrashManager::AddWarning("Failed to start OBS, locale: " + locale + " user data: " + userDataPath);
 #endif
 	}
+	EndStartupPhase("obs_startup");
 
 	/* Logging */
 	std::string filename = GenerateTimeDateFilename("txt");
@@ -909,6 +976,7 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 #endif
 
 	osn::Source::initialize_global_signals();
+	osn::HotkeyIndex::Start();
 
 	cpuUsageInfo = os_cpu_usage_info_start();
 	ConfigManager::getInstance().setAppdataPath(appdata);
@@ -920,10 +988,11 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 	obs_data_set_bool(private_settings, "BrowserHWAccel", browserAccel);
 	obs_apply_private_data(private_settings);
 	obs_data_release(private_settings);
+	EndStartupPhase("configuration");
 
 	addModulePaths();
 	struct obs_module_failure_info mfi;
-	obs_load_all_modules2(&mfi);
+	osn::Module::LoadAll(appdata + "/node-obs/module-cache.json", &mfi);
 
 	if (mfi.count) {
 		char **plugin = mfi.failed_modules;
@@ -933,20 +1002,15 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 		}
 	}
 
-	OBS_service::createService(StreamServiceId::Main);
-	OBS_service::createService(StreamServiceId::Second);
-	OBS_service::createStreamingOutput(StreamServiceId::Main);
-	OBS_service::createStreamingOutput(StreamServiceId::Second);
-	OBS_service::createRecordingOutput();
-	OBS_service::createReplayBufferOutput();
-
-	OBS_service::createVideoStreamingEncoder(StreamServiceId::Main);
-	OBS_service::createVideoStreamingEncoder(StreamServiceId::Second);
-	OBS_service::createVideoRecordingEncoder();
+	EndStartupPhase("obs_load_all_modules2");
 
+	// Streaming services and video encoders are created by their getters the first time
+	// they are needed, outputs are created when they are started.
 	OBS_service::resetAudioContext();
+	EndStartupPhase("audio reset");
 
 	OBS_service::setupAudioEncoder();
+	EndStartupPhase("audio encoders");
 
 	setAudioDeviceMonitoring();
 
@@ -965,6 +1029,10 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 	obs_set_replay_buffer_rendering_mode(useStreamOutput ? OBS_STREAMING_REPLAY_BUFFER_RENDERING : OBS_RECORDING_REPLAY_BUFFER_RENDERING);
 
 	util::CrashManager::setAppState("idle");
+	EndStartupPhase("finalize");
+	LogStartupProfile();
+
+	obs_add_main_render_callback(FirstFrameCallback, nullptr);
 
 	// We are returning a video result here because the frontend needs to know if we sucessfully
 	// initialized the Dx11 API
@@ -983,11 +1051,28 @@ void OBS_API::OBS_API_destroyOBS_API(void *data, const int64_t id, const std::ve
 	//  osn::Source::Manager.
 	osn::Source::finalize_global_signals();
 	/* END INJECT osn::Source::Manager */
+	osn::HotkeyIndex::Stop();
+	osn::ScenePreloader::Stop();
+	osn::RenderCache::Stop();
 	destroyOBS_API();
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
 
+void OBS_API::OBS_API_getStartupTimeline(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(startupMtx);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)startupTimeline.size()));
+	for (auto &event : startupTimeline) {
+		rval.push_back(ipc::value(event.name));
+		rval.push_back(ipc::value(event.startNs));
+		rval.push_back(ipc::value(event.durationNs));
+	}
+	AUTO_DEBUG;
+}
+
 void OBS_API::OBS_API_getPerformanceStatistics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -1015,123 +1100,40 @@ void OBS_API::OBS_API_getPerformanceStatistics(void *data, const int64_t id, con
 	AUTO_DEBUG;
 }
 
-void OBS_API::QueryHotkeys(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+static void PushHotkey(std::vector<ipc::value> &rval, osn::HotkeyIndex::Hotkey &hotkey)
 {
-	struct HotkeyInfo {
-		std::string objectName;
-		obs_hotkey_registerer_type objectType;
-		std::string hotkeyName;
-		std::string hotkeyDesc;
-		obs_hotkey_id hotkeyId;
-	};
-
-	// For each registered hotkey
-	std::vector<HotkeyInfo> hotkeyInfos;
-	obs_enum_hotkeys(
-		[](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
-			// Make sure every word has an initial capital letter
-			auto ToTitle = [](std::string s) {
-				bool last = true;
-				for (char &c : s) {
-					int full_c = (uint8_t)c;
-					full_c = last ? ::toupper(full_c) : ::tolower(full_c);
-					last = ::isspace(full_c);
-				}
-				return s;
-			};
-			std::vector<HotkeyInfo> &hotkeyInfos = *static_cast<std::vector<HotkeyInfo> *>(data);
-			auto registerer_type = obs_hotkey_get_registerer_type(key);
-			void *registerer = obs_hotkey_get_registerer(key);
-			HotkeyInfo currentHotkeyInfo;
-			if (registerer == nullptr)
-				return true;
-
-			// Discover the type of object registered with this hotkey
-			switch (registerer_type) {
-			case OBS_HOTKEY_REGISTERER_NONE:
-			case OBS_HOTKEY_REGISTERER_FRONTEND: {
-				// Ignore any frontend hotkey
-				return true;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_SOURCE: {
-				auto *weak_source = static_cast<obs_weak_source_t *>(registerer);
-				auto key_source = OBSGetStrongRef(weak_source);
-				if (key_source == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_source_get_name(key_source);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SOURCE;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_OUTPUT: {
-				auto *weak_output = static_cast<obs_weak_output_t *>(registerer);
-				auto key_output = OBSGetStrongRef(weak_output);
-				if (key_output == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_output_get_name(key_output);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_OUTPUT;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_ENCODER: {
-				auto *weak_encoder = static_cast<obs_weak_encoder_t *>(registerer);
-				auto key_encoder = OBSGetStrongRef(weak_encoder);
-				if (key_encoder == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_encoder_get_name(key_encoder);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_ENCODER;
-				break;
-			}
-			case OBS_HOTKEY_REGISTERER_SERVICE: {
-				auto *weak_service = static_cast<obs_weak_service_t *>(registerer);
-				auto key_service = OBSGetStrongRef(weak_service);
-				if (key_service == nullptr)
-					return true;
-				currentHotkeyInfo.objectName = obs_service_get_name(key_service);
-				currentHotkeyInfo.objectType = OBS_HOTKEY_REGISTERER_SERVICE;
-				break;
-			}
-			}
-
-			// Key defs
-			const char *_key_name = obs_hotkey_get_name(key);
-			const char *_desc = obs_hotkey_get_description(key);
-
-			if (!_key_name)
-				return true;
-
-			if (!_desc)
-				_desc = "";
+	rval.push_back(ipc::value(std::move(hotkey.objectName)));
+	rval.push_back(ipc::value(uint32_t(hotkey.objectType)));
+	rval.push_back(ipc::value(std::move(hotkey.hotkeyName)));
+	rval.push_back(ipc::value(std::move(hotkey.hotkeyDesc)));
+	rval.push_back(ipc::value(uint64_t(hotkey.hotkeyId)));
+}
 
-			auto key_name = std::string(_key_name);
-			auto desc = std::string(_desc);
-			const auto hotkeyId = obs_hotkey_get_id(key);
+void OBS_API::QueryHotkeys(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::HotkeyIndex::Changes changes = osn::HotkeyIndex::Query(0);
 
-			// Parse the key name and the description
-			key_name = key_name.substr(key_name.find_first_of(".") + 1);
-			std::replace(key_name.begin(), key_name.end(), '-', '_');
-			std::transform(key_name.begin(), key_name.end(), key_name.begin(), ::toupper);
-			std::replace(desc.begin(), desc.end(), '-', ' ');
-			desc = ToTitle(desc);
+	rval.reserve(1 + changes.hotkeys.size() * 5);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (auto &hotkey : changes.hotkeys)
+		PushHotkey(rval, hotkey);
 
-			currentHotkeyInfo.hotkeyName = key_name;
-			currentHotkeyInfo.hotkeyDesc = desc;
-			currentHotkeyInfo.hotkeyId = hotkeyId;
-			hotkeyInfos.push_back(currentHotkeyInfo);
+	AUTO_DEBUG;
+}
 
-			return true;
-		},
-		&hotkeyInfos);
+void OBS_API::QueryHotkeysSince(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::HotkeyIndex::Changes changes = osn::HotkeyIndex::Query(args[0].value_union.ui64);
 
+	rval.reserve(4 + changes.removed.size() + changes.hotkeys.size() * 5);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	// For each hotkey that we've found
-	for (auto &hotkeyInfo : hotkeyInfos) {
-		rval.push_back(ipc::value(hotkeyInfo.objectName));
-		rval.push_back(ipc::value(uint32_t(hotkeyInfo.objectType)));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyName));
-		rval.push_back(ipc::value(hotkeyInfo.hotkeyDesc));
-		rval.push_back(ipc::value(uint64_t(hotkeyInfo.hotkeyId)));
-	}
+	rval.push_back(ipc::value(changes.revision));
+	rval.push_back(ipc::value((int32_t)changes.reset));
+	rval.push_back(ipc::value((uint32_t)changes.removed.size()));
+	for (obs_hotkey_id removed : changes.removed)
+		rval.push_back(ipc::value(uint64_t(removed)));
+	for (auto &hotkey : changes.hotkeys)
+		PushHotkey(rval, hotkey);
 
 	AUTO_DEBUG;
 }
@@ -1532,6 +1534,7 @@ void OBS_API::destroyOBS_API(void)
 	}
 #endif
 	OBS_content::OBS_content_shutdownDisplays();
+	obs_remove_main_render_callback(FirstFrameCallback, nullptr);
 
 	autoConfig::WaitPendingTests();
 
@@ -1541,24 +1544,13 @@ void OBS_API::destroyOBS_API(void)
 	for (int i = 0; i < MAX_CHANNELS; i++)
 		obs_set_output_source(i, nullptr);
 
-	obs_encoder_t *streamingEncoder;
-	streamingEncoder = OBS_service::getStreamingEncoder(StreamServiceId::Main);
-	if (streamingEncoder != NULL) {
-		obs_encoder_release(streamingEncoder);
-		streamingEncoder = nullptr;
-	}
+	// The getters create video encoders and services on first use, release
+	// them through the setters so nothing gets created during shutdown
+	OBS_service::setStreamingEncoder(nullptr, StreamServiceId::Main);
+	OBS_service::setStreamingEncoder(nullptr, StreamServiceId::Second);
 
-	streamingEncoder = OBS_service::getStreamingEncoder(StreamServiceId::Second);
-	if (streamingEncoder != NULL) {
-		obs_encoder_release(streamingEncoder);
-		streamingEncoder = nullptr;
-	}
-
-	obs_encoder_t *recordingEncoder = OBS_service::getRecordingEncoder();
-	if (recordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering())) {
-		obs_encoder_release(recordingEncoder);
-		recordingEncoder = nullptr;
-	}
+	if (OBS_service::useRecordingPreset() || obs_get_multiple_rendering())
+		OBS_service::setRecordingEncoder(nullptr);
 
 	obs_encoder_t *audioStreamingEncoder = OBS_service::getAudioSimpleStreamingEncoder();
 	if (audioStreamingEncoder != NULL) {
@@ -1582,13 +1574,13 @@ void OBS_API::destroyOBS_API(void)
 	streamingOutput = OBS_service::getStreamingOutput(StreamServiceId::Main);
 	if (streamingOutput != NULL) {
 		obs_output_release(streamingOutput);
-		streamingEncoder = nullptr;
+		streamingOutput = nullptr;
 	}
 
 	streamingOutput = OBS_service::getStreamingOutput(StreamServiceId::Second);
 	if (streamingOutput != NULL) {
 		obs_output_release(streamingOutput);
-		streamingEncoder = nullptr;
+		streamingOutput = nullptr;
 	}
 
 	obs_output_t *recordingOutput = OBS_service::getRecordingOutput();
@@ -1612,18 +1604,8 @@ void OBS_API::destroyOBS_API(void)
 		virtualWebcamOutput = nullptr;
 	}
 
-	obs_service_t *service;
-	service = OBS_service::getService(StreamServiceId::Main);
-	if (service != NULL) {
-		obs_service_release(service);
-		service = nullptr;
-	}
-
-	service = OBS_service::getService(StreamServiceId::Second);
-	if (service != NULL) {
-		obs_service_release(service);
-		service = nullptr;
-	}
+	OBS_service::setService(nullptr, StreamServiceId::Main);
+	OBS_service::setService(nullptr, StreamServiceId::Second);
 
 	OBS_service::clearAudioEncoder();
 	osn::Volmeter::ClearVolmeters();
@@ -17,8 +17,7 @@
 ******************************************************************************/
 
 #include "nodeobs_autoconfig.h"
-#include <array>
-#include <future>
+#include <condition_variable>
 #include "osn-error.hpp"
 #include "shared.hpp"
 
@@ -32,27 +31,46 @@ enum class Quality { Stream, High };
 
 enum class FPSType : int { PreferHighFPS, PreferHighRes, UseCurrent, fps30, fps60 };
 
-enum ThreadedTests : int { BandwidthTest, StreamEncoderTest, RecordingEncoderTest, SaveStreamSettings, SaveSettings, SetDefaultSettings, Count };
-
 class AutoConfigInfo {
 public:
-	AutoConfigInfo(const std::string &a_event, const std::string &a_description, double a_percentage)
+	AutoConfigInfo(const std::string &a_event, const std::string &a_description, double a_percentage, const std::string &a_candidate = "",
+		       const std::vector<std::pair<std::string, double>> &a_measurements = {})
 	{
 		event = a_event;
 		description = a_description;
 		percentage = a_percentage;
+		candidate = a_candidate;
+		measurements = a_measurements;
 	};
 	~AutoConfigInfo(){};
 
 	std::string event;
 	std::string description;
 	double percentage;
+	// Server, resolution or encoder currently under test, if any
+	std::string candidate;
+	// Interim results for the candidate (bitrate, connect time, skipped frames...)
+	std::vector<std::pair<std::string, double>> measurements;
 };
 
-std::array<std::future<void>, ThreadedTests::Count> asyncTests;
 std::mutex eventsMutex;
 std::queue<AutoConfigInfo> events;
 
+// All the steps run one after the other on a single long-lived worker
+std::thread stepsWorker;
+std::mutex stepsMutex;
+std::condition_variable stepsCV;
+std::queue<void (*)()> steps;
+bool stepsWorkerStop = false;
+bool stepsWorkerRunning = false;
+bool stepRunning = false;
+
+static void PushEvent(AutoConfigInfo &&info)
+{
+	std::unique_lock<std::mutex> ulock(eventsMutex);
+	events.push(std::move(info));
+}
+
 Service serviceSelected = Service::Other;
 Quality recordingQuality = Quality::Stream;
 Encoder recordingEncoder = Encoder::Stream;
@@ -130,26 +148,66 @@ void autoConfig::Register(ipc::server &srv)
 	srv.register_collection(cls);
 }
 
-void autoConfig::WaitPendingTests(double timeout)
+void autoConfig::StepsWorker()
 {
-	clock_t start_time = clock();
-	while ((float(clock() - start_time) / CLOCKS_PER_SEC) < timeout) {
-
-		bool all_finished = true;
-		for (auto &async_test : asyncTests) {
-			if (async_test.valid()) {
-				auto status = async_test.wait_for(std::chrono::milliseconds(0));
-				if (status != std::future_status::ready) {
-					all_finished = false;
-				}
-			}
+	std::unique_lock<std::mutex> ulock(stepsMutex);
+	while (!stepsWorkerStop) {
+		if (steps.empty()) {
+			stepsCV.wait(ulock);
+			continue;
 		}
 
-		if (all_finished)
-			break;
+		void (*step)() = steps.front();
+		steps.pop();
+		stepRunning = true;
+		ulock.unlock();
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		step();
+
+		ulock.lock();
+		stepRunning = false;
+		stepsCV.notify_all();
+	}
+
+	stepsWorkerRunning = false;
+	stepsCV.notify_all();
+}
+
+void autoConfig::QueueStep(void (*step)())
+{
+	std::unique_lock<std::mutex> ulock(stepsMutex);
+
+	// A worker detached by WaitPendingTests may still be inside its step, keep it instead of starting a second one
+	stepsWorkerStop = false;
+	if (!stepsWorkerRunning) {
+		if (stepsWorker.joinable())
+			stepsWorker.join();
+		stepsWorkerRunning = true;
+		stepsWorker = std::thread(StepsWorker);
 	}
+	steps.push(step);
+	stepsCV.notify_all();
+}
+
+void autoConfig::WaitPendingTests(double timeout)
+{
+	std::unique_lock<std::mutex> ulock(stepsMutex);
+	if (!stepsWorkerRunning)
+		return;
+
+	bool idle = stepsCV.wait_for(ulock, std::chrono::duration<double>(timeout), [] { return steps.empty() && !stepRunning; });
+
+	stepsWorkerStop = true;
+	stepsCV.notify_all();
+	ulock.unlock();
+
+	// A step stuck on a network timeout must not keep the server from shutting down
+	if (!stepsWorker.joinable())
+		return;
+	if (idle)
+		stepsWorker.join();
+	else
+		stepsWorker.detach();
 }
 
 void autoConfig::TestHardwareEncoding(void)
@@ -269,15 +327,6 @@ void GetServers(std::vector<ServerInfo> &servers)
 	obs_properties_destroy(ppts);
 }
 
-void start_next_step(void (*task)(), std::string event, std::string description, int percentage)
-{
-	/*eventCallbackQueue.work_queue.push_back({cb, event, description, percentage});
-    eventCallbackQueue.Signal();
-
-    if(task)
-    	std::thread(*task).detach();*/
-}
-
 void autoConfig::TerminateAutoConfig(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	StopThread();
@@ -287,20 +336,29 @@ void autoConfig::TerminateAutoConfig(void *data, const int64_t id, const std::ve
 
 void autoConfig::Query(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::unique_lock<std::mutex> ulock(eventsMutex);
-	if (events.empty()) {
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
+	std::queue<AutoConfigInfo> pending;
+	{
+		std::unique_lock<std::mutex> ulock(eventsMutex);
+		std::swap(pending, events);
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	rval.push_back(ipc::value(events.front().event));
-	rval.push_back(ipc::value(events.front().description));
-	rval.push_back(ipc::value(events.front().percentage));
-
-	events.pop();
+	rval.push_back(ipc::value((uint32_t)pending.size()));
+
+	// Every pending event is delivered at once so that no progress is lost between two polls
+	while (!pending.empty()) {
+		const AutoConfigInfo &info = pending.front();
+		rval.push_back(ipc::value(info.event));
+		rval.push_back(ipc::value(info.description));
+		rval.push_back(ipc::value(info.percentage));
+		rval.push_back(ipc::value(info.candidate));
+		rval.push_back(ipc::value((uint32_t)info.measurements.size()));
+		for (auto &measurement : info.measurements) {
+			rval.push_back(ipc::value(measurement.first));
+			rval.push_back(ipc::value(measurement.second));
+		}
+		pending.pop();
+	}
 
 	AUTO_DEBUG;
 }
@@ -329,7 +387,7 @@ void autoConfig::InitializeAutoConfig(void *data, const int64_t id, const std::v
 
 void autoConfig::StartBandwidthTest(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::BandwidthTest] = std::async(std::launch::async, TestBandwidthThread);
+	QueueStep(TestBandwidthThread);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -337,7 +395,7 @@ void autoConfig::StartBandwidthTest(void *data, const int64_t id, const std::vec
 
 void autoConfig::StartStreamEncoderTest(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::StreamEncoderTest] = std::async(std::launch::async, TestStreamEncoderThread);
+	QueueStep(TestStreamEncoderThread);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -345,7 +403,7 @@ void autoConfig::StartStreamEncoderTest(void *data, const int64_t id, const std:
 
 void autoConfig::StartRecordingEncoderTest(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::RecordingEncoderTest] = std::async(std::launch::async, TestRecordingEncoderThread);
+	QueueStep(TestRecordingEncoderThread);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -353,7 +411,7 @@ void autoConfig::StartRecordingEncoderTest(void *data, const int64_t id, const s
 
 void autoConfig::StartSaveStreamSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::SaveStreamSettings] = std::async(std::launch::async, SaveStreamSettings);
+	QueueStep(SaveStreamSettings);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -361,7 +419,7 @@ void autoConfig::StartSaveStreamSettings(void *data, const int64_t id, const std
 
 void autoConfig::StartSaveSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::SaveSettings] = std::async(std::launch::async, SaveSettings);
+	QueueStep(SaveSettings);
 
 	cancel = false;
 
@@ -371,7 +429,13 @@ void autoConfig::StartSaveSettings(void *data, const int64_t id, const std::vect
 
 void autoConfig::StartCheckSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
+	PushEvent(AutoConfigInfo("starting_step", "checking_settings", 0));
+
 	bool sucess = CheckSettings();
+	if (sucess)
+		PushEvent(AutoConfigInfo("stopping_step", "checking_settings", 100));
+	else
+		PushEvent(AutoConfigInfo("error", "invalid_settings", 100));
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value((uint32_t)sucess));
@@ -380,7 +444,7 @@ void autoConfig::StartCheckSettings(void *data, const int64_t id, const std::vec
 
 void autoConfig::StartSetDefaultSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	asyncTests[ThreadedTests::SetDefaultSettings] = std::async(std::launch::async, SetDefaultSettings);
+	QueueStep(SetDefaultSettings);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -469,16 +533,12 @@ int EvaluateBandwidth(ServerInfo &server, bool &connected, bool &stopped, bool &
 
 void sendErrorMessage(const std::string &message)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("error", message, 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("error", message, 0));
 }
 
 void autoConfig::TestBandwidthThread(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "bandwidth_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "bandwidth_test", 0));
 
 	bool connected = false;
 	bool stopped = false;
@@ -506,9 +566,7 @@ void autoConfig::TestBandwidthThread(void)
 
 	int ret = obs_set_video_info(ovi, &video);
 	if (ret != OBS_VIDEO_SUCCESS) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_video_settings", 0));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_video_settings", 0));
 		obs_remove_video_info(ovi);
 		return;
 	}
@@ -722,32 +780,25 @@ void autoConfig::TestBandwidthThread(void)
 		ServerInfo info(serverName.c_str(), server.c_str());
 
 		if (EvaluateBandwidth(info, connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings) < 0) {
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-			eventsMutex.unlock();
+			PushEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 			gotError = true;
 		} else {
 			bestServer = info.address;
 			bestServerName = info.name;
 			bestBitrate = info.bitrate;
 
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", 100));
-			eventsMutex.unlock();
+			PushEvent(AutoConfigInfo("progress", "bandwidth_test", 100, info.name, {{"bitrate", (double)info.bitrate}, {"ms", (double)info.ms}}));
 		}
 	} else {
 		for (size_t i = 0; i < servers.size(); i++) {
 			EvaluateBandwidth(servers[i], connected, stopped, success, errorOnStop, service_settings, service, output, vencoder_settings);
-			eventsMutex.lock();
-			events.push(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size()));
-			eventsMutex.unlock();
+			PushEvent(AutoConfigInfo("progress", "bandwidth_test", (double)(i + 1) * 100 / servers.size(), servers[i].name,
+						 {{"bitrate", (double)servers[i].bitrate}, {"ms", (double)servers[i].ms}}));
 		}
 	}
 
 	if (!success && !gotError) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_stream_settings", 0));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_stream_settings", 0));
 		gotError = true;
 	}
 
@@ -777,9 +828,7 @@ void autoConfig::TestBandwidthThread(void)
 	}
 
 	if (!gotError) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("stopping_step", "bandwidth_test", 100));
 	}
 }
 
@@ -907,7 +956,7 @@ void autoConfig::FindIdealHardwareResolution()
 	idealFPSDen = result.fps_den;
 }
 
-bool autoConfig::TestSoftwareEncoding()
+bool autoConfig::TestSoftwareEncoding(const char *step)
 {
 	OBSEncoder vencoder = obs_video_encoder_create("obs_x264", "test_x264", nullptr, nullptr);
 	OBSEncoder aencoder = obs_audio_encoder_create("ffmpeg_aac", "test_aac", nullptr, 0, nullptr);
@@ -1070,6 +1119,9 @@ bool autoConfig::TestSoftwareEncoding()
 		if (force || skipped <= 10)
 			results.emplace_back(cx, cy, fps_num, fps_den);
 
+		std::string candidate = std::to_string(cx) + "x" + std::to_string(cy) + "@" + std::to_string(fps_num / fps_den);
+		PushEvent(AutoConfigInfo("progress", step, per, candidate, {{"skipped_frames", (double)skipped}}));
+
 		return !cancel;
 	};
 
@@ -1164,15 +1216,13 @@ bool autoConfig::TestSoftwareEncoding()
 
 void autoConfig::TestStreamEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "streamingEncoder_test", 0));
 
 	TestHardwareEncoding();
 
 	if (!softwareTested) {
 		if (!preferHardware || !hardwareEncodingAvailable) {
-			if (!TestSoftwareEncoding()) {
+			if (!TestSoftwareEncoding("streamingEncoder_test")) {
 				return;
 			}
 		}
@@ -1195,21 +1245,17 @@ void autoConfig::TestStreamEncoderThread()
 		streamingEncoder = Encoder::x264;
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "streamingEncoder_test", 100));
 }
 
 void autoConfig::TestRecordingEncoderThread()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "recordingEncoder_test", 0));
 
 	TestHardwareEncoding();
 
 	if (!hardwareEncodingAvailable && !softwareTested) {
-		if (!TestSoftwareEncoding()) {
+		if (!TestSoftwareEncoding("recordingEncoder_test")) {
 			return;
 		}
 	}
@@ -1242,9 +1288,7 @@ void autoConfig::TestRecordingEncoderThread()
 		}
 	}
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "recordingEncoder_test", 100));
 }
 
 inline const char *GetEncoderId(Encoder enc)
@@ -1303,9 +1347,7 @@ bool autoConfig::CheckSettings(void)
 	OBSService service = obs_service_create("rtmp_common", "serviceTest", settings, NULL);
 
 	if (!service) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_service", 100));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_service", 100));
 		return false;
 	}
 
@@ -1327,9 +1369,7 @@ bool autoConfig::CheckSettings(void)
 	video.initialized = true;
 	int ret = obs_set_video_info(ovi, &video);
 	if (ret != OBS_VIDEO_SUCCESS) {
-		eventsMutex.lock();
-		events.push(AutoConfigInfo("error", "invalid_video_settings", 100));
-		eventsMutex.unlock();
+		PushEvent(AutoConfigInfo("error", "invalid_video_settings", 100));
 		obs_remove_video_info(ovi);
 		return false;
 	}
@@ -1449,9 +1489,7 @@ bool autoConfig::CheckSettings(void)
 
 void autoConfig::SetDefaultSettings(void)
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "setting_default_settings", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "setting_default_settings", 0));
 
 	idealResolutionCX = 1280;
 	idealResolutionCY = 720;
@@ -1461,9 +1499,7 @@ void autoConfig::SetDefaultSettings(void)
 	streamingEncoder = Encoder::x264;
 	recordingEncoder = Encoder::Stream;
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "setting_default_settings", 100));
 }
 
 void autoConfig::SaveStreamSettings()
@@ -1471,9 +1507,7 @@ void autoConfig::SaveStreamSettings()
 	/* ---------------------------------- */
 	/* save service                       */
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_service", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "saving_service", 0));
 
 	const char *service_id = "rtmp_common";
 
@@ -1504,16 +1538,12 @@ void autoConfig::SaveStreamSettings()
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_service", 100));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "saving_service", 100));
 }
 
 void autoConfig::SaveSettings()
 {
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("starting_step", "saving_settings", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("starting_step", "saving_settings", 0));
 
 	if (recordingEncoder != Encoder::Stream)
 		config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecEncoder", GetEncoderDisplayName(recordingEncoder));
@@ -1535,8 +1565,6 @@ void autoConfig::SaveSettings()
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
 
-	eventsMutex.lock();
-	events.push(AutoConfigInfo("stopping_step", "saving_settings", 100));
-	events.push(AutoConfigInfo("done", "", 0));
-	eventsMutex.unlock();
+	PushEvent(AutoConfigInfo("stopping_step", "saving_settings", 100));
+	PushEvent(AutoConfigInfo("done", "", 0));
 }
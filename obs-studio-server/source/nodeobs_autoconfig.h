@@ -42,8 +42,10 @@ void TerminateAutoConfig(void *data, const int64_t id, const std::vector<ipc::va
 void Query(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
 void StopThread();
+void StepsWorker();
+void QueueStep(void (*step)());
 void FindIdealHardwareResolution();
-bool TestSoftwareEncoding();
+bool TestSoftwareEncoding(const char *step);
 void TestBandwidthThread();
 void TestStreamEncoderThread();
 void TestRecordingEncoderThread();
@@ -177,6 +177,17 @@ void OBS_content::Register(ipc::server &srv)
 										      ipc::type::UInt32, ipc::type::UInt64},
 							       OBS_content_createSourcePreviewDisplay));
 
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_createOffscreenDisplay",
+							       std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::Int32,
+										      ipc::type::UInt64},
+							       OBS_content_createOffscreenDisplay));
+
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_readOffscreenDisplay", std::vector<ipc::type>{ipc::type::String},
+							       OBS_content_readOffscreenDisplay));
+
+	cls->register_function(std::make_shared<ipc::function>("OBS_content_getDisplayFrameTiming", std::vector<ipc::type>{ipc::type::String},
+							       OBS_content_getDisplayFrameTiming));
+
 	cls->register_function(std::make_shared<ipc::function>(
 		"OBS_content_resizeDisplay", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32}, OBS_content_resizeDisplay));
 
@@ -243,6 +254,18 @@ void OBS_content::OBS_content_setDayTheme(void *data, const int64_t id, const st
 	AUTO_DEBUG;
 }
 
+static enum obs_video_rendering_mode GetRenderingMode(int32_t mode)
+{
+	switch (mode) {
+	case 1:
+		return OBS_STREAMING_VIDEO_RENDERING;
+	case 2:
+		return OBS_RECORDING_VIDEO_RENDERING;
+	default:
+		return OBS_MAIN_VIDEO_RENDERING;
+	}
+}
+
 void OBS_content::OBS_content_createDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	std::scoped_lock lock(displaysMutex);
@@ -259,18 +282,7 @@ void OBS_content::OBS_content_createDisplay(void *data, const int64_t id, const
 		return;
 	}
 
-	enum obs_video_rendering_mode mode = OBS_MAIN_VIDEO_RENDERING;
-	switch (args[2].value_union.i32) {
-	case 0:
-		mode = OBS_MAIN_VIDEO_RENDERING;
-		break;
-	case 1:
-		mode = OBS_STREAMING_VIDEO_RENDERING;
-		break;
-	case 2:
-		mode = OBS_RECORDING_VIDEO_RENDERING;
-		break;
-	}
+	enum obs_video_rendering_mode mode = GetRenderingMode(args[2].value_union.i32);
 
 	obs_video_info *canvas = osn::Video::Manager::GetInstance().find(args[4].value_union.ui64);
 	try {
@@ -378,6 +390,82 @@ void OBS_content::OBS_content_createSourcePreviewDisplay(void *data, const int64
 	AUTO_DEBUG;
 }
 
+void OBS_content::OBS_content_createOffscreenDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	auto found = displays.find(args[0].value_str);
+	if (found != displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Duplicate key provided to createOffscreenDisplay: " + args[0].value_str));
+		return;
+	}
+
+	enum obs_video_rendering_mode mode = GetRenderingMode(args[3].value_union.i32);
+	obs_video_info *canvas = osn::Video::Manager::GetInstance().find(args[4].value_union.ui64);
+	try {
+		OBS::Display *display = new OBS::Display(args[1].value_union.ui32, args[2].value_union.ui32, mode, canvas);
+		displays.insert_or_assign(args[0].value_str, display);
+	} catch (const std::exception &e) {
+		std::string message(std::string("Offscreen display creation failed: ") + e.what());
+		blog(LOG_ERROR, "%s", message.data());
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value(message));
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_readOffscreenDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	auto found = displays.find(args[0].value_str);
+	if (found == displays.end() || !found->second->IsOffscreen()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Invalid key provided to readOffscreenDisplay: " + args[0].value_str));
+		return;
+	}
+
+	OBS::Display *display = found->second;
+	std::vector<char> pixels;
+	if (!display->RenderOffscreen(pixels)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Failed to render offscreen display: " + args[0].value_str));
+		return;
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(display->GetSize().first));
+	rval.push_back(ipc::value(display->GetSize().second));
+	rval.push_back(ipc::value(display->GetFrameTiming().lastNs));
+	rval.push_back(ipc::value(pixels));
+	AUTO_DEBUG;
+}
+
+void OBS_content::OBS_content_getDisplayFrameTiming(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::scoped_lock lock(displaysMutex);
+
+	auto found = displays.find(args[0].value_str);
+	if (found == displays.end()) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Invalid key provided to getDisplayFrameTiming: " + args[0].value_str));
+		return;
+	}
+
+	OBS::Display::FrameTiming timing = found->second->GetFrameTiming();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(timing.frames));
+	rval.push_back(ipc::value(timing.lastNs));
+	rval.push_back(ipc::value(timing.frames ? timing.totalNs / timing.frames : 0));
+	rval.push_back(ipc::value(timing.maxNs));
+	AUTO_DEBUG;
+}
+
 void OBS_content::OBS_content_resizeDisplay(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	auto value = displays.find(args[0].value_str);
@@ -393,13 +481,15 @@ void OBS_content::OBS_content_resizeDisplay(void *data, const int64_t id, const
 	display->m_gsInitData.cy = args[2].value_union.ui32;
 
 	// Resize Display
-	obs_display_resize(display->m_display, display->m_gsInitData.cx, display->m_gsInitData.cy);
+	if (!display->IsOffscreen())
+		obs_display_resize(display->m_display, display->m_gsInitData.cx, display->m_gsInitData.cy);
 
 	// Store new size.
 	display->UpdatePreviewArea();
 
 #ifdef WIN32
-	display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
+	if (!display->IsOffscreen())
+		display->SetSize(display->m_gsInitData.cx, display->m_gsInitData.cy);
 #endif
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
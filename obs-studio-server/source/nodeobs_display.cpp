@@ -35,6 +35,8 @@ extern std::string currentScene; /* defined in OBS_content.cpp */
 
 static const uint32_t grayPaddingArea = 10ul;
 std::mutex OBS::Display::m_displayMtx;
+std::mutex OBS::Display::m_sharedRenderMtx;
+std::map<OBS::Display::SharedRenderKey, OBS::Display::SharedRender> OBS::Display::m_sharedRenders;
 bool OBS::Display::m_dayTheme = false;
 
 static void RecalculateApectRatioConstrainedSize(uint32_t origW, uint32_t origH, uint32_t sourceW, uint32_t sourceH, int32_t &outX, int32_t &outY,
@@ -272,154 +274,24 @@ OBS::Display::Display()
 
 		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
 
-		// Left solid outline
-		m_leftSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_leftSolidOutline->Resize(2);
-		v = m_leftSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_leftSolidOutline->At(1);
-		vec3_set(v.position, 0.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_leftSolidOutline->Update();
-
-		// Top solid outline
-		m_topSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_topSolidOutline->Resize(2);
-		v = m_topSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_topSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_topSolidOutline->Update();
-
-		// Right solid outline
-		m_rightSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_rightSolidOutline->Resize(2);
-		v = m_rightSolidOutline->At(0);
-		vec3_set(v.position, 1.0f, 0.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rightSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_rightSolidOutline->Update();
-
-		// Bottom solid outline
-		m_bottomSolidOutline = std::make_unique<GS::VertexBuffer>(2);
-		m_bottomSolidOutline->Resize(2);
-		v = m_bottomSolidOutline->At(0);
-		vec3_set(v.position, 0.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_bottomSolidOutline->At(1);
-		vec3_set(v.position, 1.0f, 1.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_bottomSolidOutline->Update();
-
-		// Crop effect outline
-		m_cropOutline = std::make_unique<GS::VertexBuffer>(4);
-		m_cropOutline->Resize(4);
-
-		m_boxLine = std::make_unique<GS::VertexBuffer>(6);
-		m_boxLine->Resize(6);
-		v = m_boxLine->At(0);
-		vec3_set(v.position, 0, 0, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(1);
-		vec3_set(v.position, 1, 0, 0);
-		vec4_set(v.uv[0], 1, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(2);
-		vec3_set(v.position, 1, 1, 0);
-		vec4_set(v.uv[0], 1, 1, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(3);
-		vec3_set(v.position, 0, 1, 0);
-		vec4_set(v.uv[0], 0, 1, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_boxLine->At(4);
-		vec3_set(v.position, 0, 0, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_boxLine->Update();
-
-		m_boxTris = std::make_unique<GS::VertexBuffer>(4);
+		m_boxTris = std::make_unique<GS::SolidVertexBuffer>(4);
 		m_boxTris->Resize(4);
 		v = m_boxTris->At(0);
 		vec3_set(v.position, 0, 0, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
 		*v.color = 0xFFFFFFFF;
 		v = m_boxTris->At(1);
 		vec3_set(v.position, 1, 0, 0);
-		vec4_set(v.uv[0], 1, 0, 0, 0);
 		*v.color = 0xFFFFFFFF;
 		v = m_boxTris->At(2);
 		vec3_set(v.position, 0, 1, 0);
-		vec4_set(v.uv[0], 0, 1, 0, 0);
 		*v.color = 0xFFFFFFFF;
 		v = m_boxTris->At(3);
 		vec3_set(v.position, 1, 1, 0);
-		vec4_set(v.uv[0], 1, 1, 0, 0);
 		*v.color = 0xFFFFFFFF;
 		m_boxTris->Update();
 
-		// Rotation handle line
-		m_rotHandleLine = std::make_unique<GS::VertexBuffer>(5);
-		m_rotHandleLine->Resize(5);
-		v = m_rotHandleLine->At(0);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(1);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, -2.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(2);
-		vec3_set(v.position, 0.5f + 0.34f / HANDLE_RADIUS, -2.0f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(3);
-		vec3_set(v.position, 0.5f + 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		v = m_rotHandleLine->At(4);
-		vec3_set(v.position, 0.5f - 0.34f / HANDLE_RADIUS, 0.5f, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-		m_rotHandleLine->Update();
-
-		// Rotation handle circle
-		m_rotHandleCircle = std::make_unique<GS::VertexBuffer>(120);
-		m_rotHandleCircle->Resize(120);
-		float angle = 180;
-		for (int i = 0; i < 40; ++i) {
-			v = m_rotHandleCircle->At(i * 3);
-			vec3_set(v.position, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
-			angle += 8.75f;
-			v = m_rotHandleCircle->At((i * 3) + 1);
-			vec3_set(v.position, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
-			v = m_rotHandleCircle->At((i * 3) + 2);
-			vec3_set(v.position, 0.5f, 1.0f, 0);
-			vec4_set(v.uv[0], 0, 0, 0, 0);
-			*v.color = 0xFFFFFFFF;
-		}
-		m_rotHandleCircle->Update();
-
 		// Text
-		m_textVertices = new GS::VertexBuffer(65535);
+		m_textVertices = new GS::VertexBuffer(65535, GS::ATTRIBUTE_POSITION | GS::ATTRIBUTE_COLOR | GS::ATTRIBUTE_UV);
 		m_textEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 		m_textTexture = gs_texture_create_from_file((g_moduleDirectory + "/resources/roboto.png").c_str());
 		if (!m_textTexture) {
@@ -439,12 +311,6 @@ OBS::Display::Display()
 
 	m_paddingColorVec4 = ConvertColorToVec4(m_paddingColor);
 	m_backgroundColorVec4 = ConvertColorToVec4(m_backgroundColor);
-	m_outlineColorVec4 = ConvertColorToVec4(m_outlineColor);
-	m_cropOutlineColorVec4 = ConvertColorToVec4(m_cropOutlineColor);
-	m_guidelineColorVec4 = ConvertColorToVec4(m_guidelineColor);
-	m_resizeOuterColorVec4 = ConvertColorToVec4(m_resizeOuterColor);
-	m_resizeInnerColorVec4 = ConvertColorToVec4(m_resizeInnerColor);
-	m_rotationHandleColorVec4 = ConvertColorToVec4(m_rotationHandleColor);
 }
 
 OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode, bool renderAtBottom, obs_video_info *canvas) : Display()
@@ -501,6 +367,17 @@ OBS::Display::Display(uint64_t windowHandle, enum obs_video_rendering_mode mode,
 {
 	m_source = obs_get_source_by_name(sourceName.c_str());
 	obs_source_inc_showing(m_source);
+	AttachSharedRender();
+}
+
+OBS::Display::Display(uint32_t width, uint32_t height, enum obs_video_rendering_mode mode, obs_video_info *canvas) : Display()
+{
+	m_gsInitData.cx = width;
+	m_gsInitData.cy = height;
+	m_renderingMode = mode;
+	m_canvas = canvas;
+
+	UpdatePreviewArea();
 }
 
 OBS::Display::~Display()
@@ -508,7 +385,9 @@ OBS::Display::~Display()
 	{
 		std::lock_guard lock(m_displayMtx);
 
-		obs_display_remove_draw_callback(m_display, DisplayCallback, this);
+		if (m_display)
+			obs_display_remove_draw_callback(m_display, DisplayCallback, this);
+		DetachSharedRender();
 
 		if (m_source) {
 			obs_source_dec_showing(m_source);
@@ -537,21 +416,25 @@ OBS::Display::~Display()
 			obs_leave_graphics();
 		}
 
-		m_leftSolidOutline.reset();
-		m_topSolidOutline.reset();
-		m_rightSolidOutline.reset();
-		m_bottomSolidOutline.reset();
-		m_cropOutline.reset();
-		m_boxLine = nullptr;
+		if (m_offscreenRender || m_offscreenStage) {
+			obs_enter_graphics();
+			gs_texrender_destroy(m_offscreenRender);
+			gs_stagesurface_destroy(m_offscreenStage);
+			obs_leave_graphics();
+		}
+
 		m_boxTris = nullptr;
-		m_rotHandleLine.reset();
-		m_rotHandleCircle.reset();
+		m_overlayLineBuffer.reset();
+		m_overlayTriBuffer.reset();
 
 		if (m_display)
 			obs_display_destroy(m_display);
 	}
 
 #ifdef _WIN32
+	if (!m_ourWindow)
+		return;
+
 	SystemWorkerThread::DestroyWindowMessageQuestion question;
 	SystemWorkerThread::DestroyWindowMessageAnswer answer;
 
@@ -572,6 +455,59 @@ OBS::Display::~Display()
 #endif
 }
 
+bool OBS::Display::IsOffscreen()
+{
+	return m_display == nullptr;
+}
+
+bool OBS::Display::RenderOffscreen(std::vector<char> &pixels)
+{
+	uint32_t width = m_gsInitData.cx;
+	uint32_t height = m_gsInitData.cy;
+	if (!IsOffscreen() || width == 0 || height == 0)
+		return false;
+
+	ScopedGraphicsContext scopedGraphicsContext;
+
+	if (!m_offscreenRender)
+		m_offscreenRender = gs_texrender_create(m_gsInitData.format, GS_ZS_NONE);
+
+	if (m_offscreenStage && (gs_stagesurface_get_width(m_offscreenStage) != width || gs_stagesurface_get_height(m_offscreenStage) != height)) {
+		gs_stagesurface_destroy(m_offscreenStage);
+		m_offscreenStage = nullptr;
+	}
+	if (!m_offscreenStage)
+		m_offscreenStage = gs_stagesurface_create(width, height, m_gsInitData.format);
+
+	gs_texrender_reset(m_offscreenRender);
+	if (!gs_texrender_begin(m_offscreenRender, width, height))
+		return false;
+
+	DisplayCallback(this, width, height);
+	gs_texrender_end(m_offscreenRender);
+
+	gs_stage_texture(m_offscreenStage, gs_texrender_get_texture(m_offscreenRender));
+
+	uint8_t *data = nullptr;
+	uint32_t linesize = 0;
+	if (!gs_stagesurface_map(m_offscreenStage, &data, &linesize))
+		return false;
+
+	size_t rowSize = size_t(width) * 4;
+	pixels.resize(rowSize * height);
+	for (uint32_t y = 0; y < height; y++)
+		memcpy(pixels.data() + rowSize * y, data + size_t(linesize) * y, rowSize);
+
+	gs_stagesurface_unmap(m_offscreenStage);
+	return true;
+}
+
+OBS::Display::FrameTiming OBS::Display::GetFrameTiming()
+{
+	std::lock_guard lock(m_frameTimingMtx);
+	return m_frameTiming;
+}
+
 void OBS::Display::SetPosition(uint32_t x, uint32_t y)
 {
 #if defined(_WIN32)
@@ -721,9 +657,14 @@ bool OBS::Display::GetDrawUI()
 	return m_shouldDrawUI;
 }
 
-static void PrepareColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint32_t *color, vec4 *colorVec4)
+static void PrepareColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint32_t *color)
 {
 	*color = a << 24 | b << 16 | g << 8 | r;
+}
+
+static void PrepareColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint32_t *color, vec4 *colorVec4)
+{
+	PrepareColor(r, g, b, a, color);
 	vec4_set(colorVec4, static_cast<float>(r) / 255.0f, static_cast<float>(g) / 255.0f, static_cast<float>(b) / 255.0f, static_cast<float>(a) / 255.0f);
 }
 
@@ -745,32 +686,32 @@ void OBS::Display::SetBackgroundColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a
 
 void OBS::Display::SetOutlineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_outlineColor, &m_outlineColorVec4);
+	PrepareColor(r, g, b, a, &m_outlineColor);
 }
 
 void OBS::Display::SetCropOutlineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_cropOutlineColor, &m_cropOutlineColorVec4);
+	PrepareColor(r, g, b, a, &m_cropOutlineColor);
 }
 
 void OBS::Display::SetGuidelineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_guidelineColor, &m_guidelineColorVec4);
+	PrepareColor(r, g, b, a, &m_guidelineColor);
 }
 
 void OBS::Display::SetResizeBoxOuterColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_resizeOuterColor, &m_resizeOuterColorVec4);
+	PrepareColor(r, g, b, a, &m_resizeOuterColor);
 }
 
 void OBS::Display::SetResizeBoxInnerColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_resizeInnerColor, &m_resizeInnerColorVec4);
+	PrepareColor(r, g, b, a, &m_resizeInnerColor);
 }
 
 void OBS::Display::SetRotationHandleColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
-	PrepareColor(r, g, b, a, &m_rotationHandleColor, &m_rotationHandleColorVec4);
+	PrepareColor(r, g, b, a, &m_rotationHandleColor);
 }
 
 static void DrawGlyph(GS::VertexBuffer *vb, float_t x, float_t y, float_t scale, float_t depth, char glyph, uint32_t color)
@@ -872,7 +813,32 @@ inline bool CloseFloat(float a, float b, float epsilon = 0.01)
 	return abs(a - b) <= epsilon;
 }
 
-void OBS::Display::DrawCropOutline(float x1, float y1, float x2, float y2, vec2 scale)
+static inline vec3 TransformPoint(const matrix4 &mtx, float x, float y)
+{
+	vec3 pos;
+	vec3_set(&pos, x, y, 0.0f);
+	vec3_transform(&pos, &pos, &mtx);
+	return pos;
+}
+
+void OBS::Display::PushLine(const vec3 &a, const vec3 &b, uint32_t color)
+{
+	m_overlayLines.push_back({a, color});
+	m_overlayLines.push_back({b, color});
+}
+
+void OBS::Display::PushQuad(const vec3 &a, const vec3 &b, const vec3 &c, const vec3 &d, uint32_t color)
+{
+	// Same triangles a GS_TRISTRIP of a, b, c, d would produce
+	m_overlayTris.push_back({a, color});
+	m_overlayTris.push_back({b, color});
+	m_overlayTris.push_back({c, color});
+	m_overlayTris.push_back({c, color});
+	m_overlayTris.push_back({b, color});
+	m_overlayTris.push_back({d, color});
+}
+
+void OBS::Display::BatchCropOutline(float x1, float y1, float x2, float y2, const vec2 &scale, const matrix4 &mtx)
 {
 	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
 
@@ -903,410 +869,298 @@ void OBS::Display::DrawCropOutline(float x1, float y1, float x2, float y2, vec2
 			dy = std::max(yy1 + 7.5f * offY, y2);
 		}
 
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-		v = m_cropOutline->At(0);
-		vec3_set(v.position, xx1, yy1, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(1);
-		vec3_set(v.position, xx1 + (xSide * (5 / scale.x)), yy1 + (ySide * (5 / scale.y)), 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(2);
-		vec3_set(v.position, dx, dy, 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		v = m_cropOutline->At(3);
-		vec3_set(v.position, dx + (xSide * (5 / scale.x)), dy + (ySide * (5 / scale.y)), 0);
-		vec4_set(v.uv[0], 0, 0, 0, 0);
-		*v.color = 0xFFFFFFFF;
-
-		gs_load_vertexbuffer(m_cropOutline->Update());
-		gs_draw(GS_TRISTRIP, 0, 0);
+		PushQuad(TransformPoint(mtx, xx1, yy1), TransformPoint(mtx, xx1 + (xSide * (5 / scale.x)), yy1 + (ySide * (5 / scale.y))),
+			 TransformPoint(mtx, dx, dy), TransformPoint(mtx, dx + (xSide * (5 / scale.x)), dy + (ySide * (5 / scale.y))), m_cropOutlineColor);
 	}
 }
 
-static void DrawSolidOutline(GS::VertexBuffer *vertexBuffer)
+void OBS::Display::BatchOutline(const SelectedItem &item, const vec2 &boxScale)
 {
-	gs_load_vertexbuffer(vertexBuffer->Update(false));
-	gs_draw(GS_LINES, 0, 0);
-}
-
-inline void DrawBoxAt(OBS::Display *dp, float_t x, float_t y, matrix4 &mtx)
-{
-	gs_matrix_push();
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
-
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
-
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(HANDLE_DIAMETER * dp->m_previewToWorldScale.x, HANDLE_DIAMETER * dp->m_previewToWorldScale.y, 1.0f);
+	const matrix4 &mtx = item.boxTransform;
+	const struct {
+		float x1, y1, x2, y2;
+		int cropped;
+	} edges[] = {
+		{0.0f, 0.0f, 0.0f, 1.0f, item.crop.left},
+		{0.0f, 0.0f, 1.0f, 0.0f, item.crop.top},
+		{1.0f, 0.0f, 1.0f, 1.0f, item.crop.right},
+		{0.0f, 1.0f, 1.0f, 1.0f, item.crop.bottom},
+	};
 
-	gs_draw(GS_LINESTRIP, 0, 0);
-	gs_matrix_pop();
+	for (auto &edge : edges) {
+		if (edge.cropped)
+			BatchCropOutline(edge.x1, edge.y1, edge.x2, edge.y2, boxScale, mtx);
+		else
+			PushLine(TransformPoint(mtx, edge.x1, edge.y1), TransformPoint(mtx, edge.x2, edge.y2), m_outlineColor);
+	}
 }
 
-inline void DrawSquareAt(OBS::Display *dp, float_t x, float_t y, matrix4 &mtx)
+void OBS::Display::BatchHandleBox(float x, float y, const matrix4 &mtx)
 {
-	gs_matrix_push();
+	vec3 pos = TransformPoint(mtx, x, y);
+	pos.x -= HANDLE_RADIUS * m_previewToWorldScale.x;
+	pos.y -= HANDLE_RADIUS * m_previewToWorldScale.y;
 
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
+	float cx = HANDLE_DIAMETER * m_previewToWorldScale.x;
+	float cy = HANDLE_DIAMETER * m_previewToWorldScale.y;
 
-	vec3 offset = {-HANDLE_RADIUS, -HANDLE_RADIUS, 0.0f};
-	offset.x *= dp->m_previewToWorldScale.x;
-	offset.y *= dp->m_previewToWorldScale.y;
+	vec3 tl = pos, tr = pos, bl = pos, br = pos;
+	tr.x += cx;
+	bl.y += cy;
+	br.x += cx;
+	br.y += cy;
 
-	gs_matrix_translate(&pos);
-	gs_matrix_translate(&offset);
-	gs_matrix_scale3f(HANDLE_DIAMETER * dp->m_previewToWorldScale.x, HANDLE_DIAMETER * dp->m_previewToWorldScale.y, 1.0f);
+	PushQuad(tl, tr, bl, br, m_resizeInnerColor);
 
-	gs_draw(GS_TRISTRIP, 0, 0);
-	gs_matrix_pop();
+	PushLine(tl, tr, m_resizeOuterColor);
+	PushLine(tr, br, m_resizeOuterColor);
+	PushLine(br, bl, m_resizeOuterColor);
+	PushLine(bl, tl, m_resizeOuterColor);
 }
 
-inline void DrawGuideline(OBS::Display *dp, bool rot45, float_t x, float_t y, matrix4 &mtx)
+void OBS::Display::BatchGuideline(bool rot45, float x, float y, const matrix4 &mtx, float width, float height)
 {
-	gs_rect rect;
-	rect.x = dp->GetPreviewOffset().first;
-	rect.y = dp->GetPreviewOffset().second;
-	rect.cx = dp->GetPreviewSize().first;
-	rect.cy = dp->GetPreviewSize().second;
-
-	gs_set_scissor_rect(&rect);
-	gs_matrix_push();
-
-	vec3 center = {0.5, 0.5, 0.0f};
-	vec3_transform(&center, &center, &mtx);
-
-	vec3 pos = {x, y, 0.0f};
-	vec3_transform(&pos, &pos, &mtx);
+	vec3 center = TransformPoint(mtx, 0.5f, 0.5f);
+	vec3 pos = TransformPoint(mtx, x, y);
 
 	vec3 normal;
 	vec3_sub(&normal, &center, &pos);
 	vec3_norm(&normal, &normal);
 
-	gs_matrix_translate(&pos);
-
-	vec3 up, dn, lt, rt;
+	vec3 up, dn, rt;
 
 	if (rot45) {
 		up = {-0.2, 1.0, 0};
 		dn = {0.2, -1.0, 0};
-		lt = {-1.0, -0.2, 0};
 		rt = {1.0, 0.2, 0};
 	} else {
 		up = {0, 1.0, 0};
 		dn = {0, -1.0, 0};
-		lt = {-1.0, 0, 0};
 		rt = {1.0, 0, 0};
 	}
 
+	// The guideline runs from the edge away from the item center
+	float dirX = 1.0f, dirY = 0.0f;
 	if (vec3_dot(&up, &normal) > 0.707f) {
-		// Dominantly looking up.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(-90.0f));
+		dirX = 0.0f;
+		dirY = -1.0f;
 	} else if (vec3_dot(&dn, &normal) > 0.707f) {
-		// Dominantly looking down.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(90.0f));
-	} else if (vec3_dot(&lt, &normal) > 0.707f) {
-		// Dominantly looking left.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(0.0f));
+		dirX = 0.0f;
+		dirY = 1.0f;
 	} else if (vec3_dot(&rt, &normal) > 0.707f) {
-		// Dominantly looking right.
-		gs_matrix_rotaa4f(0, 0, 1, RAD(180.0f));
+		dirX = -1.0f;
 	}
 
-	gs_matrix_scale3f(65535, 65535, 65535);
-
-	gs_draw(GS_LINES, 0, 2);
-
-	gs_matrix_pop();
-	gs_set_scissor_rect(nullptr);
-}
-
-void OBS::Display::DrawRotationHandle(float rot, matrix4 &mtx)
-{
-	struct vec3 pos;
-	vec3_set(&pos, 0.5f, 0.0f, 0.0f);
-	vec3_transform(&pos, &pos, &mtx);
-
-	gs_load_vertexbuffer(m_rotHandleLine->Update(false));
-
-	gs_matrix_push();
-	gs_matrix_identity();
-	gs_matrix_translate(&pos);
-
-	gs_matrix_rotaa4f(0.0f, 0.0f, 1.0f, RAD(rot));
-	gs_matrix_translate3f(-HANDLE_RADIUS * 1.5, -HANDLE_RADIUS * 1.5, 0.0f);
-	gs_matrix_scale3f(HANDLE_RADIUS * 3, HANDLE_RADIUS * 3, 1.0f);
-
-	gs_draw(GS_TRISTRIP, 0, 0);
-
-	gs_matrix_translate3f(0.0f, -HANDLE_RADIUS * 0.6, 0.0f);
+	// Clip to the preview area, it used to be a scissor rect around each line
+	vec3 end = pos;
+	end.x += dirX * 65535.0f;
+	end.y += dirY * 65535.0f;
+	if (std::min(pos.x, end.x) > width || std::max(pos.x, end.x) < 0 || std::min(pos.y, end.y) > height || std::max(pos.y, end.y) < 0)
+		return;
 
-	gs_load_vertexbuffer(m_rotHandleCircle->Update(false));
-	gs_draw(GS_TRISTRIP, 0, 0);
+	pos.x = std::clamp(pos.x, 0.0f, width);
+	pos.y = std::clamp(pos.y, 0.0f, height);
+	end.x = std::clamp(end.x, 0.0f, width);
+	end.y = std::clamp(end.y, 0.0f, height);
 
-	gs_matrix_pop();
+	PushLine(pos, end, m_guidelineColor);
 }
 
-void OBS::Display::DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale, gs_eparam_t *color)
+void OBS::Display::BatchRotationHandle(float rot, const matrix4 &mtx)
 {
-	gs_matrix_push();
-	gs_matrix_mul(&mtx);
-
-	if (crop.left) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 0.0f, 0.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_leftSolidOutline.get());
-	}
-	if (crop.top) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 0.0f, 1.0f, 0.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_topSolidOutline.get());
-	}
-	if (crop.right) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(1.0f, 0.0f, 1.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_rightSolidOutline.get());
+	vec3 pos = TransformPoint(mtx, 0.5f, 0.0f);
+
+	matrix4 handle;
+	matrix4_identity(&handle);
+	matrix4_scale3f(&handle, &handle, HANDLE_RADIUS * 3, HANDLE_RADIUS * 3, 1.0f);
+	matrix4_translate3f(&handle, &handle, -HANDLE_RADIUS * 1.5f, -HANDLE_RADIUS * 1.5f, 0.0f);
+	matrix4_rotate_aa4f(&handle, &handle, 0.0f, 0.0f, 1.0f, RAD(rot));
+	matrix4_translate3f(&handle, &handle, pos.x, pos.y, 0.0f);
+
+	// Line
+	float left = 0.5f - 0.34f / HANDLE_RADIUS;
+	float right = 0.5f + 0.34f / HANDLE_RADIUS;
+	PushQuad(TransformPoint(handle, left, 0.5f), TransformPoint(handle, left, -2.0f), TransformPoint(handle, right, 0.5f),
+		 TransformPoint(handle, right, -2.0f), m_rotationHandleColor);
+
+	// Circle, sitting on top of the line
+	matrix4 circle;
+	matrix4_identity(&circle);
+	matrix4_translate3f(&circle, &circle, 0.0f, -HANDLE_RADIUS * 0.6f, 0.0f);
+	matrix4_mul(&circle, &circle, &handle);
+
+	// Same vertices the circle used to be drawn from as a GS_TRISTRIP, unrolled into triangles so it keeps its look
+	vec3 strip[120];
+	float angle = 180;
+	for (int i = 0; i < 40; ++i) {
+		strip[i * 3] = TransformPoint(circle, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
+		angle += 8.75f;
+		strip[(i * 3) + 1] = TransformPoint(circle, sin(RAD(angle)) / 2 + 0.5f, cos(RAD(angle)) / 2 + 0.5f);
+		strip[(i * 3) + 2] = TransformPoint(circle, 0.5f, 1.0f);
 	}
-	if (crop.bottom) {
-		gs_effect_set_vec4(color, &m_cropOutlineColorVec4);
-		DrawCropOutline(0.0f, 1.0f, 1.0f, 1.0f, boxScale);
-	} else {
-		gs_effect_set_vec4(color, &m_outlineColorVec4);
-		DrawSolidOutline(m_bottomSolidOutline.get());
+	for (int i = 0; i + 2 < 120; ++i) {
+		m_overlayTris.push_back({strip[i], m_rotationHandleColor});
+		m_overlayTris.push_back({strip[i + 1], m_rotationHandleColor});
+		m_overlayTris.push_back({strip[i + 2], m_rotationHandleColor});
 	}
-
-	gs_matrix_pop();
 }
 
-bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+void OBS::Display::BatchDistanceText(const SelectedItem &item, bool rot45)
 {
-	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
-	if (obs_sceneitem_locked(item))
-		return true;
+	// TEXT RENDERING
+	// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
+	// DO SO WHENEVER...
+	const matrix4 &itemMatrix = item.boxTransform;
 
-	OBS::Display *dp = reinterpret_cast<OBS::Display *>(param);
+	// Retrieve actual corner and edge positions.
+	vec3 edge[4], center;
+	{
+		edge[0] = TransformPoint(itemMatrix, 0, 0.5);
+		edge[1] = TransformPoint(itemMatrix, 0.5, 0);
+		edge[2] = TransformPoint(itemMatrix, 1, 0.5);
+		edge[3] = TransformPoint(itemMatrix, 0.5, 1);
+		center = TransformPoint(itemMatrix, 0.5, 0.5);
+	}
 
-	if (dp->m_canvas != obs_sceneitem_get_canvas(item))
-		return true;
+	uint32_t sceneWidth = item.sceneWidth;
+	uint32_t sceneHeight = item.sceneHeight;
 
-	obs_source_t *itemSource = obs_sceneitem_get_source(item);
-	uint32_t flags = obs_source_get_output_flags(itemSource);
-	bool isOnlyAudio = (flags & OBS_SOURCE_VIDEO) == 0;
-
-	obs_source_t *sceneSource = obs_scene_get_source(scene);
+	std::vector<char> buf(8);
+	float_t pt = 8 * m_previewToWorldScale.y;
+	for (size_t n = 0; n < 4; n++) {
+		bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
 
-	uint32_t sceneWidth = obs_source_get_width(sceneSource);
-	uint32_t sceneHeight = obs_source_get_height(sceneSource);
-	uint32_t itemWidth = obs_source_get_width(itemSource);
-	uint32_t itemHeight = obs_source_get_height(itemSource);
+		if (!isIn)
+			continue;
 
-	if (!obs_sceneitem_selected(item) || isOnlyAudio || ((itemWidth <= 0) && (itemHeight <= 0)))
-		return true;
+		vec3 alignLeft, alignTop;
 
-	matrix4 boxTransform;
-	matrix4 invBoxTransform;
-	obs_sceneitem_get_box_transform(item, &boxTransform);
-	matrix4_inv(&invBoxTransform, &boxTransform);
+		if (rot45) {
+			alignLeft = {-1, -0.2, 0};
+			alignTop = {0.2, -1, 0};
+		} else {
+			alignLeft = {-1, 0, 0};
+			alignTop = {0, -1, 0};
+		}
 
-	{
-		vec3 bounds[] = {
-			{{{0.f, 0.f, 0.f}}},
-			{{{1.f, 0.f, 0.f}}},
-			{{{0.f, 1.f, 0.f}}},
-			{{{1.f, 1.f, 0.f}}},
-		};
-		bool visible = std::all_of(std::begin(bounds), std::end(bounds), [&](const vec3 &b) {
-			vec3 pos;
-			vec3_transform(&pos, &b, &boxTransform);
-			vec3_transform(&pos, &pos, &invBoxTransform);
-			return CloseFloat(pos.x, b.x) && CloseFloat(pos.y, b.y);
-		});
-
-		if (!visible)
-			return true;
+		vec3 temp;
+		vec3_sub(&temp, &edge[n], &center);
+		vec3_norm(&temp, &temp);
+		float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
+		if (left > 0.707f) { // LEFT
+			float_t dist = edge[n].x;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
+
+				for (size_t p = 0; p < len; p++) {
+					char v = buf.data()[p];
+					DrawGlyph(m_textVertices, (edge[n].x / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v, m_guidelineColor);
+				}
+			}
+		} else if (left < -0.707f) { // RIGHT
+			float_t dist = sceneWidth - edge[n].x;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
+
+				for (size_t p = 0; p < len; p++) {
+					char v = buf.data()[p];
+					DrawGlyph(m_textVertices, edge[n].x + (dist / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v, m_guidelineColor);
+				}
+			}
+		} else if (top > 0.707f) { // UP
+			float_t dist = edge[n].y;
+			if (dist > pt) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
+
+				for (size_t p = 0; p < len; p++) {
+					char v = buf.data()[p];
+					DrawGlyph(m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y - (dist / 2) - pt, pt, 0, v, m_guidelineColor);
+				}
+			}
+		} else if (top < -0.707f) { // DOWN
+			float_t dist = sceneHeight - edge[n].y;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
+
+				for (size_t p = 0; p < len; p++) {
+					char v = buf.data()[p];
+					DrawGlyph(m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y + (dist / 2) - pt, pt, 0, v, m_guidelineColor);
+				}
+			}
+		}
 	}
+}
 
-	vec4 color;
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *solid_color = gs_effect_get_param_by_name(solid, "color");
-
-	float rot = obs_sceneitem_get_rot(item);
-	bool rot45 = (rot == 45.0f || rot == 135.0f || rot == 225.0f || rot == 315.0f);
-
-	// Prepare data for outline
-	matrix4 curTransform;
-	gs_matrix_get(&curTransform);
-
-	vec2 boxScale;
-	obs_sceneitem_get_box_scale(item, &boxScale);
+void OBS::Display::BatchSelectedItem(const SelectedItem &item, const matrix4 &curTransform, float width, float height)
+{
+	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
+	const matrix4 &boxTransform = item.boxTransform;
+	bool rot45 = (item.rot == 45.0f || item.rot == 135.0f || item.rot == 225.0f || item.rot == 315.0f);
 
+	vec2 boxScale = item.boxScale;
 	boxScale.x *= curTransform.x.x;
 	boxScale.y *= curTransform.y.y;
 
-	obs_sceneitem_crop crop;
-	obs_sceneitem_get_crop(item, &crop);
+	BatchOutline(item, boxScale);
 
-	dp->DrawOutline(boxTransform, crop, boxScale, solid_color);
+	if (m_drawGuideLines) {
+		BatchGuideline(rot45, 0.5, 0, boxTransform, width, height);
+		BatchGuideline(rot45, 0.5, 1, boxTransform, width, height);
+		BatchGuideline(rot45, 0, 0.5, boxTransform, width, height);
+		BatchGuideline(rot45, 1, 0.5, boxTransform, width, height);
 
-	if (dp->m_drawGuideLines) {
-		gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-		gs_effect_set_vec4(solid_color, &dp->m_guidelineColorVec4);
-		DrawGuideline(dp, rot45, 0.5, 0, boxTransform);
-		DrawGuideline(dp, rot45, 0.5, 1, boxTransform);
-		DrawGuideline(dp, rot45, 0, 0.5, boxTransform);
-		DrawGuideline(dp, rot45, 1, 0.5, boxTransform);
-
-		// TEXT RENDERING
-		// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
-		// DO SO WHENEVER...
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-
-		matrix4 itemMatrix, sceneToView;
-		obs_sceneitem_get_box_transform(item, &itemMatrix);
-		matrix4_identity(&sceneToView);
-		sceneToView.x.x = dp->m_worldToPreviewScale.x;
-		sceneToView.y.y = dp->m_worldToPreviewScale.y;
-
-		// Retrieve actual corner and edge positions.
-		vec3 edge[4], center;
-		{
-			vec3_set(&edge[0], 0, 0.5, 0);
-			vec3_transform(&edge[0], &edge[0], &itemMatrix);
-			vec3_set(&edge[1], 0.5, 0, 0);
-			vec3_transform(&edge[1], &edge[1], &itemMatrix);
-			vec3_set(&edge[2], 1, 0.5, 0);
-			vec3_transform(&edge[2], &edge[2], &itemMatrix);
-			vec3_set(&edge[3], 0.5, 1, 0);
-			vec3_transform(&edge[3], &edge[3], &itemMatrix);
-
-			vec3_set(&center, 0.5, 0.5, 0);
-			vec3_transform(&center, &center, &itemMatrix);
-			;
-		}
-
-		std::vector<char> buf(8);
-		float_t pt = 8 * dp->m_previewToWorldScale.y;
-		for (size_t n = 0; n < 4; n++) {
-			bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
+		BatchDistanceText(item, rot45);
+	}
 
-			if (!isIn)
-				continue;
+	if (m_drawRotationHandle)
+		BatchRotationHandle(item.rot, boxTransform);
+
+	BatchHandleBox(0, 0, boxTransform);
+	BatchHandleBox(1, 0, boxTransform);
+	BatchHandleBox(0, 1, boxTransform);
+	BatchHandleBox(1, 1, boxTransform);
+	BatchHandleBox(0.5, 0, boxTransform);
+	BatchHandleBox(0.5, 1, boxTransform);
+	BatchHandleBox(0, 0.5, boxTransform);
+	BatchHandleBox(1, 0.5, boxTransform);
+}
 
-			vec3 alignLeft, alignTop;
+void OBS::Display::DrawOverlayBatch(std::vector<OverlayVertex> &vertices, std::unique_ptr<GS::VertexBuffer> &buffer, gs_draw_mode mode)
+{
+	if (vertices.empty())
+		return;
 
-			if (rot45) {
-				alignLeft = {-1, -0.2, 0};
-				alignTop = {0.2, -1, 0};
-			} else {
-				alignLeft = {-1, 0, 0};
-				alignTop = {0, -1, 0};
-			}
+	// Batches larger than one vertex buffer are drawn in chunks that never split a line or a triangle
+	const uint32_t chunk = GS::MAXIMUM_VERTICES - (GS::MAXIMUM_VERTICES % 6);
+	uint32_t count = uint32_t(std::min<size_t>(vertices.size(), chunk));
+	if (!buffer || buffer->Capacity() < count) {
+		uint32_t capacity = buffer ? buffer->Capacity() : 1024;
+		while (capacity < count)
+			capacity *= 2;
+		buffer = std::make_unique<GS::SolidVertexBuffer>(std::min(capacity, GS::MAXIMUM_VERTICES));
+	}
 
-			vec3 temp;
-			vec3_sub(&temp, &edge[n], &center);
-			vec3_norm(&temp, &temp);
-			float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
-			if (left > 0.707f) { // LEFT
-				float_t dist = edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, (edge[n].x / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (left < -0.707f) { // RIGHT
-				float_t dist = sceneWidth - edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (dist / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (top > 0.707f) { // UP
-				float_t dist = edge[n].y;
-				if (dist > pt) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y - (dist / 2) - pt, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (top < -0.707f) { // DOWN
-				float_t dist = sceneHeight - edge[n].y;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y + (dist / 2) - pt, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			}
+	gs_load_indexbuffer(nullptr);
+	for (size_t offset = 0; offset < vertices.size(); offset += count) {
+		uint32_t size = uint32_t(std::min<size_t>(vertices.size() - offset, count));
+		buffer->Resize(size);
+		vec3 *positions = buffer->GetPositions();
+		uint32_t *colors = buffer->GetColors();
+		for (uint32_t i = 0; i < size; i++) {
+			positions[i] = vertices[offset + i].position;
+			colors[i] = vertices[offset + i].color;
 		}
-	}
 
-	if (dp->m_drawRotationHandle) {
-		gs_effect_set_vec4(solid_color, &dp->m_rotationHandleColorVec4);
-		dp->DrawRotationHandle(rot, boxTransform);
+		gs_load_vertexbuffer(buffer->Update());
+		gs_draw(mode, 0, size);
 	}
-
-	gs_load_vertexbuffer(dp->m_boxTris->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeInnerColorVec4);
-	DrawSquareAt(dp, 0, 0, boxTransform);
-	DrawSquareAt(dp, 1, 0, boxTransform);
-	DrawSquareAt(dp, 0, 1, boxTransform);
-	DrawSquareAt(dp, 1, 1, boxTransform);
-	DrawSquareAt(dp, 0.5, 0, boxTransform);
-	DrawSquareAt(dp, 0.5, 1, boxTransform);
-	DrawSquareAt(dp, 0, 0.5, boxTransform);
-	DrawSquareAt(dp, 1, 0.5, boxTransform);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeOuterColorVec4);
-	DrawBoxAt(dp, 0, 0, boxTransform);
-	DrawBoxAt(dp, 1, 0, boxTransform);
-	DrawBoxAt(dp, 0, 1, boxTransform);
-	DrawBoxAt(dp, 1, 1, boxTransform);
-	DrawBoxAt(dp, 0.5, 0, boxTransform);
-	DrawBoxAt(dp, 0.5, 1, boxTransform);
-	DrawBoxAt(dp, 0, 0.5, boxTransform);
-	DrawBoxAt(dp, 1, 0.5, boxTransform);
-
-	return true;
 }
 
-bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+bool OBS::Display::CollectSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
 {
 	if (obs_sceneitem_locked(item))
 		return true;
@@ -1322,18 +1176,16 @@ bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *ite
 
 	obs_source_t *sceneSource = obs_scene_get_source(scene);
 
-	uint32_t sceneWidth = obs_source_get_width(sceneSource);
-	uint32_t sceneHeight = obs_source_get_height(sceneSource);
 	uint32_t itemWidth = obs_source_get_width(itemSource);
 	uint32_t itemHeight = obs_source_get_height(itemSource);
 
 	if (!obs_sceneitem_selected(item) || isOnlyAudio || ((itemWidth <= 0) && (itemHeight <= 0)))
 		return true;
 
-	matrix4 boxTransform;
+	SelectedItem selected;
 	matrix4 invBoxTransform;
-	obs_sceneitem_get_box_transform(item, &boxTransform);
-	matrix4_inv(&invBoxTransform, &boxTransform);
+	obs_sceneitem_get_box_transform(item, &selected.boxTransform);
+	matrix4_inv(&invBoxTransform, &selected.boxTransform);
 
 	vec3 bounds[] = {
 		{{{0.f, 0.f, 0.f}}},
@@ -1344,7 +1196,7 @@ bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *ite
 
 	bool visible = std::all_of(std::begin(bounds), std::end(bounds), [&](const vec3 &b) {
 		vec3 pos;
-		vec3_transform(&pos, &b, &boxTransform);
+		vec3_transform(&pos, &b, &selected.boxTransform);
 		vec3_transform(&pos, &pos, &invBoxTransform);
 		return CloseFloat(pos.x, b.x) && CloseFloat(pos.y, b.y);
 	});
@@ -1352,36 +1204,44 @@ bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *ite
 	if (!visible)
 		return true;
 
+	obs_sceneitem_get_box_scale(item, &selected.boxScale);
+	obs_sceneitem_get_crop(item, &selected.crop);
+	selected.rot = obs_sceneitem_get_rot(item);
+	selected.sceneWidth = obs_source_get_width(sceneSource);
+	selected.sceneHeight = obs_source_get_height(sceneSource);
+
+	dp->m_selectedItems.push_back(selected);
+	return true;
+}
+
+void OBS::Display::DrawSelectedOverflow(const SelectedItem &item)
+{
 	gs_effect_t *repeat = obs_get_base_effect(OBS_EFFECT_REPEAT);
 	gs_eparam_t *image = gs_effect_get_param_by_name(repeat, "image");
 	gs_eparam_t *scale = gs_effect_get_param_by_name(repeat, "scale");
 
 	vec2 s;
-	vec2_set(&s, boxTransform.x.x / 96, boxTransform.y.y / 96);
+	vec2_set(&s, item.boxTransform.x.x / 96, item.boxTransform.y.y / 96);
 
 	gs_effect_set_vec2(scale, &s);
 
-	gs_texture_t *texture = (dp->m_dayTheme) ? dp->m_overflowDayTexture : dp->m_overflowNightTexture;
+	gs_texture_t *texture = (m_dayTheme) ? m_overflowDayTexture : m_overflowNightTexture;
 	gs_effect_set_texture(image, texture);
 
 	gs_matrix_push();
-	gs_matrix_mul(&boxTransform);
-
-	obs_sceneitem_crop crop;
-	obs_sceneitem_get_crop(item, &crop);
+	gs_matrix_mul(&item.boxTransform);
 
 	while (gs_effect_loop(repeat, "Draw")) {
 		gs_draw_sprite(texture, 0, 1, 1);
 	}
 
 	gs_matrix_pop();
-
-	return true;
 }
 
 void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 {
 	Display *dp = static_cast<Display *>(displayPtr);
+	uint64_t frameStart = os_gettime_ns();
 	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
 	gs_eparam_t *solid_color = gs_effect_get_param_by_name(solid, "color");
 	gs_technique_t *solid_tech = gs_effect_get_technique(solid, "Solid");
@@ -1427,19 +1287,23 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 
 	//------------------------------------------------------------------------------
 
+	// Walk the scene once, both the overflow and the overlay passes draw from this
+	dp->m_selectedItems.clear();
+	if (scene && dp->m_shouldDrawUI)
+		obs_scene_enum_items(scene, CollectSelectedItem, dp);
+
 	// Overflow effect
-	if (scene && dp->m_shouldDrawUI) {
+	if (!dp->m_selectedItems.empty()) {
 
-		uint32_t width, height;
-		obs_display_size(dp->m_display, &width, &height);
-		float right = float(width) - dp->m_previewOffset.first;
-		float bottom = float(height) - dp->m_previewOffset.second;
+		float right = float(cx) - dp->m_previewOffset.first;
+		float bottom = float(cy) - dp->m_previewOffset.second;
 
 		gs_ortho(-float(dp->m_previewOffset.first), right, -float(dp->m_previewOffset.second), bottom, -100.0f, 100.0f);
 
 		gs_matrix_push();
 		gs_matrix_scale3f(dp->m_worldToPreviewScale.x, dp->m_worldToPreviewScale.y, 1.0f);
-		obs_scene_enum_items(scene, DrawSelectedOverflow, dp);
+		for (auto &item : dp->m_selectedItems)
+			dp->DrawSelectedOverflow(item);
 		gs_matrix_pop();
 	}
 
@@ -1472,17 +1336,7 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 	//------------------------------------------------------------------------------
 
 	// Source Rendering
-	if (dp->m_source) {
-		/* If the source is a transition it means this display 
-		 * is for Studio Mode and that the scene it contains is a 
-		 * duplicate of the current scene, apply selective recording
-		 * layer rendering if it is enabled */
-		if (obs_get_multiple_rendering() && obs_source_get_type(dp->m_source) == OBS_SOURCE_TYPE_TRANSITION)
-			obs_set_video_rendering_mode(dp->m_renderingMode);
-		obs_source_video_render(dp->m_source);
-	} else {
-		obs_render_texture(dp->m_canvas, dp->m_renderingMode);
-	}
+	dp->RenderSharedContent(sourceW, sourceH);
 
 	//------------------------------------------------------------------------------
 
@@ -1499,14 +1353,29 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 		gs_reset_viewport();
 
 		dp->m_textVertices->Resize(0);
+		dp->m_overlayLines.clear();
+		dp->m_overlayTris.clear();
 
-		gs_technique_begin(solid_tech);
-		gs_technique_begin_pass(solid_tech, 0);
+		matrix4 curTransform;
+		gs_matrix_get(&curTransform);
+		for (auto &item : dp->m_selectedItems)
+			dp->BatchSelectedItem(item, curTransform, float(sourceW), float(sourceH));
 
-		obs_scene_enum_items(scene, DrawSelectedSource, dp);
+		// Outlines, guidelines and handles, colors are carried per vertex
+		if (!dp->m_overlayTris.empty() || !dp->m_overlayLines.empty()) {
+			gs_technique_t *colored_tech = gs_effect_get_technique(solid, "SolidColored");
+			vec4_set(&color, 1.0f, 1.0f, 1.0f, 1.0f);
+			gs_effect_set_vec4(solid_color, &color);
 
-		gs_technique_end_pass(solid_tech);
-		gs_technique_end(solid_tech);
+			gs_technique_begin(colored_tech);
+			gs_technique_begin_pass(colored_tech, 0);
+
+			dp->DrawOverlayBatch(dp->m_overlayTris, dp->m_overlayTriBuffer, GS_TRIS);
+			dp->DrawOverlayBatch(dp->m_overlayLines, dp->m_overlayLineBuffer, GS_LINES);
+
+			gs_technique_end_pass(colored_tech);
+			gs_technique_end(colored_tech);
+		}
 
 		// Text Rendering
 		if (dp->m_textVertices->Size() > 0) {
@@ -1523,6 +1392,118 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 	obs_source_release(source);
 	gs_projection_pop();
 	gs_viewport_pop();
+
+	uint64_t frameTime = os_gettime_ns() - frameStart;
+	std::lock_guard lock(dp->m_frameTimingMtx);
+	dp->m_frameTiming.frames++;
+	dp->m_frameTiming.lastNs = frameTime;
+	dp->m_frameTiming.totalNs += frameTime;
+	dp->m_frameTiming.maxNs = std::max(dp->m_frameTiming.maxNs, frameTime);
+}
+
+void OBS::Display::RenderContent()
+{
+	if (m_source) {
+		/* If the source is a transition it means this display 
+		 * is for Studio Mode and that the scene it contains is a 
+		 * duplicate of the current scene, apply selective recording
+		 * layer rendering if it is enabled */
+		if (obs_get_multiple_rendering() && obs_source_get_type(m_source) == OBS_SOURCE_TYPE_TRANSITION)
+			obs_set_video_rendering_mode(m_renderingMode);
+		obs_source_video_render(m_source);
+	} else {
+		obs_render_texture(m_canvas, m_renderingMode);
+	}
+}
+
+void OBS::Display::RenderSharedContent(uint32_t width, uint32_t height)
+{
+	// Canvas displays draw the already composited main texture, a copy would only cost more
+	if (!m_sharedRenderAttached) {
+		RenderContent();
+		return;
+	}
+
+	std::unique_lock lock(m_sharedRenderMtx);
+
+	auto found = m_sharedRenders.find(m_sharedRenderKey);
+	if (found == m_sharedRenders.end() || found->second.users < 2) {
+		// Nobody else shows this content, skip the extra copy
+		lock.unlock();
+		RenderContent();
+		return;
+	}
+
+	SharedRender &shared = found->second;
+	uint64_t frameTime = obs_get_video_frame_time();
+
+	if (!shared.texrender)
+		shared.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	// The first display drawn for this frame renders the composite, the others reuse it
+	if (shared.frameTime != frameTime || shared.width != width || shared.height != height) {
+		gs_texrender_reset(shared.texrender);
+		if (gs_texrender_begin(shared.texrender, width, height)) {
+			vec4 clear;
+			vec4_zero(&clear);
+			gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+			gs_ortho(0.0f, float(width), 0.0f, float(height), -100.0f, 100.0f);
+
+			gs_blend_state_push();
+			gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+			RenderContent();
+			gs_blend_state_pop();
+
+			gs_texrender_end(shared.texrender);
+
+			shared.frameTime = frameTime;
+			shared.width = width;
+			shared.height = height;
+		}
+	}
+
+	gs_texture_t *texture = gs_texrender_get_texture(shared.texrender);
+	if (!texture)
+		return;
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), texture);
+
+	// The composite is premultiplied at this point
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(texture, 0, width, height);
+	gs_blend_state_pop();
+}
+
+void OBS::Display::AttachSharedRender()
+{
+	if (!m_source)
+		return;
+
+	std::lock_guard lock(m_sharedRenderMtx);
+
+	m_sharedRenderKey = SharedRenderKey(m_source, m_renderingMode);
+	m_sharedRenders[m_sharedRenderKey].users++;
+	m_sharedRenderAttached = true;
+}
+
+void OBS::Display::DetachSharedRender()
+{
+	if (!m_sharedRenderAttached)
+		return;
+
+	// Graphics first, the display callback holds it when it takes the lock
+	ScopedGraphicsContext scopedGraphicsContext;
+	std::lock_guard lock(m_sharedRenderMtx);
+
+	auto found = m_sharedRenders.find(m_sharedRenderKey);
+	if (found != m_sharedRenders.end() && --found->second.users == 0) {
+		gs_texrender_destroy(found->second.texrender);
+		m_sharedRenders.erase(found);
+	}
+	m_sharedRenderAttached = false;
 }
 
 obs_source_t *OBS::Display::GetSourceForUIEffects()
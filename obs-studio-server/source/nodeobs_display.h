@@ -19,7 +19,9 @@
 #pragma once
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <system_error>
 #include <thread>
 #include <vector>
@@ -59,8 +61,22 @@ public:
 	Display(uint64_t windowHandle, enum obs_video_rendering_mode mode,
 		const std::string &sourceName, // Create a Source-Specific one
 		bool renderAtBottom, obs_video_info *canvas);
+	Display(uint32_t width, uint32_t height, enum obs_video_rendering_mode mode, // Create an offscreen one, no window needed
+		obs_video_info *canvas);
 	~Display();
 
+	struct FrameTiming {
+		uint64_t frames = 0;
+		uint64_t lastNs = 0;
+		uint64_t totalNs = 0;
+		uint64_t maxNs = 0;
+	};
+
+	bool IsOffscreen();
+	// Renders one frame into the offscreen target and reads it back as BGRA
+	bool RenderOffscreen(std::vector<char> &pixels);
+	FrameTiming GetFrameTiming();
+
 	void SetPosition(uint32_t x, uint32_t y);
 	std::pair<uint32_t, uint32_t> GetPosition();
 
@@ -89,13 +105,50 @@ public:
 	void UpdatePreviewArea();
 
 private:
+	/// Selected scene item state gathered once per frame
+	struct SelectedItem {
+		matrix4 boxTransform;
+		obs_sceneitem_crop crop;
+		vec2 boxScale;
+		float rot;
+		uint32_t sceneWidth;
+		uint32_t sceneHeight;
+	};
+
+	/// Pre-transformed overlay vertex, color is 0xAABBGGRR
+	struct OverlayVertex {
+		vec3 position;
+		uint32_t color;
+	};
+
+	/// Composite shared by all displays showing the same source or transition
+	struct SharedRender {
+		gs_texrender_t *texrender = nullptr;
+		uint64_t frameTime = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t users = 0;
+	};
+	typedef std::pair<obs_source_t *, enum obs_video_rendering_mode> SharedRenderKey;
+
 	static void DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy);
-	static bool DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
-	static bool DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+	void RenderContent();
+	void RenderSharedContent(uint32_t width, uint32_t height);
+	void AttachSharedRender();
+	void DetachSharedRender();
+	static bool CollectSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+	void DrawSelectedOverflow(const SelectedItem &item);
 	obs_source_t *GetSourceForUIEffects();
-	void DrawCropOutline(float x1, float y1, float x2, float y2, vec2 scale);
-	void DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale, gs_eparam_t *color);
-	void DrawRotationHandle(float rot, matrix4 &mtx);
+	void PushLine(const vec3 &a, const vec3 &b, uint32_t color);
+	void PushQuad(const vec3 &a, const vec3 &b, const vec3 &c, const vec3 &d, uint32_t color);
+	void BatchSelectedItem(const SelectedItem &item, const matrix4 &curTransform, float width, float height);
+	void BatchCropOutline(float x1, float y1, float x2, float y2, const vec2 &scale, const matrix4 &mtx);
+	void BatchOutline(const SelectedItem &item, const vec2 &boxScale);
+	void BatchGuideline(bool rot45, float x, float y, const matrix4 &mtx, float width, float height);
+	void BatchHandleBox(float x, float y, const matrix4 &mtx);
+	void BatchRotationHandle(float rot, const matrix4 &mtx);
+	void BatchDistanceText(const SelectedItem &item, bool rot45);
+	void DrawOverlayBatch(std::vector<OverlayVertex> &vertices, std::unique_ptr<GS::VertexBuffer> &buffer, gs_draw_mode mode);
 	void setSizeCall(int step);
 
 public: // Rendering code needs it.
@@ -128,17 +181,26 @@ private:
 	gs_texture_t *m_overflowNightTexture;
 	gs_texture_t *m_overflowDayTexture;
 	static std::mutex m_displayMtx;
+	static std::mutex m_sharedRenderMtx;
+	static std::map<SharedRenderKey, SharedRender> m_sharedRenders;
+	SharedRenderKey m_sharedRenderKey;
+	bool m_sharedRenderAttached = false;
+
+	// Offscreen target
+	gs_texrender_t *m_offscreenRender = nullptr;
+	gs_stagesurf_t *m_offscreenStage = nullptr;
+
+	std::mutex m_frameTimingMtx;
+	FrameTiming m_frameTiming;
 
 	GS::VertexBuffer *m_textVertices;
 
-	std::unique_ptr<GS::VertexBuffer> m_leftSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_topSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_rightSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_bottomSolidOutline;
-	std::unique_ptr<GS::VertexBuffer> m_cropOutline;
+	std::unique_ptr<GS::VertexBuffer> m_boxTris;
 
-	std::unique_ptr<GS::VertexBuffer> m_boxLine, m_boxTris;
-	std::unique_ptr<GS::VertexBuffer> m_rotHandleLine, m_rotHandleCircle;
+	// Selection overlays, rebuilt every frame and drawn with one call per primitive type
+	std::vector<SelectedItem> m_selectedItems;
+	std::vector<OverlayVertex> m_overlayLines, m_overlayTris;
+	std::unique_ptr<GS::VertexBuffer> m_overlayLineBuffer, m_overlayTriBuffer;
 
 	// Theme/Style
 	/// Padding
@@ -157,12 +219,6 @@ private:
 	// in the constructor and the "Set" color methods!
 	vec4 m_paddingColorVec4;
 	vec4 m_backgroundColorVec4;
-	vec4 m_outlineColorVec4;
-	vec4 m_cropOutlineColorVec4;
-	vec4 m_guidelineColorVec4;
-	vec4 m_resizeOuterColorVec4;
-	vec4 m_resizeInnerColorVec4;
-	vec4 m_rotationHandleColorVec4;
 
 	bool m_shouldDrawUI = true;
 	bool m_renderAtBottom = false;
@@ -173,7 +229,7 @@ private:
 #if defined(_WIN32)
 	class SystemWorkerThread;
 	std::unique_ptr<SystemWorkerThread> m_systemWorkerThread;
-	HWND m_ourWindow;
+	HWND m_ourWindow = NULL;
 	HWND m_parentWindow;
 	static bool DisplayWndClassRegistered;
 	static WNDCLASSEX DisplayWndClassObj;
@@ -1034,7 +1034,7 @@ std::string OBS_service::getStreamingOutputName(StreamServiceId serviceId)
 
 bool OBS_service::createStreamingOutput(StreamServiceId serviceId)
 {
-	const char *type = obs_service_get_output_type(services[serviceId]);
+	const char *type = obs_service_get_output_type(getService(serviceId));
 	if (!type)
 		type = "rtmp_output";
 
@@ -1097,7 +1097,7 @@ void OBS_service::updateStreamingEncoders(bool isSimpleMode, StreamServiceId ser
 
 bool OBS_service::startStreaming(StreamServiceId serviceId)
 {
-	const char *type = obs_service_get_output_type(services[serviceId]);
+	const char *type = obs_service_get_output_type(getService(serviceId));
 	if (!type)
 		type = "rtmp_output";
 
@@ -1117,7 +1117,7 @@ bool OBS_service::startStreaming(StreamServiceId serviceId)
 	updateService(serviceId);
 	updateStreamingOutput(serviceId);
 
-	obs_output_set_video_encoder(streamingOutput[serviceId], videoStreamingEncoder[serviceId]);
+	obs_output_set_video_encoder(streamingOutput[serviceId], getStreamingEncoder(serviceId));
 
 	if (isSimpleMode)
 		obs_output_set_audio_encoder(streamingOutput[serviceId], audioSimpleStreamingEncoder, 0);
@@ -1159,7 +1159,7 @@ void OBS_service::updateAudioStreamingEncoder(bool isSimpleMode, StreamServiceId
 	if (streamingOutput[serviceId]) {
 		codec = obs_output_get_supported_audio_codecs(streamingOutput[serviceId]);
 	} else {
-		const char *type = obs_service_get_output_type(services[serviceId]);
+		const char *type = obs_service_get_output_type(getService(serviceId));
 		if (!type)
 			type = "rtmp_output";
 
@@ -1306,14 +1306,14 @@ void OBS_service::updateVideoRecordingEncoder(bool isSimpleMode)
 					cx = 0;
 					cy = 0;
 				}
-				obs_encoder_set_scaled_size(videoRecordingEncoder, cx, cy);
+				obs_encoder_set_scaled_size(getRecordingEncoder(), cx, cy);
 			}
 		}
 	}
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(videoRecordingEncoder, obs_video_mix_get(0, OBS_RECORDING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(getRecordingEncoder(), obs_video_mix_get(0, OBS_RECORDING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(videoRecordingEncoder, obs_video_mix_get(0, OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(getRecordingEncoder(), obs_video_mix_get(0, OBS_MAIN_VIDEO_RENDERING));
 	}
 }
 
@@ -1349,10 +1349,10 @@ bool OBS_service::updateRecordingEncoders(bool isSimpleMode, StreamServiceId ser
 			updateVideoStreamingEncoder(isSimpleMode, serviceId);
 
 		if (!obs_get_multiple_rendering()) {
-			obs_encoder_set_video_mix(videoStreamingEncoder[serviceId], obs_video_mix_get(0, OBS_MAIN_VIDEO_RENDERING));
+			obs_encoder_set_video_mix(getStreamingEncoder(serviceId), obs_video_mix_get(0, OBS_MAIN_VIDEO_RENDERING));
 			useStreamEncoder = true;
 		} else {
-			duplicate_encoder(&videoRecordingEncoder, videoStreamingEncoder[serviceId]);
+			duplicate_encoder(&videoRecordingEncoder, getStreamingEncoder(serviceId));
 			obs_encoder_set_video_mix(videoRecordingEncoder, obs_video_mix_get(0, OBS_RECORDING_VIDEO_RENDERING));
 			useStreamEncoder = false;
 		}
@@ -1390,7 +1390,7 @@ bool OBS_service::startRecording(void)
 	}
 	updateFfmpegOutput(isSimpleMode, recordingOutput);
 
-	obs_output_set_video_encoder(recordingOutput, useStreamEncoder ? videoStreamingEncoder[0] : videoRecordingEncoder);
+	obs_output_set_video_encoder(recordingOutput, useStreamEncoder ? getStreamingEncoder(StreamServiceId::Main) : getRecordingEncoder());
 	if (isSimpleMode) {
 		obs_output_set_audio_encoder(recordingOutput, useStreamEncoder ? audioSimpleStreamingEncoder : audioSimpleRecordingEncoder, 0);
 	} else {
@@ -1560,7 +1560,7 @@ bool OBS_service::startReplayBuffer(void)
 	updateFfmpegOutput(isSimpleMode, replayBufferOutput);
 	updateReplayBufferOutput(isSimpleMode, useStreamEncoder);
 
-	obs_output_set_video_encoder(replayBufferOutput, useStreamEncoder ? videoStreamingEncoder[0] : videoRecordingEncoder);
+	obs_output_set_video_encoder(replayBufferOutput, useStreamEncoder ? getStreamingEncoder(StreamServiceId::Main) : getRecordingEncoder());
 	if (isSimpleMode) {
 		obs_output_set_audio_encoder(replayBufferOutput, useStreamEncoder ? audioSimpleStreamingEncoder : audioSimpleRecordingEncoder, 0);
 	} else {
@@ -1613,7 +1613,14 @@ void OBS_service::stopReplayBuffer(bool forceStop)
 
 obs_service_t *OBS_service::getService(StreamServiceId serviceId)
 {
-	if (serviceId <= services.size() && obs_service_get_type(services[serviceId]))
+	if (serviceId >= services.size())
+		return nullptr;
+
+	// Services are loaded from disk the first time they are needed instead of at startup
+	if (!services[serviceId])
+		createService(serviceId);
+
+	if (obs_service_get_type(services[serviceId]))
 		return services[serviceId];
 	else
 		return nullptr;
@@ -1746,6 +1753,12 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode, StreamServiceId
 				presetType = "Preset";
 				encoderID = "obs_x264";
 			}
+
+			// Same fallback as createVideoStreamingEncoder, the configured encoder may not be installed
+			if (!EncoderAvailable(encoderID)) {
+				presetType = "Preset";
+				encoderID = "obs_x264";
+			}
 			if (presetType)
 				preset = config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", presetType);
 
@@ -1773,7 +1786,7 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode, StreamServiceId
 		obs_data_set_string(aacSettings, "rate_control", "CBR");
 		obs_data_set_int(aacSettings, "bitrate", audioBitrate);
 
-		obs_service_apply_encoder_settings(services[serviceId], h264Settings, aacSettings);
+		obs_service_apply_encoder_settings(getService(serviceId), h264Settings, aacSettings);
 
 		if (advanced && !enforceBitrate) {
 			obs_data_set_int(h264Settings, "bitrate", videoBitrate);
@@ -1793,8 +1806,8 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode, StreamServiceId
 			obs_encoder_set_preferred_video_format(videoStreamingEncoder[serviceId], VIDEO_FORMAT_NV12);
 		}
 
-		if (strcmp(encoder, APPLE_SOFTWARE_VIDEO_ENCODER) == 0 || strcmp(encoder, APPLE_HARDWARE_VIDEO_ENCODER) == 0 ||
-		    strcmp(encoder, APPLE_HARDWARE_VIDEO_ENCODER_M1) == 0) {
+		if (encoder && (strcmp(encoder, APPLE_SOFTWARE_VIDEO_ENCODER) == 0 || strcmp(encoder, APPLE_HARDWARE_VIDEO_ENCODER) == 0 ||
+				strcmp(encoder, APPLE_HARDWARE_VIDEO_ENCODER_M1) == 0)) {
 			const char *profile = config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "Profile");
 			if (profile)
 				obs_data_set_string(h264Settings, "profile", profile);
@@ -1823,10 +1836,16 @@ void OBS_service::updateVideoStreamingEncoder(bool isSimpleMode, StreamServiceId
 			}
 		}
 	}
+
+	// Never the lazy getter here, it creates the encoder through this function
+	obs_encoder_t *streamingEncoder = videoStreamingEncoder[serviceId];
+	if (!streamingEncoder)
+		return;
+
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(videoStreamingEncoder[serviceId], obs_video_mix_get(videoInfo[serviceId], OBS_STREAMING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(streamingEncoder, obs_video_mix_get(videoInfo[serviceId], OBS_STREAMING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(videoStreamingEncoder[serviceId], obs_video_mix_get(videoInfo[serviceId], OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(streamingEncoder, obs_video_mix_get(videoInfo[serviceId], OBS_MAIN_VIDEO_RENDERING));
 	}
 }
 
@@ -1847,7 +1866,7 @@ std::string OBS_service::GetDefaultVideoSavePath(void)
 
 void OBS_service::updateService(StreamServiceId serviceId)
 {
-	obs_data_t *settings = obs_service_get_settings(services[serviceId]);
+	obs_data_t *settings = obs_service_get_settings(getService(serviceId));
 	const char *platform = obs_data_get_string(settings, "service");
 
 	const char *server = obs_service_get_url(services[serviceId]);
@@ -2280,6 +2299,9 @@ void OBS_service::updateVideoRecordingEncoderSettings()
 
 obs_encoder_t *OBS_service::getStreamingEncoder(StreamServiceId serviceId)
 {
+	if (!videoStreamingEncoder[serviceId])
+		createVideoStreamingEncoder(serviceId);
+
 	return videoStreamingEncoder[serviceId];
 }
 
@@ -2292,6 +2314,9 @@ void OBS_service::setStreamingEncoder(obs_encoder_t *encoder, StreamServiceId se
 
 obs_encoder_t *OBS_service::getRecordingEncoder(void)
 {
+	if (!videoRecordingEncoder)
+		createVideoRecordingEncoder();
+
 	return videoRecordingEncoder;
 }
 
@@ -2394,7 +2419,7 @@ void OBS_service::updateStreamingOutput(StreamServiceId serviceId)
 		bool applyServiceSettings = config_get_bool(ConfigManager::getInstance().getBasic(), "AdvOut", "ApplyServiceSettings");
 
 		if (applyServiceSettings) {
-			obs_data_t *encoderSettings = obs_encoder_get_settings(videoStreamingEncoder[serviceId]);
+			obs_data_t *encoderSettings = obs_encoder_get_settings(getStreamingEncoder(serviceId));
 			obs_service_apply_encoder_settings(OBS_service::getService(serviceId), encoderSettings, nullptr);
 		}
 	}
@@ -2704,7 +2729,7 @@ void OBS_service::waitReleaseWorker()
 void OBS_service::OBS_service_createVirtualWebcam(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	virtualWebcamOutput = nullptr;
-	std::string name = args[0].value_str;
+	const std::string &name = args[0].value_str;
 	if (name.empty())
 		return;
 
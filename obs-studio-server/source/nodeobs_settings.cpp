@@ -22,6 +22,8 @@
 #include "shared.hpp"
 #include "memory-manager.h"
 #include "osn-video.hpp"
+#include "osn-shared-memory.hpp"
+#include "ipc-view.hpp"
 
 #ifdef WIN32
 #include <windows.h>
@@ -66,6 +68,10 @@ void OBS_settings::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>(
 		"OBS_settings_saveSettings", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::Binary},
 		OBS_settings_saveSettings));
+	// Same call with the buffer handed over through the shared memory region
+	cls->register_function(std::make_shared<ipc::function>(
+		"OBS_settings_saveSettings", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt64},
+		OBS_settings_saveSettings));
 	cls->register_function(
 		std::make_shared<ipc::function>("OBS_settings_getInputAudioDevices", std::vector<ipc::type>{}, OBS_settings_getInputAudioDevices));
 	cls->register_function(
@@ -77,9 +83,8 @@ void OBS_settings::Register(ipc::server &srv)
 
 void OBS_settings::OBS_settings_getSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::string nameCategory = args[0].value_str;
 	CategoryTypes type = NODEOBS_CATEGORY_LIST;
-	std::vector<SubCategory> settings = getSettings(nameCategory, type);
+	std::vector<SubCategory> settings = getSettings(ipc_view::str(args[0]), type);
 	std::vector<char> binaryValue;
 
 	for (int i = 0; i < settings.size(); i++) {
@@ -90,7 +95,7 @@ void OBS_settings::OBS_settings_getSettings(void *data, const int64_t id, const
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value((uint64_t)settings.size()));
 	rval.push_back(ipc::value((uint64_t)binaryValue.size()));
-	rval.push_back(ipc::value(binaryValue));
+	rval.push_back(osn::SharedMemory::Binary(binaryValue.data(), binaryValue.size()));
 	rval.push_back(ipc::value(type));
 	AUTO_DEBUG;
 }
@@ -131,7 +136,7 @@ void UpdateAudioSettings(bool saveOnlyIfLimitApplied)
 	}
 }
 
-std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, std::vector<char> buffer)
+std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t sizeStruct, const char *buffer)
 {
 	std::vector<SubCategory> category;
 
@@ -139,76 +144,76 @@ std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t
 	for (uint32_t i = 0; i < subCategoriesCount; i++) {
 		SubCategory sc;
 
-		uint64_t *sizeMessage = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+		uint64_t *sizeMessage = reinterpret_cast<uint64_t *>(buffer + indexData);
 		indexData += sizeof(uint64_t);
 
-		std::string name(buffer.data() + indexData, *sizeMessage);
+		std::string name(buffer + indexData, *sizeMessage);
 		indexData += *sizeMessage;
 
-		uint32_t *paramsCount = reinterpret_cast<uint32_t *>(buffer.data() + indexData);
+		uint32_t *paramsCount = reinterpret_cast<uint32_t *>(buffer + indexData);
 		indexData += sizeof(uint32_t);
 
 		Parameter param;
 		for (int j = 0; j < *paramsCount; j++) {
-			uint64_t *sizeName = reinterpret_cast<std::uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeName = reinterpret_cast<std::uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string name(buffer.data() + indexData, *sizeName);
+			std::string name(buffer + indexData, *sizeName);
 			indexData += *sizeName;
 
-			uint64_t *sizeDescription = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeDescription = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string description(buffer.data() + indexData, *sizeDescription);
+			std::string description(buffer + indexData, *sizeDescription);
 			indexData += *sizeDescription;
 
-			uint64_t *sizeType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeType = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string type(buffer.data() + indexData, *sizeType);
+			std::string type(buffer + indexData, *sizeType);
 			indexData += *sizeType;
 
-			uint64_t *sizeSubType = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeSubType = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			std::string subType(buffer.data() + indexData, *sizeSubType);
+			std::string subType(buffer + indexData, *sizeSubType);
 			indexData += *sizeSubType;
 
-			bool *enabled = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *enabled = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *masked = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *masked = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			bool *visible = reinterpret_cast<bool *>(buffer.data() + indexData);
+			bool *visible = reinterpret_cast<bool *>(buffer + indexData);
 			indexData += sizeof(bool);
 
-			double *minVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *minVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *maxVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *maxVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			double *stepVal = reinterpret_cast<double *>(buffer.data() + indexData);
+			double *stepVal = reinterpret_cast<double *>(buffer + indexData);
 			indexData += sizeof(double);
 
-			uint64_t *sizeOfCurrentValue = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeOfCurrentValue = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> currentValue;
 			currentValue.resize(*sizeOfCurrentValue);
-			memcpy(currentValue.data(), buffer.data() + indexData, *sizeOfCurrentValue);
+			memcpy(currentValue.data(), buffer + indexData, *sizeOfCurrentValue);
 			indexData += *sizeOfCurrentValue;
 
-			uint64_t *sizeOfValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *sizeOfValues = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
-			uint64_t *countValues = reinterpret_cast<uint64_t *>(buffer.data() + indexData);
+			uint64_t *countValues = reinterpret_cast<uint64_t *>(buffer + indexData);
 			indexData += sizeof(uint64_t);
 
 			std::vector<char> values;
 			values.resize(*sizeOfValues);
-			memcpy(values.data(), buffer.data() + indexData, *sizeOfValues);
+			memcpy(values.data(), buffer + indexData, *sizeOfValues);
 			indexData += *sizeOfValues;
 
 			param.name = name;
@@ -236,15 +241,18 @@ std::vector<SubCategory> serializeCategory(uint32_t subCategoriesCount, uint32_t
 
 void OBS_settings::OBS_settings_saveSettings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::string nameCategory = args[0].value_str;
+	std::string_view nameCategory = ipc_view::str(args[0]);
 	uint32_t subCategoriesCount = args[1].value_union.ui32;
 	uint32_t sizeStruct = args[2].value_union.ui32;
 
-	std::vector<char> buffer;
-	buffer.resize(sizeStruct);
-	memcpy(buffer.data(), args[3].value_bin.data(), sizeStruct);
-
-	std::vector<SubCategory> settings = serializeCategory(subCategoriesCount, sizeStruct, buffer);
+	std::vector<SubCategory> settings;
+	{
+		ipc_shm::View buffer(osn::SharedMemory::GetRegion(), args[3]);
+		if (buffer.size() < sizeStruct) {
+			PRETTY_ERROR_RETURN(ErrorCode::OutOfBounds, "Settings buffer is smaller than announced.");
+		}
+		settings = serializeCategory(subCategoriesCount, sizeStruct, buffer.data());
+	}
 
 	if (saveSettings(nameCategory, settings)) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -2048,17 +2056,17 @@ SubCategory OBS_settings::getAdvancedOutputStreamingSettings(config_t *config, b
 
 	obs_data_t *settings = obs_encoder_defaults(encoderID);
 	obs_encoder_t *streamingEncoder = OBS_service::getStreamingEncoder(StreamServiceId::Main);
-	obs_encoder_t *recordEncoder = obs_output_get_video_encoder(OBS_service::getRecordingOutput());
 	obs_output_t *streamOutput = OBS_service::getStreamingOutput(StreamServiceId::Main); //todo DUALOUTPUT
 	obs_output_t *recordOutput = OBS_service::getRecordingOutput();
+	obs_encoder_t *recordEncoder = recordOutput ? obs_output_get_video_encoder(recordOutput) : nullptr;
 
 	/*
 		If the stream and recording outputs uses the same encoders, we need to check if both aren't active 
 		before recreating the stream encoder to prevent releasing it when it's still being used.
 		If they use differente encoders, just check for the stream output.
 	*/
-	bool streamOutputIsActive = obs_output_active(streamOutput);
-	bool recOutputIsActive = obs_output_active(recordOutput);
+	bool streamOutputIsActive = streamOutput && obs_output_active(streamOutput);
+	bool recOutputIsActive = recordOutput && obs_output_active(recordOutput);
 	bool recStreamUsesSameEncoder = streamingEncoder == recordEncoder;
 	bool recOutputBlockStreamOutput = !(!recStreamUsesSameEncoder || (recStreamUsesSameEncoder && !recOutputIsActive));
 
@@ -2500,10 +2508,8 @@ void OBS_settings::getStandardRecordingSettings(SubCategory *subCategoryParamete
 	recordingEncoder = OBS_service::getRecordingEncoder();
 	obs_output_t *recordOutput = OBS_service::getRecordingOutput();
 
-	if (recordOutput == NULL)
-		return;
-
-	if (obs_output_active(recordOutput)) {
+	// The recording output is only created once a recording starts
+	if (recordOutput && obs_output_active(recordOutput)) {
 		settings = obs_encoder_get_settings(recordingEncoder);
 	} else if (!recordingEncoder || (recordingEncoder && !obs_encoder_active(recordingEncoder))) {
 		if (!fileExist) {
@@ -4140,7 +4146,7 @@ void OBS_settings::saveAdvancedSettings(std::vector<SubCategory> advancedSetting
 	MemoryManager::GetInstance().updateSourcesCache();
 }
 
-std::vector<SubCategory> OBS_settings::getSettings(std::string nameCategory, CategoryTypes &type)
+std::vector<SubCategory> OBS_settings::getSettings(std::string_view nameCategory, CategoryTypes &type)
 {
 	std::vector<SubCategory> settings;
 
@@ -4163,7 +4169,7 @@ std::vector<SubCategory> OBS_settings::getSettings(std::string nameCategory, Cat
 	return settings;
 }
 
-bool OBS_settings::saveSettings(std::string nameCategory, std::vector<SubCategory> settings)
+bool OBS_settings::saveSettings(std::string_view nameCategory, const std::vector<SubCategory> &settings)
 {
 	bool ret = true;
 
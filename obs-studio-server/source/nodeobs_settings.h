@@ -21,6 +21,7 @@
 #include <obs.h>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <util/lexer.h>
 #include <util/platform.h>
 #include "nodeobs_service.h"
@@ -157,8 +158,8 @@ public:
 
 private:
 	// Exposed methods to the frontend
-	static std::vector<SubCategory> getSettings(std::string nameCategory, CategoryTypes &);
-	static bool saveSettings(std::string nameCategory, std::vector<SubCategory> settings);
+	static std::vector<SubCategory> getSettings(std::string_view nameCategory, CategoryTypes &);
+	static bool saveSettings(std::string_view nameCategory, const std::vector<SubCategory> &settings);
 
 	// Get each category
 	static std::vector<SubCategory> getGeneralSettings();
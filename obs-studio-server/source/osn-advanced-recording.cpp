@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-advanced-recording.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-error.hpp"
 #include "shared.hpp"
 #include "osn-audio-track.hpp"
@@ -185,10 +186,12 @@ bool osn::AdvancedRecording::UpdateEncoders()
 	if (!videoEncoder)
 		return false;
 
+	// The stream encoders are configured by the streaming output instead
+	obs_encoder_t *encoder = useStreamEncoders ? videoEncoder : osn::EncoderRegistry::Unshare(this, videoEncoder);
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_RECORDING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(canvas, OBS_RECORDING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
 	}
 
 	return true;
@@ -222,7 +225,7 @@ void osn::IAdvancedRecording::Start(void *data, const int64_t id, const std::vec
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid video encoder.");
 	}
 
-	obs_output_set_video_encoder(recording->output, recording->videoEncoder);
+	obs_output_set_video_encoder(recording->output, osn::EncoderRegistry::Acquire(recording, recording->videoEncoder));
 
 	std::string path = recording->path;
 
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-advanced-replay-buffer.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-video-encoder.hpp"
 #include "osn-error.hpp"
 #include "shared.hpp"
@@ -29,6 +30,8 @@ void osn::IAdvancedReplayBuffer::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("GetDuration", std::vector<ipc::type>{ipc::type::UInt64}, GetDuration));
 	cls->register_function(std::make_shared<ipc::function>("SetDuration", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetDuration));
+	cls->register_function(std::make_shared<ipc::function>("GetMaxSize", std::vector<ipc::type>{ipc::type::UInt64}, GetMaxSize));
+	cls->register_function(std::make_shared<ipc::function>("SetMaxSize", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetMaxSize));
 	cls->register_function(std::make_shared<ipc::function>("GetPrefix", std::vector<ipc::type>{ipc::type::UInt64}, GetPrefix));
 	cls->register_function(std::make_shared<ipc::function>("SetPrefix", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, SetPrefix));
 	cls->register_function(std::make_shared<ipc::function>("GetSuffix", std::vector<ipc::type>{ipc::type::UInt64}, GetSuffix));
@@ -154,7 +157,7 @@ void osn::IAdvancedReplayBuffer::Start(void *data, const int64_t id, const std::
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid video encoder.");
 	}
 
-	obs_output_set_video_encoder(replayBuffer->output, videoEncoder);
+	obs_output_set_video_encoder(replayBuffer->output, osn::EncoderRegistry::Acquire(replayBuffer, videoEncoder));
 
 	if (!replayBuffer->path.size()) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid recording path.");
@@ -162,7 +165,7 @@ void osn::IAdvancedReplayBuffer::Start(void *data, const int64_t id, const std::
 
 	const char *rbPrefix = replayBuffer->prefix.c_str();
 	const char *rbSuffix = replayBuffer->suffix.c_str();
-	int64_t rbSize = replayBuffer->usesStream ? 0 : 512;
+	int64_t rbSize = replayBuffer->maxSize;
 
 	std::string f;
 	if (rbPrefix && *rbPrefix) {
@@ -224,6 +227,7 @@ void osn::IAdvancedReplayBuffer::GetLegacySettings(void *data, const int64_t id,
 	replayBuffer->prefix = utility::GetSafeString(config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBPrefix"));
 	replayBuffer->suffix = utility::GetSafeString(config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSuffix"));
 	replayBuffer->duration = config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecRBTime");
+	replayBuffer->maxSize = config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecRBSize");
 
 	replayBuffer->mixer = config_get_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecTracks");
 
@@ -256,6 +260,7 @@ void osn::IAdvancedReplayBuffer::SetLegacySettings(void *data, const int64_t id,
 	config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBPrefix", replayBuffer->prefix.c_str());
 	config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSuffix", replayBuffer->suffix.c_str());
 	config_set_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecRBTime", replayBuffer->duration);
+	config_set_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecRBSize", replayBuffer->maxSize);
 	config_set_int(ConfigManager::getInstance().getBasic(), "AdvOut", "RecTracks", replayBuffer->mixer);
 	config_set_bool(ConfigManager::getInstance().getBasic(), "AdvOut", "replayBufferUseStreamOutput", replayBuffer->usesStream);
 
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-advanced-streaming.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-video-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-error.hpp"
@@ -318,10 +319,11 @@ void osn::AdvancedStreaming::UpdateEncoders()
 	if (!videoEncoder)
 		return;
 
-	if (obs_encoder_active(videoEncoder))
+	obs_encoder_t *encoder = osn::EncoderRegistry::Unshare(this, videoEncoder);
+	if (obs_encoder_active(encoder))
 		return;
 
-	obs_data_t *settings = obs_encoder_get_settings(videoEncoder);
+	obs_data_t *settings = obs_encoder_get_settings(encoder);
 	if (enforceServiceBitrate) {
 
 		int bitrate = (int)obs_data_get_int(settings, "bitrate");
@@ -343,16 +345,16 @@ void osn::AdvancedStreaming::UpdateEncoders()
 		// case VIDEO_FORMAT_P010:
 		break;
 	default:
-		obs_encoder_set_preferred_video_format(videoEncoder, VIDEO_FORMAT_NV12);
+		obs_encoder_set_preferred_video_format(encoder, VIDEO_FORMAT_NV12);
 	}
 
-	obs_encoder_update(videoEncoder, settings);
+	obs_encoder_update(encoder, settings);
 	obs_data_release(settings);
 
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_STREAMING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(canvas, OBS_STREAMING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
 	}
 }
 
@@ -393,9 +395,9 @@ void osn::IAdvancedStreaming::Start(void *data, const int64_t id, const std::vec
 	}
 
 	if (streaming->rescaling)
-		obs_encoder_set_scaled_size(streaming->videoEncoder, streaming->outputWidth, streaming->outputHeight);
+		obs_encoder_set_scaled_size(osn::EncoderRegistry::Configured(streaming, streaming->videoEncoder), streaming->outputWidth, streaming->outputHeight);
 
-	obs_output_set_video_encoder(streaming->output, streaming->videoEncoder);
+	obs_output_set_video_encoder(streaming->output, osn::EncoderRegistry::Acquire(streaming, streaming->videoEncoder));
 
 	if (streaming->enableTwitchVOD) {
 		streaming->twitchVODSupported = streaming->isTwitchVODSupported();
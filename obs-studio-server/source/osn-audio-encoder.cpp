@@ -71,7 +71,7 @@ void osn::AudioEncoder::SetName(void *data, const int64_t id, const std::vector<
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Encoder reference is not valid.");
 	}
 
-	std::string name = args[1].value_str;
+	const std::string &name = args[1].value_str;
 	obs_encoder_set_name(audioEncoder, name.c_str());
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
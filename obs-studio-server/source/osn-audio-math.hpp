@@ -0,0 +1,82 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#include <emmintrin.h>
+#endif
+
+// Kernels over packed level and fader arrays. Each one comes with a scalar
+// reference that defines its result, the vector version must match it bit
+// for bit and only processes four floats per step.
+namespace osn {
+namespace audio_math {
+// Replaces +inf with high and -inf or NaN with low, finite values pass through
+inline void SanitizeScalar(float *values, size_t count, float high, float low)
+{
+	for (size_t i = 0; i < count; i++) {
+		float value = values[i];
+		values[i] = std::isfinite(value) ? value : (value > 0 ? high : low);
+	}
+}
+
+inline void Sanitize(float *values, size_t count, float high, float low)
+{
+	size_t i = 0;
+#if defined(__aarch64__)
+	const float32x4_t inf = vdupq_n_f32(INFINITY);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t highs = vdupq_n_f32(high);
+	const float32x4_t lows = vdupq_n_f32(low);
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t value = vld1q_f32(values + i);
+		// NaN compares false, so it is neither finite nor positive
+		uint32x4_t finite = vcltq_f32(vabsq_f32(value), inf);
+		uint32x4_t positive = vcgtq_f32(value, zero);
+		float32x4_t replacement = vbslq_f32(positive, highs, lows);
+		vst1q_f32(values + i, vbslq_f32(finite, value, replacement));
+	}
+#else
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 inf = _mm_set1_ps(INFINITY);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 highs = _mm_set1_ps(high);
+	const __m128 lows = _mm_set1_ps(low);
+	for (; i + 4 <= count; i += 4) {
+		__m128 value = _mm_loadu_ps(values + i);
+		// NaN compares false, so it is neither finite nor positive
+		__m128 finite = _mm_cmplt_ps(_mm_and_ps(value, absMask), inf);
+		__m128 positive = _mm_cmpgt_ps(value, zero);
+		__m128 replacement = _mm_or_ps(_mm_and_ps(positive, highs), _mm_andnot_ps(positive, lows));
+		_mm_storeu_ps(values + i, _mm_or_ps(_mm_and_ps(finite, value), _mm_andnot_ps(finite, replacement)));
+	}
+#endif
+	SanitizeScalar(values + i, count - i, high, low);
+}
+
+// Meter levels in dB: overflow reads as full scale, anything else as silence
+inline void SanitizeLevels(float *levels, size_t count)
+{
+	Sanitize(levels, count, 0.0f, -65535.0f);
+}
+} // namespace audio_math
+} // namespace osn
@@ -0,0 +1,104 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-batch.hpp"
+#include <osn-error.hpp>
+#include <ipc-batch.hpp>
+#include <obs.h>
+#include <map>
+#include "shared.hpp"
+
+struct BatchHandler {
+	std::vector<ipc::type> types;
+	osn::Batch::Handler handler;
+};
+
+// Filled while the collections register, read-only once the server runs
+static std::map<std::string, BatchHandler> batchHandlers;
+static osn::Batch::CallHook preCallHook = nullptr;
+static osn::Batch::CallHook postCallHook = nullptr;
+
+void osn::Batch::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Batch");
+	cls->register_function(std::make_shared<ipc::function>("Apply", std::vector<ipc::type>{ipc::type::Binary}, Apply));
+	srv.register_collection(cls);
+}
+
+std::shared_ptr<ipc::function> osn::Batch::Function(const std::string &cname, const std::string &fname, const std::vector<ipc::type> &types, Handler handler)
+{
+	batchHandlers[cname + "." + fname] = {types, handler};
+	return std::make_shared<ipc::function>(fname, types, handler);
+}
+
+void osn::Batch::SetCallHooks(CallHook pre, CallHook post)
+{
+	preCallHook = pre;
+	postCallHook = post;
+}
+
+void osn::Batch::Apply(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	const std::vector<char> &buffer = args[0].value_bin;
+
+	std::string cname, fname;
+	std::vector<ipc::value> callArgs;
+	std::vector<ipc::value> callRval;
+	uint32_t applied = 0;
+	size_t offset = 0;
+
+	// Calls run in the order the client queued them, a call that does not match
+	// a batchable handler is skipped like an unknown function would be
+	while (ipc_batch::Next(buffer, offset, cname, fname, callArgs)) {
+		auto found = batchHandlers.find(cname + "." + fname);
+		if (found == batchHandlers.end() || found->second.types.size() != callArgs.size()) {
+			blog(LOG_WARNING, "Batch: skipped call to %s.%s", cname.c_str(), fname.c_str());
+			continue;
+		}
+
+		bool typesMatch = true;
+		for (size_t i = 0; i < callArgs.size(); i++)
+			typesMatch &= callArgs[i].type == found->second.types[i];
+		if (!typesMatch) {
+			blog(LOG_WARNING, "Batch: skipped call to %s.%s, wrong argument types", cname.c_str(), fname.c_str());
+			continue;
+		}
+
+		if (preCallHook)
+			preCallHook(cname, fname, callArgs);
+
+		callRval.clear();
+		found->second.handler(nullptr, id, callArgs, callRval);
+		applied++;
+
+		if (postCallHook)
+			postCallHook(cname, fname, callRval);
+
+		// Nobody waits for the reply of a batched call, so failures only show up here
+		if (callRval.size() > 0 && (ErrorCode)callRval[0].value_union.ui64 != ErrorCode::Ok)
+			blog(LOG_WARNING, "Batch: call to %s.%s failed: %s", cname.c_str(), fname.c_str(),
+			     callRval.size() > 1 ? callRval[1].value_str.c_str() : "no description");
+	}
+
+	if (offset != buffer.size())
+		blog(LOG_ERROR, "Batch: malformed message, stopped after %u calls", applied);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(applied));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-server.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osn {
+class Batch {
+public:
+	typedef void (*Handler)(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	// Same arguments as the server's pre and post callbacks, the post hook gets the call's return values
+	typedef void (*CallHook)(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args);
+
+	static void Register(ipc::server &);
+
+	// Registers a fire-and-forget handler that clients may also send inside a batch
+	static std::shared_ptr<ipc::function> Function(const std::string &cname, const std::string &fname, const std::vector<ipc::type> &types,
+						       Handler handler);
+
+	// Batched calls bypass the server callbacks, these hooks run around each of them instead
+	static void SetCallHooks(CallHook pre, CallHook post);
+
+	static void Apply(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
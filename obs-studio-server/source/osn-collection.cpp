@@ -0,0 +1,399 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-collection.hpp"
+#include <osn-error.hpp>
+#include <obs.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "osn-sceneitem.hpp"
+#include "osn-render-cache.hpp"
+#include "osn-source.hpp"
+#include "osn-video.hpp"
+#include "shared.hpp"
+
+void osn::Collection::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Collection");
+	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::String}, Load));
+	srv.register_collection(cls);
+}
+
+// Inputs slower than this to construct are named in the log
+#define SLOW_INPUT_NS 100000000ULL
+
+static double GetDouble(obs_data_t *data, const char *name, double defaultValue)
+{
+	return obs_data_has_user_value(data, name) ? obs_data_get_double(data, name) : defaultValue;
+}
+
+static bool GetBool(obs_data_t *data, const char *name, bool defaultValue)
+{
+	return obs_data_has_user_value(data, name) ? obs_data_get_bool(data, name) : defaultValue;
+}
+
+// Input types whose constructors never touch the graphics subsystem. Anything else, including
+// types we do not know about, is constructed on the loading thread.
+static const char *const ThreadSafeInputTypes[] = {
+	"color_source",
+	"color_source_v2",
+	"color_source_v3",
+	"ffmpeg_source",
+	"audio_line",
+	"wasapi_input_capture",
+	"wasapi_output_capture",
+	"wasapi_process_output_capture",
+	"coreaudio_input_capture",
+	"coreaudio_output_capture",
+	"pulse_input_capture",
+	"pulse_output_capture",
+	"alsa_input_capture",
+	"jack_input_client",
+};
+
+static bool IsThreadSafeInputType(const char *type)
+{
+	return std::any_of(std::begin(ThreadSafeInputTypes), std::end(ThreadSafeInputTypes), [type](const char *safe) { return strcmp(safe, type) == 0; });
+}
+
+// Only the plugin constructor runs here, this may be called from several loader threads at once
+static obs_source_t *CreateInput(obs_data_t *info, uint64_t &createTime)
+{
+	uint64_t createStart = os_gettime_ns();
+
+	obs_data_t *settings = obs_data_get_obj(info, "settings");
+	obs_source_t *source = obs_source_create(obs_data_get_string(info, "type"), obs_data_get_string(info, "name"), settings, nullptr);
+	obs_data_release(settings);
+
+	createTime = os_gettime_ns() - createStart;
+	return source;
+}
+
+// Everything after construction runs on the loading thread, filters may need the graphics context
+static void SetupInput(obs_source_t *source, obs_data_t *info)
+{
+	const char *name = obs_data_get_string(info, "name");
+
+	if (obs_source_get_audio_mixers(source)) {
+		obs_source_set_muted(source, GetBool(info, "muted", false));
+		obs_source_set_volume(source, (float_t)GetDouble(info, "volume", 1.0));
+
+		obs_data_t *syncOffset = obs_data_get_obj(info, "syncOffset");
+		if (syncOffset) {
+			obs_source_set_sync_offset(source, obs_data_get_int(syncOffset, "sec") * 1000000000 + obs_data_get_int(syncOffset, "nsec"));
+			obs_data_release(syncOffset);
+		} else {
+			obs_source_set_sync_offset(source, 0);
+		}
+	}
+
+	obs_source_set_deinterlace_mode(source, (obs_deinterlace_mode)obs_data_get_int(info, "deinterlaceMode"));
+	obs_source_set_deinterlace_field_order(source, (obs_deinterlace_field_order)obs_data_get_int(info, "deinterlaceFieldOrder"));
+
+	obs_data_array_t *filters = obs_data_get_array(info, "filters");
+	for (size_t idx = 0; idx < obs_data_array_count(filters); idx++) {
+		obs_data_t *filterInfo = obs_data_array_item(filters, idx);
+		obs_data_t *filterSettings = obs_data_get_obj(filterInfo, "settings");
+
+		obs_source_t *filter =
+			obs_source_create_private(obs_data_get_string(filterInfo, "type"), obs_data_get_string(filterInfo, "name"), filterSettings);
+		if (filter) {
+			obs_source_set_enabled(filter, GetBool(filterInfo, "enabled", true));
+			obs_source_filter_add(source, filter);
+			obs_source_release(filter);
+		} else {
+			blog(LOG_WARNING, "Collection: failed to create filter '%s' on '%s'", obs_data_get_string(filterInfo, "name"), name);
+		}
+
+		obs_data_release(filterSettings);
+		obs_data_release(filterInfo);
+	}
+	obs_data_array_release(filters);
+}
+
+static void CreateInputs(const std::vector<obs_data_t *> &infos, std::vector<obs_source_t *> &sources, std::vector<uint64_t> &createTimes,
+			 uint32_t workers)
+{
+	sources.assign(infos.size(), nullptr);
+	createTimes.assign(infos.size(), 0);
+
+	workers = std::min<uint32_t>(workers, std::max(std::thread::hardware_concurrency(), 1u));
+	workers = std::min<uint32_t>(workers, (uint32_t)infos.size());
+	if (workers <= 1) {
+		for (size_t idx = 0; idx < infos.size(); idx++)
+			sources[idx] = CreateInput(infos[idx], createTimes[idx]);
+		return;
+	}
+
+	// Inputs do not depend on each other at construction, but only the allowed types may be built off this thread
+	std::vector<size_t> parallel;
+	std::vector<size_t> serial;
+	for (size_t idx = 0; idx < infos.size(); idx++) {
+		if (IsThreadSafeInputType(obs_data_get_string(infos[idx], "type")))
+			parallel.push_back(idx);
+		else
+			serial.push_back(idx);
+	}
+
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		for (size_t idx = next++; idx < parallel.size(); idx = next++)
+			sources[parallel[idx]] = CreateInput(infos[parallel[idx]], createTimes[parallel[idx]]);
+	};
+
+	// The pool works through the safe types while this thread builds the others, then helps out
+	std::vector<std::thread> pool;
+	workers = std::min<uint32_t>(workers, (uint32_t)parallel.size() + 1);
+	pool.reserve(workers - 1);
+	for (uint32_t idx = 1; idx < workers; idx++)
+		pool.emplace_back(worker);
+	for (size_t idx : serial)
+		sources[idx] = CreateInput(infos[idx], createTimes[idx]);
+	worker();
+	for (auto &thread : pool)
+		thread.join();
+}
+
+static obs_sceneitem_t *AddItem(obs_scene_t *scene, obs_source_t *source, obs_data_t *info, obs_video_info *canvas)
+{
+	obs_sceneitem_t *item = obs_scene_add(scene, source);
+	if (!item)
+		return nullptr;
+
+	if (canvas)
+		obs_sceneitem_set_canvas(item, canvas);
+
+	vec2 scale;
+	scale.x = (float)GetDouble(info, "scaleX", 1.0);
+	scale.y = (float)GetDouble(info, "scaleY", 1.0);
+	obs_sceneitem_set_scale(item, &scale);
+
+	obs_sceneitem_set_visible(item, GetBool(info, "visible", true));
+
+	vec2 pos;
+	pos.x = (float)obs_data_get_double(info, "x");
+	pos.y = (float)obs_data_get_double(info, "y");
+	obs_sceneitem_set_pos(item, &pos);
+
+	obs_sceneitem_set_rot(item, (float)obs_data_get_double(info, "rotation"));
+
+	obs_data_t *cropInfo = obs_data_get_obj(info, "crop");
+	obs_sceneitem_crop crop = {};
+	if (cropInfo) {
+		crop.left = (int)obs_data_get_int(cropInfo, "left");
+		crop.top = (int)obs_data_get_int(cropInfo, "top");
+		crop.right = (int)obs_data_get_int(cropInfo, "right");
+		crop.bottom = (int)obs_data_get_int(cropInfo, "bottom");
+		obs_data_release(cropInfo);
+	}
+	obs_sceneitem_set_crop(item, &crop);
+
+	obs_sceneitem_set_stream_visible(item, GetBool(info, "streamVisible", true));
+	obs_sceneitem_set_recording_visible(item, GetBool(info, "recordingVisible", true));
+
+	obs_sceneitem_set_scale_filter(item, (enum obs_scale_type)obs_data_get_int(info, "scaleFilter"));
+	obs_sceneitem_set_blending_mode(item, (enum obs_blending_type)obs_data_get_int(info, "blendingMode"));
+	obs_sceneitem_set_blending_method(item, (enum obs_blending_method)obs_data_get_int(info, "blendingMethod"));
+
+	return item;
+}
+
+void osn::Collection::Load(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_data_t *collection = obs_data_create_from_json(args[0].value_str.c_str());
+	if (!collection) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Collection is not valid JSON.");
+	}
+
+	uint64_t loadStart = os_gettime_ns();
+	std::vector<ipc::value> inputs;
+	std::vector<ipc::value> scenes;
+	std::vector<std::string> failed;
+	uint32_t inputCount = 0;
+	uint32_t sceneCount = 0;
+
+	// Inputs, constructed concurrently when asked to
+	uint32_t workers = (uint32_t)obs_data_get_int(collection, "workers");
+	obs_data_array_t *sources = obs_data_get_array(collection, "sources");
+	std::vector<obs_data_t *> sourceInfos(obs_data_array_count(sources));
+	for (size_t idx = 0; idx < sourceInfos.size(); idx++)
+		sourceInfos[idx] = obs_data_array_item(sources, idx);
+	obs_data_array_release(sources);
+
+	std::vector<obs_source_t *> createdSources;
+	std::vector<uint64_t> createTimes;
+	CreateInputs(sourceInfos, createdSources, createTimes, workers);
+	uint64_t createEnd = os_gettime_ns();
+
+	// Then their state and filters, one at a time
+	for (size_t idx = 0; idx < sourceInfos.size(); idx++) {
+		obs_data_t *info = sourceInfos[idx];
+		const char *name = obs_data_get_string(info, "name");
+
+		obs_source_t *source = createdSources[idx];
+		uint64_t uid = source ? osn::Source::Manager::GetInstance().find(source) : UINT64_MAX;
+		if (uid == UINT64_MAX) {
+			blog(LOG_WARNING, "Collection: failed to create input '%s' of type '%s'", name, obs_data_get_string(info, "type"));
+			obs_source_release(source);
+			failed.push_back(name);
+
+			// Failed entries keep their slot so results line up with the description
+			inputs.push_back(ipc::value(uid));
+			inputs.push_back(ipc::value(name));
+			obs_data_release(info);
+			continue;
+		}
+
+		if (createTimes[idx] > SLOW_INPUT_NS)
+			blog(LOG_INFO, "Collection: input '%s' of type '%s' took %.3f ms to create", name, obs_data_get_string(info, "type"),
+			     double(createTimes[idx]) / 1000000.0);
+
+		SetupInput(source, info);
+
+		obs_data_t *settings = obs_source_get_settings(source);
+		inputs.push_back(ipc::value(uid));
+		inputs.push_back(ipc::value(name));
+		inputs.push_back(ipc::value(obs_source_get_id(source)));
+		inputs.push_back(ipc::value(obs_data_get_full_json(settings)));
+		inputs.push_back(ipc::value(obs_source_get_audio_mixers(source)));
+		inputs.push_back(ipc::value((uint32_t)obs_source_get_deinterlace_mode(source)));
+		inputs.push_back(ipc::value((uint32_t)obs_source_get_deinterlace_field_order(source)));
+		inputs.push_back(ipc::value((uint32_t)obs_source_muted(source)));
+		inputs.push_back(ipc::value(double(createTimes[idx]) / 1000000.0));
+		obs_data_release(settings);
+		inputCount++;
+
+		obs_data_release(info);
+	}
+
+	// Scenes and their items, once every source they may reference exists
+	obs_data_array_t *sceneInfos = obs_data_get_array(collection, "scenes");
+	uint32_t sceneTotal = (uint32_t)obs_data_array_count(sceneInfos);
+	for (size_t idx = 0; idx < sceneTotal; idx++) {
+		obs_data_t *info = obs_data_array_item(sceneInfos, idx);
+		const char *name = obs_data_get_string(info, "name");
+
+		// An existing scene is addressed by uid, a name only creates a scene when nothing else uses it yet
+		obs_source_t *sceneSource = nullptr;
+		obs_scene_t *scene = nullptr;
+		bool created = false;
+		if (obs_data_has_user_value(info, "sceneId")) {
+			sceneSource = osn::Source::Manager::GetInstance().find((uint64_t)obs_data_get_int(info, "sceneId"));
+			scene = obs_scene_from_source(sceneSource);
+		} else {
+			sceneSource = obs_get_source_by_name(name);
+			if (sceneSource) {
+				scene = obs_scene_from_source(sceneSource);
+				obs_source_release(sceneSource);
+			} else {
+				scene = obs_scene_create(name);
+				sceneSource = obs_scene_get_source(scene);
+				created = true;
+			}
+		}
+
+		uint64_t sceneUid = scene ? osn::Source::Manager::GetInstance().find(sceneSource) : UINT64_MAX;
+		if (sceneUid == UINT64_MAX) {
+			blog(LOG_WARNING, "Collection: failed to create scene '%s'", name);
+			if (created)
+				obs_scene_release(scene);
+			failed.push_back(name);
+
+			scenes.push_back(ipc::value(sceneUid));
+			scenes.push_back(ipc::value(name));
+			scenes.push_back(ipc::value((uint32_t)0));
+			obs_data_release(info);
+			continue;
+		}
+		name = obs_source_get_name(sceneSource);
+
+		obs_video_info *canvas = nullptr;
+		if (obs_data_has_user_value(info, "canvasId")) {
+			canvas = osn::Video::Manager::GetInstance().find((uint64_t)obs_data_get_int(info, "canvasId"));
+			if (!canvas)
+				blog(LOG_WARNING, "Collection: canvas of scene '%s' is not valid, using the default one", name);
+		}
+
+		std::vector<ipc::value> items;
+		obs_data_array_t *itemInfos = obs_data_get_array(info, "items");
+		uint32_t itemCount = (uint32_t)obs_data_array_count(itemInfos);
+		for (size_t itemIdx = 0; itemIdx < itemCount; itemIdx++) {
+			obs_data_t *itemInfo = obs_data_array_item(itemInfos, itemIdx);
+			const char *sourceName = obs_data_get_string(itemInfo, "name");
+
+			obs_source_t *source = obs_get_source_by_name(sourceName);
+			obs_sceneitem_t *item = source ? AddItem(scene, source, itemInfo, canvas) : nullptr;
+			obs_source_release(source);
+
+			uint64_t itemUid = item ? osn::SceneItem::Manager::GetInstance().allocate(item) : UINT64_MAX;
+			if (itemUid == UINT64_MAX) {
+				blog(LOG_WARNING, "Collection: failed to add '%s' to scene '%s'", sourceName, name);
+				if (item)
+					obs_sceneitem_remove(item);
+				failed.push_back(sourceName);
+
+				items.push_back(ipc::value(itemUid));
+				items.push_back(ipc::value((int64_t)0));
+				items.push_back(ipc::value((uint32_t)itemIdx));
+				obs_data_release(itemInfo);
+				continue;
+			}
+			obs_sceneitem_addref(item);
+
+			items.push_back(ipc::value(itemUid));
+			items.push_back(ipc::value(obs_sceneitem_get_id(item)));
+			items.push_back(ipc::value((uint32_t)itemIdx));
+
+			obs_data_release(itemInfo);
+		}
+		obs_data_array_release(itemInfos);
+
+		scenes.push_back(ipc::value(sceneUid));
+		scenes.push_back(ipc::value(name));
+		scenes.push_back(ipc::value(itemCount));
+		scenes.insert(scenes.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+		sceneCount++;
+
+		obs_data_release(info);
+	}
+	obs_data_array_release(sceneInfos);
+	obs_data_release(collection);
+
+	osn::RenderCache::Refresh();
+
+	uint64_t loadEnd = os_gettime_ns();
+	blog(LOG_INFO, "Collection: loaded %u inputs and %u scenes in %.3f ms (construction %.3f ms with %u workers), %zu failed", inputCount,
+	     sceneCount, double(loadEnd - loadStart) / 1000000.0, double(createEnd - loadStart) / 1000000.0, std::max(workers, 1u), failed.size());
+
+	rval.reserve(4 + inputs.size() + scenes.size() + failed.size());
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)sourceInfos.size()));
+	rval.insert(rval.end(), std::make_move_iterator(inputs.begin()), std::make_move_iterator(inputs.end()));
+	rval.push_back(ipc::value(sceneTotal));
+	rval.insert(rval.end(), std::make_move_iterator(scenes.begin()), std::make_move_iterator(scenes.end()));
+	rval.push_back(ipc::value((uint32_t)failed.size()));
+	for (auto &name : failed)
+		rval.push_back(ipc::value(name));
+	AUTO_DEBUG;
+}
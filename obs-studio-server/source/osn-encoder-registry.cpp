@@ -0,0 +1,223 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-encoder-registry.hpp"
+
+std::mutex osn::EncoderRegistry::mtx;
+std::map<obs_encoder_t *, osn::EncoderRegistry::Entry> osn::EncoderRegistry::entries;
+std::map<std::pair<osn::OutputSignals *, obs_encoder_t *>, obs_encoder_t *> osn::EncoderRegistry::duplicates;
+bool osn::EncoderRegistry::enabled = true;
+
+std::string osn::EncoderRegistry::Fingerprint(obs_encoder_t *encoder)
+{
+	std::string fingerprint = obs_encoder_get_id(encoder);
+
+	obs_data_t *settings = obs_encoder_get_settings(encoder);
+	const char *json = obs_data_get_json(settings);
+	fingerprint += '|';
+	fingerprint += json ? json : "";
+	obs_data_release(settings);
+
+	char source[128];
+	if (obs_encoder_get_type(encoder) == OBS_ENCODER_VIDEO) {
+		snprintf(source, sizeof(source), "|video:%p:%ux%u:%d", (void *)obs_encoder_video(encoder), obs_encoder_get_width(encoder),
+			 obs_encoder_get_height(encoder), (int)obs_encoder_get_preferred_video_format(encoder));
+	} else {
+		snprintf(source, sizeof(source), "|audio:%p:%zu:%u", (void *)obs_encoder_audio(encoder), obs_encoder_get_mixer_index(encoder),
+			 obs_encoder_get_sample_rate(encoder));
+	}
+	fingerprint += source;
+	return fingerprint;
+}
+
+void osn::EncoderRegistry::Unbind(const std::pair<OutputSignals *, size_t> &binding)
+{
+	for (auto it = entries.begin(); it != entries.end(); it++) {
+		if (!it->second.users.erase(binding))
+			continue;
+
+		obs_encoder_t *encoder = it->first;
+		if (it->second.users.empty())
+			entries.erase(it);
+		obs_encoder_release(encoder);
+		return;
+	}
+}
+
+obs_encoder_t *osn::EncoderRegistry::Acquire(OutputSignals *user, obs_encoder_t *encoder, size_t slot)
+{
+	if (!encoder)
+		return nullptr;
+
+	std::unique_lock<std::mutex> lock(mtx);
+	auto binding = std::make_pair(user, slot);
+	Unbind(binding);
+
+	auto duplicate = duplicates.find(std::make_pair(user, encoder));
+	if (duplicate != duplicates.end())
+		encoder = duplicate->second;
+
+	if (!enabled)
+		return encoder;
+
+	// An encoder that is already running keeps its settings, so it only ever matches itself
+	std::string fingerprint = Fingerprint(encoder);
+	obs_encoder_t *bound = encoder;
+	if (!obs_encoder_active(encoder)) {
+		for (auto &entry : entries) {
+			if (entry.first != encoder && entry.second.fingerprint == fingerprint && obs_encoder_active(entry.first)) {
+				bound = entry.first;
+				blog(LOG_INFO, "Sharing encoder '%s' instead of '%s'", obs_encoder_get_name(bound), obs_encoder_get_name(encoder));
+				break;
+			}
+		}
+	}
+
+	Entry &entry = entries[bound];
+	entry.fingerprint = fingerprint;
+	entry.users.insert(binding);
+
+	// Keeps the shared encoder alive if its owner releases it while other outputs still encode with it
+	return obs_encoder_get_ref(bound);
+}
+
+void osn::EncoderRegistry::Release(OutputSignals *user)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	for (auto it = entries.begin(); it != entries.end();) {
+		obs_encoder_t *encoder = it->first;
+		size_t removed = 0;
+		for (auto binding = it->second.users.begin(); binding != it->second.users.end();) {
+			if (binding->first == user) {
+				binding = it->second.users.erase(binding);
+				removed++;
+			} else {
+				binding++;
+			}
+		}
+
+		if (it->second.users.empty())
+			it = entries.erase(it);
+		else
+			it++;
+
+		while (removed--)
+			obs_encoder_release(encoder);
+	}
+}
+
+bool osn::EncoderRegistry::SharedWithOthers(OutputSignals *user, obs_encoder_t *encoder)
+{
+	auto entry = entries.find(encoder);
+	if (entry == entries.end() || !obs_encoder_active(encoder))
+		return false;
+
+	for (auto &binding : entry->second.users) {
+		if (binding.first != user)
+			return true;
+	}
+	return false;
+}
+
+obs_encoder_t *osn::EncoderRegistry::Duplicate(obs_encoder_t *encoder)
+{
+	std::string name = obs_encoder_get_name(encoder);
+	name += "-duplicate";
+
+	obs_data_t *settings = obs_encoder_get_settings(encoder);
+	obs_encoder_t *duplicate = nullptr;
+	if (obs_encoder_get_type(encoder) == OBS_ENCODER_AUDIO) {
+		duplicate = obs_audio_encoder_create(obs_encoder_get_id(encoder), name.c_str(), settings, obs_encoder_get_mixer_index(encoder), nullptr);
+		if (duplicate)
+			obs_encoder_set_audio(duplicate, obs_encoder_audio(encoder));
+	} else {
+		duplicate = obs_video_encoder_create(obs_encoder_get_id(encoder), name.c_str(), settings, nullptr);
+		if (duplicate) {
+			obs_encoder_set_video(duplicate, obs_encoder_video(encoder));
+			obs_encoder_set_preferred_video_format(duplicate, obs_encoder_get_preferred_video_format(encoder));
+			if (obs_encoder_scaling_enabled(encoder))
+				obs_encoder_set_scaled_size(duplicate, obs_encoder_get_width(encoder), obs_encoder_get_height(encoder));
+		}
+	}
+	obs_data_release(settings);
+	return duplicate;
+}
+
+obs_encoder_t *osn::EncoderRegistry::Unshare(OutputSignals *user, obs_encoder_t *encoder)
+{
+	if (!encoder)
+		return nullptr;
+
+	std::unique_lock<std::mutex> lock(mtx);
+	auto key = std::make_pair(user, encoder);
+	auto duplicate = duplicates.find(key);
+
+	// Updating, rescaling or moving a running encoder would change the other output's encode
+	if (!SharedWithOthers(user, encoder)) {
+		if (duplicate != duplicates.end()) {
+			obs_encoder_release(duplicate->second);
+			duplicates.erase(duplicate);
+		}
+		return encoder;
+	}
+
+	if (duplicate != duplicates.end())
+		return duplicate->second;
+
+	obs_encoder_t *created = Duplicate(encoder);
+	if (!created) {
+		blog(LOG_WARNING, "Failed to duplicate shared encoder '%s'", obs_encoder_get_name(encoder));
+		return encoder;
+	}
+
+	blog(LOG_INFO, "Encoder '%s' is still shared, reconfiguring '%s' instead", obs_encoder_get_name(encoder), obs_encoder_get_name(created));
+	duplicates[key] = created;
+	return created;
+}
+
+obs_encoder_t *osn::EncoderRegistry::Configured(OutputSignals *user, obs_encoder_t *encoder)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	auto duplicate = duplicates.find(std::make_pair(user, encoder));
+	return duplicate != duplicates.end() ? duplicate->second : encoder;
+}
+
+void osn::EncoderRegistry::Forget(OutputSignals *user)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	for (auto it = duplicates.begin(); it != duplicates.end();) {
+		if (it->first.first != user) {
+			it++;
+			continue;
+		}
+		obs_encoder_release(it->second);
+		it = duplicates.erase(it);
+	}
+}
+
+void osn::EncoderRegistry::SetEnabled(bool value)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	enabled = value;
+}
+
+bool osn::EncoderRegistry::Enabled()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	return enabled;
+}
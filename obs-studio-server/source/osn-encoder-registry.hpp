@@ -0,0 +1,75 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace osn {
+class OutputSignals;
+
+// Lets outputs with identical encoder configurations share one running encoder.
+// The configuration is fingerprinted when an output starts: encoder id,
+// settings, the video mix or audio track it reads from and the scaled size.
+// When another output already runs an encoder with the same fingerprint, that
+// encoder is bound instead of the output's own, otherwise the output keeps its
+// own one. Outputs whose settings changed since no longer match and are split
+// off on their next start. An output whose own encoder still runs for another
+// output configures and binds a private duplicate instead, see Unshare.
+class EncoderRegistry {
+public:
+	// Returns the encoder to bind for this output and slot (video or audio track index)
+	static obs_encoder_t *Acquire(OutputSignals *user, obs_encoder_t *encoder, size_t slot = VIDEO_SLOT);
+	static void Release(OutputSignals *user);
+
+	// Returns the encoder an output may reconfigure before it starts. That is its own one, unless
+	// another output still encodes with it, then it is a duplicate the registry keeps for the output
+	// while the sharing lasts. The output's own encoder stays the one the client sees.
+	static obs_encoder_t *Unshare(OutputSignals *user, obs_encoder_t *encoder);
+	// The encoder Unshare last handed out for this output's own one, without creating one
+	static obs_encoder_t *Configured(OutputSignals *user, obs_encoder_t *encoder);
+	// Releases the duplicates kept for an output, called once it is destroyed
+	static void Forget(OutputSignals *user);
+
+	static void SetEnabled(bool enabled);
+	static bool Enabled();
+
+	static const size_t VIDEO_SLOT = SIZE_MAX;
+
+private:
+	struct Entry {
+		std::string fingerprint;
+		std::set<std::pair<OutputSignals *, size_t>> users;
+	};
+
+	static std::string Fingerprint(obs_encoder_t *encoder);
+	static void Unbind(const std::pair<OutputSignals *, size_t> &binding);
+	static bool SharedWithOthers(OutputSignals *user, obs_encoder_t *encoder);
+	static obs_encoder_t *Duplicate(obs_encoder_t *encoder);
+
+	static std::mutex mtx;
+	static std::map<obs_encoder_t *, Entry> entries;
+	// Private duplicates by output and the own encoder they stand in for
+	static std::map<std::pair<OutputSignals *, obs_encoder_t *>, obs_encoder_t *> duplicates;
+	static bool enabled;
+};
+}
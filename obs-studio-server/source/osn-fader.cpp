@@ -20,8 +20,15 @@
 #include "osn-error.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
+#include "osn-batch.hpp"
+#include "osn-audio-math.hpp"
+#include "ipc-pack.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
 
 osn::Fader::Manager &osn::Fader::Manager::GetInstance()
 {
@@ -35,11 +42,16 @@ void osn::Fader::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
-	cls->register_function(std::make_shared<ipc::function>("SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
+	cls->register_function(osn::Batch::Function("Fader", "SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
 	cls->register_function(std::make_shared<ipc::function>("GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
-	cls->register_function(std::make_shared<ipc::function>("SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
+	cls->register_function(osn::Batch::Function("Fader", "SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
 	cls->register_function(std::make_shared<ipc::function>("GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>("SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
+	cls->register_function(osn::Batch::Function("Fader", "SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
+	cls->register_function(std::make_shared<ipc::function>("GetValues", std::vector<ipc::type>{ipc::type::Binary}, GetValues));
+	cls->register_function(
+		std::make_shared<ipc::function>("SetValues", std::vector<ipc::type>{ipc::type::Int32, ipc::type::Binary, ipc::type::Binary}, SetValues));
+	cls->register_function(
+		std::make_shared<ipc::function>("BenchmarkSanitize", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32}, BenchmarkSanitize));
 	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
 	cls->register_function(std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
@@ -180,6 +192,121 @@ void osn::Fader::SetMultiplier(void *data, const int64_t id, const std::vector<i
 	AUTO_DEBUG;
 }
 
+static ipc_pack::FaderValues ReadFader(obs_fader_t *fader)
+{
+	if (!fader)
+		return {-65535.0f, 0.0f, 0.0f};
+	return {obs_fader_get_db(fader), obs_fader_get_deflection(fader), obs_fader_get_mul(fader)};
+}
+
+void osn::Fader::GetValues(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	ipc_pack::Reader uids(args[0]);
+	std::vector<char> &buffer = ipc_pack::Scratch();
+	ipc_pack::Writer values(buffer);
+	values.reserve(uids.remaining() / sizeof(uint64_t) * sizeof(ipc_pack::FaderValues));
+
+	uint64_t uid;
+	while (uids.get(uid))
+		values.put(ReadFader(Manager::GetInstance().find(uid)));
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(values.value());
+	AUTO_DEBUG;
+}
+
+void osn::Fader::SetValues(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	int32_t field = args[0].value_union.i32;
+	if (field < ipc_pack::FaderDeziBel || field > ipc_pack::FaderMultiplier) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Invalid fader field.");
+	}
+
+	std::vector<uint64_t> uids(args[1].value_bin.size() / sizeof(uint64_t));
+	ipc_pack::Reader(args[1]).get(uids.data(), uids.size());
+	std::vector<float> input(args[2].value_bin.size() / sizeof(float));
+	ipc_pack::Reader(args[2]).get(input.data(), input.size());
+	if (input.size() != uids.size()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Fader and value counts differ.");
+	}
+
+	// Keep infinities and NaN away from libobs, they would stick in the fader state
+	if (field == ipc_pack::FaderDeziBel)
+		audio_math::SanitizeLevels(input.data(), input.size());
+	else
+		audio_math::Sanitize(input.data(), input.size(), 1.0f, 0.0f);
+
+	std::vector<char> &buffer = ipc_pack::Scratch();
+	ipc_pack::Writer values(buffer);
+	values.reserve(uids.size() * sizeof(ipc_pack::FaderValues));
+
+	for (size_t i = 0; i < uids.size(); i++) {
+		obs_fader_t *fader = Manager::GetInstance().find(uids[i]);
+		if (fader) {
+			switch (field) {
+			case ipc_pack::FaderDeziBel:
+				obs_fader_set_db(fader, input[i]);
+				break;
+			case ipc_pack::FaderDeflection:
+				obs_fader_set_deflection(fader, input[i]);
+				break;
+			case ipc_pack::FaderMultiplier:
+				obs_fader_set_mul(fader, input[i]);
+				break;
+			}
+		}
+		values.put(ReadFader(fader));
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(values.value());
+	AUTO_DEBUG;
+}
+
+void osn::Fader::BenchmarkSanitize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	uint32_t count = args[0].value_union.ui32;
+	uint32_t iterations = args[1].value_union.ui32;
+
+	// Levels as a meter reports them, with a few silent and clipped channels mixed in
+	std::vector<float> levels(count);
+	std::mt19937 random(count);
+	std::uniform_real_distribution<float> distribution(-96.0f, 0.0f);
+	for (size_t i = 0; i < count; i++) {
+		switch (i % 16) {
+		case 3:
+			levels[i] = -INFINITY;
+			break;
+		case 11:
+			levels[i] = NAN;
+			break;
+		default:
+			levels[i] = distribution(random);
+		}
+	}
+
+	auto run = [&](void (*kernel)(float *, size_t, float, float), std::vector<float> &work) {
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < iterations; i++) {
+			std::copy(levels.begin(), levels.end(), work.begin());
+			kernel(work.data(), work.size(), 0.0f, -65535.0f);
+		}
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	};
+
+	std::vector<float> scalar(count), simd(count);
+	uint64_t scalarNs = run(audio_math::SanitizeScalar, scalar);
+	uint64_t simdNs = run(audio_math::Sanitize, simd);
+	if (memcmp(scalar.data(), simd.data(), count * sizeof(float)) != 0) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Vector and scalar kernels disagree.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(scalarNs));
+	rval.push_back(ipc::value(simdNs));
+	AUTO_DEBUG;
+}
+
 void osn::Fader::Attach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	auto uid_fader = args[0].value_union.ui64;
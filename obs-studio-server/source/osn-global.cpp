@@ -19,6 +19,8 @@
 #include "osn-global.hpp"
 #include <osn-error.hpp>
 #include <obs.h>
+#include "osn-encoder-registry.hpp"
+#include "osn-output-reaper.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -35,6 +37,11 @@ void osn::Global::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("SetLocale", std::vector<ipc::type>{ipc::type::String}, SetLocale));
 	cls->register_function(std::make_shared<ipc::function>("GetMultipleRendering", std::vector<ipc::type>{}, GetMultipleRendering));
 	cls->register_function(std::make_shared<ipc::function>("SetMultipleRendering", std::vector<ipc::type>{ipc::type::Int32}, SetMultipleRendering));
+	cls->register_function(std::make_shared<ipc::function>("GetOutputStopDeadline", std::vector<ipc::type>{}, GetOutputStopDeadline));
+	cls->register_function(std::make_shared<ipc::function>("SetOutputStopDeadline", std::vector<ipc::type>{ipc::type::UInt32}, SetOutputStopDeadline));
+	cls->register_function(std::make_shared<ipc::function>("GetPendingOutputs", std::vector<ipc::type>{}, GetPendingOutputs));
+	cls->register_function(std::make_shared<ipc::function>("GetEncoderSharing", std::vector<ipc::type>{}, GetEncoderSharing));
+	cls->register_function(std::make_shared<ipc::function>("SetEncoderSharing", std::vector<ipc::type>{ipc::type::Int32}, SetEncoderSharing));
 	srv.register_collection(cls);
 }
 
@@ -139,3 +146,38 @@ void osn::Global::SetMultipleRendering(void *data, const int64_t id, const std::
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
+
+void osn::Global::GetOutputStopDeadline(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::OutputReaper::Deadline()));
+	AUTO_DEBUG;
+}
+
+void osn::Global::SetOutputStopDeadline(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::OutputReaper::SetDeadline(args[0].value_union.ui32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Global::GetPendingOutputs(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)osn::OutputReaper::Pending()));
+	AUTO_DEBUG;
+}
+
+void osn::Global::GetEncoderSharing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::EncoderRegistry::Enabled()));
+	AUTO_DEBUG;
+}
+
+void osn::Global::SetEncoderSharing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::EncoderRegistry::SetEnabled(args[0].value_union.i32);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
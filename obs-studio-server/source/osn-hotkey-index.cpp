@@ -0,0 +1,229 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-hotkey-index.hpp"
+#include <algorithm>
+#include <obs.hpp>
+
+std::mutex osn::HotkeyIndex::mtx;
+std::map<obs_hotkey_id, osn::HotkeyIndex::Hotkey> osn::HotkeyIndex::hotkeys;
+std::deque<std::pair<obs_hotkey_id, uint64_t>> osn::HotkeyIndex::removed;
+uint64_t osn::HotkeyIndex::revision = 0;
+uint64_t osn::HotkeyIndex::horizon = 0;
+bool osn::HotkeyIndex::stale = false;
+
+bool osn::HotkeyIndex::Describe(obs_hotkey_t *key, Hotkey &hotkey)
+{
+	auto registerer_type = obs_hotkey_get_registerer_type(key);
+	void *registerer = obs_hotkey_get_registerer(key);
+	if (registerer == nullptr)
+		return false;
+
+	// Discover the type of object registered with this hotkey
+	switch (registerer_type) {
+	case OBS_HOTKEY_REGISTERER_NONE:
+	case OBS_HOTKEY_REGISTERER_FRONTEND: {
+		// Ignore any frontend hotkey
+		return false;
+	}
+	case OBS_HOTKEY_REGISTERER_SOURCE: {
+		auto key_source = OBSGetStrongRef(static_cast<obs_weak_source_t *>(registerer));
+		if (key_source == nullptr)
+			return false;
+		hotkey.objectName = obs_source_get_name(key_source);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_OUTPUT: {
+		auto key_output = OBSGetStrongRef(static_cast<obs_weak_output_t *>(registerer));
+		if (key_output == nullptr)
+			return false;
+		hotkey.objectName = obs_output_get_name(key_output);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_ENCODER: {
+		auto key_encoder = OBSGetStrongRef(static_cast<obs_weak_encoder_t *>(registerer));
+		if (key_encoder == nullptr)
+			return false;
+		hotkey.objectName = obs_encoder_get_name(key_encoder);
+		break;
+	}
+	case OBS_HOTKEY_REGISTERER_SERVICE: {
+		auto key_service = OBSGetStrongRef(static_cast<obs_weak_service_t *>(registerer));
+		if (key_service == nullptr)
+			return false;
+		hotkey.objectName = obs_service_get_name(key_service);
+		break;
+	}
+	}
+	hotkey.objectType = registerer_type;
+
+	const char *key_name = obs_hotkey_get_name(key);
+	const char *desc = obs_hotkey_get_description(key);
+	if (!key_name)
+		return false;
+
+	// Parse the key name and the description
+	hotkey.hotkeyName = key_name;
+	hotkey.hotkeyName.erase(0, hotkey.hotkeyName.find_first_of(".") + 1);
+	std::replace(hotkey.hotkeyName.begin(), hotkey.hotkeyName.end(), '-', '_');
+	std::transform(hotkey.hotkeyName.begin(), hotkey.hotkeyName.end(), hotkey.hotkeyName.begin(), ::toupper);
+
+	hotkey.hotkeyDesc = desc ? desc : "";
+	// Descriptions keep their case, the old title casing never changed them
+	std::replace(hotkey.hotkeyDesc.begin(), hotkey.hotkeyDesc.end(), '-', ' ');
+
+	hotkey.hotkeyId = obs_hotkey_get_id(key);
+	return true;
+}
+
+void osn::HotkeyIndex::OnRegister(void *data, calldata_t *cd)
+{
+	obs_hotkey_t *key = static_cast<obs_hotkey_t *>(calldata_ptr(cd, "key"));
+	Hotkey hotkey;
+	if (!key || !Describe(key, hotkey))
+		return;
+
+	std::lock_guard<std::mutex> lock(mtx);
+	hotkey.revision = ++revision;
+	hotkeys[hotkey.hotkeyId] = std::move(hotkey);
+}
+
+void osn::HotkeyIndex::OnUnregister(void *data, calldata_t *cd)
+{
+	obs_hotkey_t *key = static_cast<obs_hotkey_t *>(calldata_ptr(cd, "key"));
+	if (!key)
+		return;
+
+	obs_hotkey_id id = obs_hotkey_get_id(key);
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!hotkeys.erase(id))
+		return;
+
+	removed.emplace_back(id, ++revision);
+	if (removed.size() > MAX_REMOVED) {
+		horizon = removed.front().second;
+		removed.pop_front();
+	}
+}
+
+void osn::HotkeyIndex::OnRename(void *data, calldata_t *cd)
+{
+	// Scene item hotkeys carry the source name in their description too
+	std::lock_guard<std::mutex> lock(mtx);
+	stale = true;
+}
+
+void osn::HotkeyIndex::RefreshNames()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (!stale)
+			return;
+		stale = false;
+	}
+
+	// Enumerating takes the libobs hotkey lock, which the signals above are
+	// emitted under, so the index lock must not be held meanwhile
+	std::vector<Hotkey> current;
+	obs_enum_hotkeys(
+		[](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
+			Hotkey hotkey;
+			if (Describe(key, hotkey))
+				static_cast<std::vector<Hotkey> *>(data)->push_back(std::move(hotkey));
+			return true;
+		},
+		&current);
+
+	// Registration stays with the signals, only names of known hotkeys are updated
+	std::lock_guard<std::mutex> lock(mtx);
+	for (auto &hotkey : current) {
+		auto found = hotkeys.find(hotkey.hotkeyId);
+		if (found == hotkeys.end())
+			continue;
+		if (found->second.objectName == hotkey.objectName && found->second.hotkeyDesc == hotkey.hotkeyDesc)
+			continue;
+
+		found->second.objectName = std::move(hotkey.objectName);
+		found->second.hotkeyDesc = std::move(hotkey.hotkeyDesc);
+		found->second.revision = ++revision;
+	}
+}
+
+void osn::HotkeyIndex::Start()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "hotkey_register", OnRegister, nullptr);
+	signal_handler_connect(sh, "hotkey_unregister", OnUnregister, nullptr);
+	signal_handler_connect(sh, "source_rename", OnRename, nullptr);
+
+	// Pick up anything registered before the signals were connected
+	std::vector<Hotkey> current;
+	obs_enum_hotkeys(
+		[](void *data, obs_hotkey_id id, obs_hotkey_t *key) {
+			Hotkey hotkey;
+			if (Describe(key, hotkey))
+				static_cast<std::vector<Hotkey> *>(data)->push_back(std::move(hotkey));
+			return true;
+		},
+		&current);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	for (auto &hotkey : current) {
+		if (hotkeys.count(hotkey.hotkeyId))
+			continue;
+		hotkey.revision = ++revision;
+		hotkeys[hotkey.hotkeyId] = std::move(hotkey);
+	}
+}
+
+void osn::HotkeyIndex::Stop()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "hotkey_register", OnRegister, nullptr);
+	signal_handler_disconnect(sh, "hotkey_unregister", OnUnregister, nullptr);
+	signal_handler_disconnect(sh, "source_rename", OnRename, nullptr);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	hotkeys.clear();
+	removed.clear();
+	horizon = revision;
+}
+
+osn::HotkeyIndex::Changes osn::HotkeyIndex::Query(uint64_t since)
+{
+	RefreshNames();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	Changes changes;
+	changes.revision = revision;
+	changes.reset = since == 0 || since < horizon || since > revision;
+	if (changes.reset) {
+		since = 0;
+	} else {
+		for (auto &entry : removed) {
+			if (entry.second > since)
+				changes.removed.push_back(entry.first);
+		}
+	}
+
+	for (auto &entry : hotkeys) {
+		if (entry.second.revision > since)
+			changes.hotkeys.push_back(entry.second);
+	}
+	return changes;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osn {
+// Keeps the hotkey list the frontend shows up to date from the libobs
+// hotkey_register and hotkey_unregister signals, so a query no longer walks
+// and formats every hotkey. Every change bumps a revision number and the
+// client asks only for what changed since the revision it last saw. Renamed
+// sources mark the names stale, they are refreshed on the next query.
+class HotkeyIndex {
+public:
+	struct Hotkey {
+		std::string objectName;
+		obs_hotkey_registerer_type objectType;
+		std::string hotkeyName;
+		std::string hotkeyDesc;
+		obs_hotkey_id hotkeyId;
+		uint64_t revision;
+	};
+
+	struct Changes {
+		uint64_t revision;
+		// Set when the caller's revision is too old or unknown, hotkeys then holds everything
+		bool reset;
+		std::vector<obs_hotkey_id> removed;
+		std::vector<Hotkey> hotkeys;
+	};
+
+	static void Start();
+	static void Stop();
+
+	static Changes Query(uint64_t since);
+
+	static const size_t MAX_REMOVED = 4096;
+
+private:
+	static bool Describe(obs_hotkey_t *key, Hotkey &hotkey);
+	static void RefreshNames();
+
+	static void OnRegister(void *data, calldata_t *cd);
+	static void OnUnregister(void *data, calldata_t *cd);
+	static void OnRename(void *data, calldata_t *cd);
+
+	static std::mutex mtx;
+	static std::map<obs_hotkey_id, Hotkey> hotkeys;
+	static std::deque<std::pair<obs_hotkey_id, uint64_t>> removed;
+	static uint64_t revision;
+	// Oldest revision the removal log still covers
+	static uint64_t horizon;
+	static bool stale;
+};
+}
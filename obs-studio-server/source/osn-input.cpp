@@ -23,6 +23,8 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "osn-source.hpp"
+#include "osn-batch.hpp"
+#include "osn-render-cache.hpp"
 #include "shared.hpp"
 
 void osn::Input::Register(ipc::server &srv)
@@ -49,7 +51,7 @@ void osn::Input::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
 	cls->register_function(std::make_shared<ipc::function>("GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
 	cls->register_function(std::make_shared<ipc::function>("GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
-	cls->register_function(std::make_shared<ipc::function>("SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
+	cls->register_function(osn::Batch::Function("Input", "SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
 	cls->register_function(std::make_shared<ipc::function>("GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
 	cls->register_function(std::make_shared<ipc::function>("SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
 	cls->register_function(std::make_shared<ipc::function>("GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
@@ -560,6 +562,7 @@ void osn::Input::CopyFiltersTo(void *data, const int64_t id, const std::vector<i
 	}
 
 	obs_source_copy_filters(input_to, input_from);
+	osn::RenderCache::StripCopies(input_to);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
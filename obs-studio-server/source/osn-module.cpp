@@ -17,9 +17,227 @@
 ******************************************************************************/
 
 #include "osn-module.hpp"
+#include <sys/stat.h>
+#include <util/platform.h>
+#include <util/profiler.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
 #include "osn-error.hpp"
 #include "shared.hpp"
 
+#define PREOPEN_WORKERS 8
+#define SLOW_MODULE_NS 100000000ULL
+
+struct ModuleLoadInfo {
+	std::string binPath;
+	std::string dataPath;
+	int64_t modified = 0;
+	int64_t size = 0;
+	uint64_t openNs = 0;
+	uint64_t initNs = 0;
+	bool loaded = false;
+	// Binary is unchanged since the previous run wrote the cache
+	bool cached = false;
+};
+
+static std::mutex loadInfosMtx;
+static std::vector<ModuleLoadInfo> loadInfos;
+
+static ModuleLoadInfo &FindLoadInfo(const std::string &binPath)
+{
+	for (auto &info : loadInfos) {
+		if (info.binPath == binPath)
+			return info;
+	}
+
+	loadInfos.emplace_back();
+	loadInfos.back().binPath = binPath;
+	return loadInfos.back();
+}
+
+static std::map<std::string, ModuleLoadInfo> ReadCache(const std::string &path)
+{
+	std::map<std::string, ModuleLoadInfo> cache;
+
+	obs_data_t *data = obs_data_create_from_json_file_safe(path.c_str(), "bak");
+	if (!data)
+		return cache;
+
+	obs_data_array_t *modules = obs_data_get_array(data, "modules");
+	for (size_t idx = 0; idx < obs_data_array_count(modules); idx++) {
+		obs_data_t *module = obs_data_array_item(modules, idx);
+
+		ModuleLoadInfo info;
+		info.binPath = obs_data_get_string(module, "binPath");
+		info.modified = obs_data_get_int(module, "modified");
+		info.size = obs_data_get_int(module, "size");
+		info.loaded = obs_data_get_bool(module, "loaded");
+
+		cache[info.binPath] = info;
+		obs_data_release(module);
+	}
+	obs_data_array_release(modules);
+	obs_data_release(data);
+
+	return cache;
+}
+
+static void WriteCache(const std::string &path, const std::vector<ModuleLoadInfo> &infos)
+{
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *modules = obs_data_array_create();
+
+	for (auto &info : infos) {
+		obs_data_t *module = obs_data_create();
+		obs_data_set_string(module, "binPath", info.binPath.c_str());
+		obs_data_set_int(module, "modified", info.modified);
+		obs_data_set_int(module, "size", info.size);
+		obs_data_set_bool(module, "loaded", info.loaded);
+		obs_data_set_double(module, "initTime", double(info.initNs) / 1000000.0);
+
+		obs_data_array_push_back(modules, module);
+		obs_data_release(module);
+	}
+
+	obs_data_set_array(data, "modules", modules);
+	if (!obs_data_save_json_safe(data, path.c_str(), "tmp", "bak"))
+		blog(LOG_WARNING, "Failed to save module cache %s", path.c_str());
+
+	obs_data_array_release(modules);
+	obs_data_release(data);
+}
+
+// libobs records the time of each obs_init_module call while the profiler runs, in microseconds
+static bool CollectInitTimes(void *param, profiler_snapshot_entry_t *entry)
+{
+	std::map<std::string, uint64_t> &initTimes = *static_cast<std::map<std::string, uint64_t> *>(param);
+	static const std::string prefix = "obs_init_module(";
+
+	const char *name = profiler_snapshot_entry_name(entry);
+	std::string entryName = name ? name : "";
+	if (entryName.size() > prefix.size() && entryName.compare(0, prefix.size(), prefix) == 0 && entryName.back() == ')') {
+		std::string file = entryName.substr(prefix.size(), entryName.size() - prefix.size() - 1);
+		initTimes[file] = profiler_snapshot_entry_max_time(entry) * 1000;
+	}
+
+	profiler_snapshot_enumerate_children(entry, CollectInitTimes, param);
+	return true;
+}
+
+void osn::Module::LoadAll(const std::string &cachePath, struct obs_module_failure_info *mfi)
+{
+	uint64_t loadStart = os_gettime_ns();
+
+	std::vector<ModuleLoadInfo> infos;
+	obs_find_modules2(
+		[](void *param, const struct obs_module_info2 *module) {
+			std::vector<ModuleLoadInfo> &infos = *static_cast<std::vector<ModuleLoadInfo> *>(param);
+			ModuleLoadInfo info;
+			info.binPath = module->bin_path;
+			info.dataPath = module->data_path;
+			infos.push_back(info);
+		},
+		&infos);
+
+	std::map<std::string, ModuleLoadInfo> cache = ReadCache(cachePath);
+
+	/* Stat every binary and map the ones that loaded fine last run while unchanged, on a bounded
+	 * pool. The OS loader is thread safe, so doing this concurrently is fine. Registering the module
+	 * with libobs and calling its load function is not, the type registries are not synchronized,
+	 * so that still happens one module at a time in obs_load_all_modules2 which finds the binaries
+	 * already mapped. Unknown or changed binaries go through the libobs plugin checks first. */
+	std::vector<void *> handles(infos.size(), nullptr);
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		for (size_t idx = next++; idx < infos.size(); idx = next++) {
+			ModuleLoadInfo &info = infos[idx];
+
+			struct stat st;
+			if (os_stat(info.binPath.c_str(), &st) != 0)
+				continue;
+			info.modified = (int64_t)st.st_mtime;
+			info.size = (int64_t)st.st_size;
+
+			auto cached = cache.find(info.binPath);
+			if (cached == cache.end() || cached->second.modified != info.modified || cached->second.size != info.size)
+				continue;
+
+			info.cached = true;
+			if (!cached->second.loaded)
+				continue;
+
+			uint64_t openStart = os_gettime_ns();
+			handles[idx] = os_dlopen(info.binPath.c_str());
+			info.openNs = os_gettime_ns() - openStart;
+		}
+	};
+
+	uint32_t workers = std::min<uint32_t>(std::max(std::thread::hardware_concurrency(), 1u), PREOPEN_WORKERS);
+	workers = std::min<uint32_t>(workers, (uint32_t)std::max<size_t>(infos.size(), 1));
+	std::vector<std::thread> pool;
+	for (uint32_t idx = 1; idx < workers; idx++)
+		pool.emplace_back(worker);
+	worker();
+	for (auto &thread : pool)
+		thread.join();
+
+	uint64_t scanEnd = os_gettime_ns();
+
+	profiler_start();
+	obs_load_all_modules2(mfi);
+	profiler_stop();
+
+	std::map<std::string, uint64_t> initTimes;
+	profiler_snapshot_t *snapshot = profile_snapshot_create();
+	profiler_snapshot_enumerate_roots(snapshot, CollectInitTimes, &initTimes);
+	profile_snapshot_free(snapshot);
+
+	// libobs holds its own reference to every module it kept
+	size_t preopened = 0;
+	for (void *handle : handles) {
+		if (handle) {
+			os_dlclose(handle);
+			preopened++;
+		}
+	}
+
+	std::map<std::string, obs_module_t *> loaded;
+	obs_enum_modules(
+		[](void *param, obs_module_t *module) {
+			std::map<std::string, obs_module_t *> &loaded = *static_cast<std::map<std::string, obs_module_t *> *>(param);
+			const char *binPath = obs_get_module_binary_path(module);
+			if (binPath)
+				loaded[binPath] = module;
+		},
+		&loaded);
+
+	for (auto &info : infos) {
+		auto module = loaded.find(info.binPath);
+		if (module == loaded.end())
+			continue;
+
+		info.loaded = true;
+		const char *file = obs_get_module_file_name(module->second);
+		auto initTime = initTimes.find(file ? file : "");
+		if (initTime != initTimes.end())
+			info.initNs = initTime->second;
+
+		if (info.initNs > SLOW_MODULE_NS)
+			blog(LOG_INFO, "Module %s took %.1f ms to initialize", info.binPath.c_str(), double(info.initNs) / 1000000.0);
+	}
+
+	WriteCache(cachePath, infos);
+
+	blog(LOG_INFO, "Modules: loaded %zu of %zu in %.1f ms (scan %.1f ms, %zu preopened on %u workers)", loaded.size(), infos.size(),
+	     double(os_gettime_ns() - loadStart) / 1000000.0, double(scanEnd - loadStart) / 1000000.0, preopened, workers);
+
+	std::unique_lock<std::mutex> ulock(loadInfosMtx);
+	loadInfos = std::move(infos);
+}
+
 void osn::Module::Register(ipc::server &srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Module");
@@ -27,6 +245,7 @@ void osn::Module::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Open", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Open));
 	cls->register_function(std::make_shared<ipc::function>("Modules", std::vector<ipc::type>{}, Modules));
 	cls->register_function(std::make_shared<ipc::function>("Initialize", std::vector<ipc::type>{ipc::type::UInt64}, Initialize));
+	cls->register_function(std::make_shared<ipc::function>("LoadTimings", std::vector<ipc::type>{}, LoadTimings));
 	cls->register_function(std::make_shared<ipc::function>("GetName", std::vector<ipc::type>{ipc::type::UInt64}, GetName));
 	cls->register_function(std::make_shared<ipc::function>("GetFileName", std::vector<ipc::type>{ipc::type::UInt64}, GetFileName));
 	cls->register_function(std::make_shared<ipc::function>("GetAuthor", std::vector<ipc::type>{ipc::type::UInt64}, GetAuthor));
@@ -42,14 +261,23 @@ void osn::Module::Open(void *data, const int64_t id, const std::vector<ipc::valu
 {
 	obs_module_t *module;
 
-	const std::string bin_path = args[0].value_str.c_str();
-	const std::string data_path = args[1].value_str.c_str();
+	const std::string &bin_path = args[0].value_str;
+	const std::string &data_path = args[1].value_str;
 
+	uint64_t openStart = os_gettime_ns();
 	int64_t result = obs_open_module(&module, bin_path.c_str(), data_path.c_str());
+	uint64_t openNs = os_gettime_ns() - openStart;
 
 	if (result == MODULE_SUCCESS) {
 		uint64_t uid = osn::Module::Manager::GetInstance().allocate(module);
 
+		{
+			std::unique_lock<std::mutex> ulock(loadInfosMtx);
+			ModuleLoadInfo &info = FindLoadInfo(bin_path);
+			info.dataPath = data_path;
+			info.openNs = openNs;
+		}
+
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		rval.push_back(ipc::value(uid));
 	} else {
@@ -89,8 +317,36 @@ void osn::Module::Initialize(void *data, const int64_t id, const std::vector<ipc
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Module reference is not valid.");
 	}
 
+	uint64_t initStart = os_gettime_ns();
+	bool loaded = obs_init_module(module);
+	uint64_t initNs = os_gettime_ns() - initStart;
+
+	const char *binPath = obs_get_module_binary_path(module);
+	if (binPath) {
+		std::unique_lock<std::mutex> ulock(loadInfosMtx);
+		ModuleLoadInfo &info = FindLoadInfo(binPath);
+		info.initNs = initNs;
+		info.loaded = loaded;
+	}
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_init_module(module)));
+	rval.push_back(ipc::value(loaded));
+	AUTO_DEBUG;
+}
+
+void osn::Module::LoadTimings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(loadInfosMtx);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)loadInfos.size()));
+	for (auto &info : loadInfos) {
+		rval.push_back(ipc::value(info.binPath));
+		rval.push_back(ipc::value(double(info.openNs) / 1000000.0));
+		rval.push_back(ipc::value(double(info.initNs) / 1000000.0));
+		rval.push_back(ipc::value((uint32_t)info.loaded));
+		rval.push_back(ipc::value((uint32_t)info.cached));
+	}
 	AUTO_DEBUG;
 }
 
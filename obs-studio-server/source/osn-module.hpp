@@ -42,10 +42,14 @@ public:
 		static Manager &GetInstance();
 	};
 
+	// Loads every module found in the module paths, metadata is cached at cachePath between runs
+	static void LoadAll(const std::string &cachePath, struct obs_module_failure_info *mfi);
+
 	// Functions
 	static void Open(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Modules(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Initialize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void LoadTimings(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
 	// Methods
 	static void GetName(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
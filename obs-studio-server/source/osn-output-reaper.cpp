@@ -0,0 +1,170 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-output-reaper.hpp"
+#include "osn-output-signals.hpp"
+
+std::mutex osn::OutputReaper::mtx;
+std::list<std::unique_ptr<osn::OutputReaper::Entry>> osn::OutputReaper::entries;
+std::thread osn::OutputReaper::worker;
+bool osn::OutputReaper::running = false;
+bool osn::OutputReaper::closed = false;
+std::atomic<uint32_t> osn::OutputReaper::deadlineMs = osn::OutputReaper::DEFAULT_DEADLINE_MS;
+std::mutex osn::OutputReaper::wakeMtx;
+std::condition_variable osn::OutputReaper::wake;
+
+void osn::OutputReaper::OnStopped(void *data, calldata_t *)
+{
+	Entry *entry = reinterpret_cast<Entry *>(data);
+	std::unique_lock<std::mutex> lock(wakeMtx);
+	entry->stopped = true;
+	wake.notify_one();
+}
+
+void osn::OutputReaper::Retire(obs_output_t *output, OutputSignals *owner, std::vector<cbData *> &&callbacks)
+{
+	bool isClosed;
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		isClosed = closed;
+	}
+
+	// Nothing is left to wait for the output after shutdown
+	if (isClosed) {
+		DisconnectSignals(output, callbacks);
+		obs_output_force_stop(output);
+		obs_output_release(output);
+		return;
+	}
+
+	std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+	entry->output = output;
+	entry->owner = owner;
+	entry->callbacks = std::move(callbacks);
+	entry->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(deadlineMs.load());
+
+	signal_handler_connect(obs_output_get_signal_handler(output), "stop", OnStopped, entry.get());
+	obs_output_stop(output);
+	if (!obs_output_active(output))
+		entry->stopped = true;
+
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		entries.push_back(std::move(entry));
+		if (!running) {
+			running = true;
+			worker = std::thread(ReaperThread);
+		}
+	}
+	wake.notify_one();
+}
+
+void osn::OutputReaper::Orphan(OutputSignals *owner)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	for (auto &entry : entries) {
+		if (entry->owner != owner)
+			continue;
+
+		DisconnectSignals(entry->output, entry->callbacks);
+		entry->owner = nullptr;
+	}
+}
+
+size_t osn::OutputReaper::Pending()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	return entries.size();
+}
+
+void osn::OutputReaper::SetDeadline(uint32_t milliseconds)
+{
+	deadlineMs = milliseconds;
+}
+
+uint32_t osn::OutputReaper::Deadline()
+{
+	return deadlineMs;
+}
+
+void osn::OutputReaper::Stop()
+{
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		closed = true;
+		if (!running)
+			return;
+
+		running = false;
+		for (auto &entry : entries)
+			entry->deadline = std::chrono::steady_clock::now();
+	}
+	wake.notify_one();
+	if (worker.joinable())
+		worker.join();
+}
+
+void osn::OutputReaper::ReaperThread()
+{
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(wakeMtx);
+			wake.wait_for(lock, std::chrono::milliseconds(100));
+		}
+
+		// Force stopping can block for as long as the stuck socket does, so it runs without the lock
+		std::vector<Entry *> expired;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			if (!running && entries.empty())
+				break;
+
+			auto now = std::chrono::steady_clock::now();
+			for (auto &entry : entries) {
+				if (!entry->stopped && now >= entry->deadline)
+					expired.push_back(entry.get());
+			}
+		}
+
+		for (Entry *entry : expired) {
+			blog(LOG_WARNING, "Output '%s' did not stop within %u ms, forcing it to stop", obs_output_get_name(entry->output), deadlineMs.load());
+			obs_output_force_stop(entry->output);
+			entry->stopped = true;
+		}
+
+		std::vector<obs_output_t *> finished;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			for (auto it = entries.begin(); it != entries.end();) {
+				Entry *entry = it->get();
+				if (!entry->stopped) {
+					it++;
+					continue;
+				}
+
+				signal_handler_disconnect(obs_output_get_signal_handler(entry->output), "stop", OnStopped, entry);
+				DisconnectSignals(entry->output, entry->callbacks);
+				finished.push_back(entry->output);
+				it = entries.erase(it);
+			}
+		}
+
+		for (obs_output_t *output : finished)
+			obs_output_release(output);
+	}
+}
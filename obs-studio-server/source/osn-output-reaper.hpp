@@ -0,0 +1,74 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osn {
+class OutputSignals;
+struct cbData;
+
+// Finishes stopping and releasing outputs away from the IPC thread. A retired
+// output gets a graceful stop and is force stopped once the deadline passes,
+// its owner keeps receiving the output signals until the owner is destroyed
+// or creates a replacement output.
+class OutputReaper {
+public:
+	static const uint32_t DEFAULT_DEADLINE_MS = 20000;
+
+	static void Retire(obs_output_t *output, OutputSignals *owner, std::vector<cbData *> &&callbacks);
+	static void Orphan(OutputSignals *owner);
+	static size_t Pending();
+	static void SetDeadline(uint32_t milliseconds);
+	static uint32_t Deadline();
+
+	// Force stops whatever is still pending, called once at shutdown
+	static void Stop();
+
+private:
+	struct Entry {
+		obs_output_t *output;
+		OutputSignals *owner;
+		std::vector<cbData *> callbacks;
+		std::chrono::steady_clock::time_point deadline;
+		std::atomic<bool> stopped = false;
+	};
+
+	static void ReaperThread();
+	static void OnStopped(void *data, calldata_t *params);
+
+	static std::mutex mtx;
+	static std::list<std::unique_ptr<Entry>> entries;
+	static std::thread worker;
+	static bool running;
+	static bool closed;
+	static std::atomic<uint32_t> deadlineMs;
+
+	// Only guards the wakeup, the stop signal may fire while mtx is held to disconnect signals
+	static std::mutex wakeMtx;
+	static std::condition_variable wake;
+};
+}
@@ -18,35 +18,50 @@
 
 #include "osn-output-signals.hpp"
 #include "nodeobs_api.h"
+#include "osn-encoder-registry.hpp"
+#include "osn-output-reaper.hpp"
+#include "osn-output-telemetry.hpp"
+
+osn::OutputSignals::~OutputSignals()
+{
+	// Outputs still stopping in the reaper must not call back into this object anymore
+	osn::OutputReaper::Orphan(this);
+	osn::EncoderRegistry::Forget(this);
+}
 
 void osn::OutputSignals::createOutput(const std::string &type, const std::string &name)
 {
 	deleteOutput();
-	output = obs_output_create(type.c_str(), name.c_str(), nullptr, nullptr);
-
-	auto onStopped = [](void *data, calldata_t *) {
-		osn::OutputSignals *context = reinterpret_cast<osn::OutputSignals *>(data);
-		std::unique_lock<std::mutex> lock(context->mtxOutputStop);
-		context->cvStop.notify_one();
-	};
 
-	signal_handler *sh = obs_output_get_signal_handler(output);
-	signal_handler_connect(sh, "stop", onStopped, this);
+	// A retired output may still be stopping, its late signals must not read as the new output's
+	{
+		std::unique_lock<std::mutex> ulock(signalsMtx);
+		generation++;
+	}
+	output = obs_output_create(type.c_str(), name.c_str(), nullptr, nullptr);
 
 	ConnectSignals();
+	osn::OutputTelemetry::Track(this);
 }
 
+// Returns right away, an active output is stopped and released by the reaper.
+// Its stop signals are still queued for this object until it is destroyed or
+// creates another output.
 void osn::OutputSignals::deleteOutput()
 {
 	if (!output)
 		return;
 
+	osn::OutputTelemetry::Untrack(this);
+	osn::EncoderRegistry::Release(this);
+
 	if (obs_output_active(output)) {
-		obs_output_stop(output);
-		std::unique_lock<std::mutex> lock(mtxOutputStop);
-		cvStop.wait_for(lock, std::chrono::seconds(20));
+		osn::OutputReaper::Retire(output, this, std::move(callbacks));
+	} else {
+		DisconnectSignals(output, callbacks);
+		obs_output_release(output);
 	}
-	obs_output_release(output);
+	callbacks.clear();
 	output = nullptr;
 }
 
@@ -60,12 +75,17 @@ static void callback(void *data, calldata_t *params)
 	std::string signal = info->signal;
 	auto outputClass = info->outputClass;
 
-	if (!outputClass->output)
+	// Signals of a retired output arrive after outputClass->output was replaced
+	obs_output_t *output = static_cast<obs_output_t *>(calldata_ptr(params, "output"));
+	if (!output)
 		return;
 
-	const char *error = obs_output_get_last_error(outputClass->output);
+	const char *error = obs_output_get_last_error(output);
 
 	std::unique_lock<std::mutex> ulock(outputClass->signalsMtx);
+	if (info->generation != outputClass->generation)
+		return;
+
 	outputClass->signalsReceived.push({signal, (int)calldata_int(params, "code"), error ? std::string(error) : ""});
 }
 
@@ -79,8 +99,20 @@ void osn::OutputSignals::ConnectSignals()
 		osn::cbData *cd = new cbData();
 		cd->signal = signal;
 		cd->outputClass = this;
+		cd->generation = generation;
 		signal_handler_connect(handler, signal.c_str(), callback, cd);
+		callbacks.push_back(cd);
+	}
+}
+
+void osn::DisconnectSignals(obs_output_t *output, std::vector<cbData *> &callbacks)
+{
+	signal_handler *handler = obs_output_get_signal_handler(output);
+	for (cbData *cd : callbacks) {
+		signal_handler_disconnect(handler, cd->signal.c_str(), callback, cd);
+		delete cd;
 	}
+	callbacks.clear();
 }
 
 void osn::OutputSignals::startOutput()
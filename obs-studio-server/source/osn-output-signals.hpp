@@ -23,6 +23,8 @@
 #include <vector>
 
 namespace osn {
+struct cbData;
+
 struct signalInfo {
 	std::string signal;
 	int code;
@@ -36,20 +38,23 @@ public:
 		output = nullptr;
 		canvas = nullptr;
 	}
-	virtual ~OutputSignals() {}
+	virtual ~OutputSignals();
 
 public:
 	std::mutex signalsMtx;
 	std::queue<signalInfo> signalsReceived;
 	std::vector<std::string> signals;
+	// Bumped under signalsMtx for every output created, signals of older outputs are dropped from then on
+	uint64_t generation = 0;
 	obs_output_t *output;
 	obs_video_info *canvas;
 
 	void ConnectSignals();
 
 public:
-	std::condition_variable cvStop;
-	std::mutex mtxOutputStop;
+	// Signal callbacks connected to the current output
+	std::vector<cbData *> callbacks;
+
 	void createOutput(const std::string &type, const std::string &name);
 	void deleteOutput();
 	void startOutput();
@@ -58,5 +63,9 @@ public:
 struct cbData {
 	std::string signal;
 	OutputSignals *outputClass;
+	uint64_t generation;
 };
+
+// Disconnects and frees callbacks connected by OutputSignals::ConnectSignals
+void DisconnectSignals(obs_output_t *output, std::vector<cbData *> &callbacks);
 }
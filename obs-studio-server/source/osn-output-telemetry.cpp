@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-output-telemetry.hpp"
+#include <osn-error.hpp>
+#include <util/platform.h>
+#include "osn-file-output.hpp"
+#include "osn-streaming.hpp"
+#include "shared.hpp"
+
+std::mutex osn::OutputTelemetry::mtx;
+std::condition_variable osn::OutputTelemetry::cv;
+std::map<osn::OutputSignals *, osn::OutputTelemetry::History> osn::OutputTelemetry::histories;
+std::thread osn::OutputTelemetry::worker;
+bool osn::OutputTelemetry::running = false;
+
+void osn::OutputTelemetry::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("OutputTelemetry");
+	cls->register_function(
+		std::make_shared<ipc::function>("GetHistory", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt64, ipc::type::UInt64}, GetHistory));
+	srv.register_collection(cls);
+}
+
+void osn::OutputTelemetry::Track(OutputSignals *output)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	histories[output] = History();
+
+	// The sampler is started with the first output and kept until shutdown
+	if (!running) {
+		running = true;
+		worker = std::thread(SamplerThread);
+	}
+}
+
+void osn::OutputTelemetry::Untrack(OutputSignals *output)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	histories.erase(output);
+}
+
+void osn::OutputTelemetry::Stop()
+{
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		if (!running)
+			return;
+		running = false;
+	}
+	cv.notify_all();
+	if (worker.joinable())
+		worker.join();
+}
+
+void osn::OutputTelemetry::SamplerThread()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	auto next = std::chrono::steady_clock::now();
+	while (running) {
+		// Ticks are scheduled on a fixed clock so a slow sample does not shift the following ones
+		next += std::chrono::milliseconds(INTERVAL_MS);
+		if (cv.wait_until(lock, next, [] { return !running; }))
+			break;
+
+		uint64_t now = os_gettime_ns();
+		for (auto &entry : histories)
+			Sample(entry.first, entry.second, now);
+
+		if (next < std::chrono::steady_clock::now())
+			next = std::chrono::steady_clock::now();
+	}
+}
+
+void osn::OutputTelemetry::Sample(OutputSignals *output, History &history, uint64_t now)
+{
+	obs_output_t *obsOutput = output->output;
+	if (!obsOutput || !obs_output_active(obsOutput))
+		return;
+
+	ipc_pack::OutputSample sample = {};
+	sample.sequence = ++history.sequence;
+	sample.timestamp = now;
+	sample.totalBytes = obs_output_get_total_bytes(obsOutput);
+	sample.congestion = obs_output_get_congestion(obsOutput);
+	sample.droppedFrames = obs_output_get_frames_dropped(obsOutput);
+	sample.totalFrames = obs_output_get_total_frames(obsOutput);
+
+	// Skipped frames are counted on the video output of the canvas this output encodes
+	video_t *video = obs_output_video(obsOutput);
+	if (video) {
+		sample.skippedFrames = video_output_get_skipped_frames(video);
+		sample.encodedFrames = video_output_get_total_frames(video);
+	}
+	sample.laggedFrames = obs_get_lagged_frames();
+	sample.renderedFrames = obs_get_total_frames();
+
+	if (!history.samples.empty()) {
+		const ipc_pack::OutputSample &last = history.samples.back();
+		uint64_t elapsed = now - last.timestamp;
+		if (elapsed && sample.totalBytes >= last.totalBytes)
+			sample.kbitsPerSec = double(sample.totalBytes - last.totalBytes) * 8.0 / 1000.0 / (double(elapsed) / 1000000000.0);
+	}
+
+	history.samples.push_back(sample);
+	if (history.samples.size() > HISTORY_SIZE)
+		history.samples.pop_front();
+}
+
+void osn::OutputTelemetry::GetHistory(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	OutputSignals *output = nullptr;
+	if (args[0].value_str == "Streaming")
+		output = osn::IStreaming::Manager::GetInstance().find(args[1].value_union.ui64);
+	else
+		output = osn::IFileOutput::Manager::GetInstance().find(args[1].value_union.ui64);
+
+	if (!output) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Output reference is not valid.");
+	}
+
+	uint64_t after = args[2].value_union.ui64;
+	uint64_t sequence = 0;
+	ipc_pack::Writer samples(ipc_pack::Scratch());
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		auto found = histories.find(output);
+		if (found != histories.end()) {
+			sequence = found->second.sequence;
+			for (const auto &sample : found->second.samples) {
+				if (sample.sequence > after)
+					samples.put(sample);
+			}
+		}
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(sequence));
+	rval.push_back(samples.value());
+	AUTO_DEBUG;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-pack.hpp>
+#include <ipc-server.hpp>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace osn {
+class OutputSignals;
+
+// Samples every live output on a fixed clock and keeps a bounded history per
+// output, so the client can fetch what happened since its last poll in one call
+class OutputTelemetry {
+public:
+	static const size_t HISTORY_SIZE = 240;
+	static const uint32_t INTERVAL_MS = 500;
+
+	static void Register(ipc::server &);
+	static void GetHistory(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
+	// Called by OutputSignals around the lifetime of its obs output
+	static void Track(OutputSignals *output);
+	static void Untrack(OutputSignals *output);
+	static void Stop();
+
+private:
+	struct History {
+		std::deque<ipc_pack::OutputSample> samples;
+		uint64_t sequence = 0;
+	};
+
+	static void SamplerThread();
+	static void Sample(OutputSignals *output, History &history, uint64_t now);
+
+	static std::mutex mtx;
+	static std::condition_variable cv;
+	static std::map<OutputSignals *, History> histories;
+	static std::thread worker;
+	static bool running;
+};
+}
@@ -34,7 +34,7 @@ void osn::Properties::Register(ipc::server &srv)
 void osn::Properties::Modified(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	uint64_t sourceId = args[0].value_union.ui64;
-	std::string name = args[1].value_str;
+	const std::string &name = args[1].value_str;
 
 	obs_source_t *source = osn::Source::Manager::GetInstance().find(sourceId);
 	if (!source) {
@@ -61,7 +61,7 @@ void osn::Properties::Modified(void *data, const int64_t id, const std::vector<i
 void osn::Properties::Clicked(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	uint64_t sourceId = args[0].value_union.ui64;
-	std::string name = args[1].value_str;
+	const std::string &name = args[1].value_str;
 
 	obs_source_t *source = osn::Source::Manager::GetInstance().find(sourceId);
 	if (!source) {
@@ -0,0 +1,273 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-render-cache.hpp"
+#include <graphics/vec4.h>
+#include <set>
+#include <vector>
+
+const char *osn::RenderCache::FILTER_ID = "osn_render_cache";
+const char *osn::RenderCache::PROBE_ID = "osn_render_probe";
+
+std::mutex osn::RenderCache::mtx;
+std::map<obs_source_t *, osn::RenderCache::Cached> osn::RenderCache::cached;
+bool osn::RenderCache::enabled = false;
+bool osn::RenderCache::registered = false;
+
+std::atomic<uint64_t> osn::RenderCache::lastFrameTime = 0;
+std::atomic<uint64_t> osn::RenderCache::frames = 0;
+std::atomic<uint64_t> osn::RenderCache::renders = 0;
+std::atomic<uint64_t> osn::RenderCache::reuses = 0;
+std::atomic<uint64_t> osn::RenderCache::probed = 0;
+
+struct CacheFilter {
+	obs_source_t *self;
+	gs_texrender_t *texrender;
+	uint64_t frameTime;
+	uint32_t width;
+	uint32_t height;
+};
+
+void *osn::RenderCache::FilterCreate(obs_data_t *settings, obs_source_t *source)
+{
+	CacheFilter *filter = new CacheFilter();
+	filter->self = source;
+	return filter;
+}
+
+void osn::RenderCache::FilterDestroy(void *data)
+{
+	CacheFilter *filter = static_cast<CacheFilter *>(data);
+	if (filter->texrender) {
+		obs_enter_graphics();
+		gs_texrender_destroy(filter->texrender);
+		obs_leave_graphics();
+	}
+	delete filter;
+}
+
+void osn::RenderCache::FilterRender(void *data, gs_effect_t *effect)
+{
+	CacheFilter *filter = static_cast<CacheFilter *>(data);
+	obs_source_t *target = obs_filter_get_target(filter->self);
+	uint32_t width = obs_source_get_base_width(target);
+	uint32_t height = obs_source_get_base_height(target);
+
+	if (!width || !height) {
+		obs_source_skip_video_filter(filter->self);
+		return;
+	}
+
+	if (!filter->texrender)
+		filter->texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	uint64_t frameTime = obs_get_video_frame_time();
+	if (lastFrameTime.exchange(frameTime) != frameTime)
+		frames++;
+
+	// The first canvas drawn for this frame renders the input, the others reuse it
+	if (filter->frameTime != frameTime || filter->width != width || filter->height != height) {
+		gs_texrender_reset(filter->texrender);
+		if (gs_texrender_begin(filter->texrender, width, height)) {
+			vec4 clear;
+			vec4_zero(&clear);
+			gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+			gs_ortho(0.0f, float(width), 0.0f, float(height), -100.0f, 100.0f);
+
+			gs_blend_state_push();
+			gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+			obs_source_skip_video_filter(filter->self);
+			gs_blend_state_pop();
+
+			gs_texrender_end(filter->texrender);
+
+			filter->frameTime = frameTime;
+			filter->width = width;
+			filter->height = height;
+			renders++;
+		}
+	} else {
+		reuses++;
+	}
+
+	gs_texture_t *texture = gs_texrender_get_texture(filter->texrender);
+	if (!texture)
+		return;
+
+	gs_effect_t *defaultEffect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(defaultEffect, "image"), texture);
+
+	// The cached input is premultiplied at this point
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	while (gs_effect_loop(defaultEffect, "Draw"))
+		gs_draw_sprite(texture, 0, width, height);
+	gs_blend_state_pop();
+}
+
+void osn::RenderCache::ProbeRender(void *data, gs_effect_t *effect)
+{
+	probed++;
+	obs_source_skip_video_filter(static_cast<obs_source_t *>(data));
+}
+
+void osn::RenderCache::RegisterFilter()
+{
+	if (registered)
+		return;
+
+	obs_source_info info = {};
+	info.id = FILTER_ID;
+	info.type = OBS_SOURCE_TYPE_FILTER;
+	info.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_CAP_DISABLED;
+	info.get_name = [](void *) { return "Render Cache"; };
+	info.create = FilterCreate;
+	info.destroy = FilterDestroy;
+	info.video_render = FilterRender;
+	obs_register_source(&info);
+
+	obs_source_info probe = {};
+	probe.id = PROBE_ID;
+	probe.type = OBS_SOURCE_TYPE_FILTER;
+	probe.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_CAP_DISABLED;
+	probe.get_name = [](void *) { return "Render Probe"; };
+	probe.create = [](obs_data_t *, obs_source_t *source) { return static_cast<void *>(source); };
+	probe.destroy = [](void *) {};
+	probe.video_render = ProbeRender;
+	obs_register_source(&probe);
+
+	registered = true;
+}
+
+void osn::RenderCache::Detach(Cached &entry)
+{
+	obs_source_t *parent = obs_weak_source_get_source(entry.parent);
+	if (parent) {
+		obs_source_filter_remove(parent, entry.filter);
+		obs_source_release(parent);
+	}
+	obs_weak_source_release(entry.parent);
+	obs_source_release(entry.filter);
+}
+
+void osn::RenderCache::Strip(obs_source_t *source)
+{
+	auto found = cached.find(source);
+	std::pair<obs_source_t *, std::vector<obs_source_t *>> filters;
+	filters.first = found != cached.end() ? found->second.filter : nullptr;
+
+	// Copying or duplicating a source copies its cache filter too, only the tracked one may stay
+	auto enum_filters = [](obs_source_t *, obs_source_t *filter, void *data) {
+		auto filters = static_cast<std::pair<obs_source_t *, std::vector<obs_source_t *>> *>(data);
+		if (filter != filters->first && strcmp(obs_source_get_id(filter), FILTER_ID) == 0) {
+			obs_source_addref(filter);
+			filters->second.push_back(filter);
+		}
+	};
+	obs_source_enum_filters(source, enum_filters, &filters);
+
+	for (obs_source_t *filter : filters.second) {
+		obs_source_filter_remove(source, filter);
+		obs_source_release(filter);
+	}
+}
+
+void osn::RenderCache::StripCopies(obs_source_t *source)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	Strip(source);
+}
+
+void osn::RenderCache::SetEnabled(bool value)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (value)
+			RegisterFilter();
+		enabled = value;
+	}
+	Refresh();
+}
+
+bool osn::RenderCache::Enabled()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return enabled;
+}
+
+void osn::RenderCache::Refresh()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	// Collect the canvases each input is shown on. Once the filter exists, copies of it
+	// may sit on inputs even after shared compositing was turned off again.
+	std::map<obs_source_t *, std::set<obs_video_info *>> canvases;
+	if (enabled || registered) {
+		auto enum_scenes = [](void *data, obs_source_t *source) {
+			auto enum_items = [](obs_scene_t *, obs_sceneitem_t *item, void *data) {
+				auto canvases = static_cast<std::map<obs_source_t *, std::set<obs_video_info *>> *>(data);
+				obs_source_t *source = obs_sceneitem_get_source(item);
+				if (obs_source_get_type(source) == OBS_SOURCE_TYPE_INPUT)
+					(*canvases)[source].insert(obs_sceneitem_get_canvas(item));
+				return true;
+			};
+			obs_scene_enum_items(obs_scene_from_source(source), enum_items, data);
+			return true;
+		};
+		obs_enum_scenes(enum_scenes, &canvases);
+	}
+
+	for (auto &entry : canvases)
+		Strip(entry.first);
+
+	for (auto it = cached.begin(); it != cached.end();) {
+		auto found = canvases.find(it->first);
+		if (enabled && found != canvases.end() && found->second.size() > 1 && !obs_weak_source_expired(it->second.parent)) {
+			it++;
+			continue;
+		}
+		Detach(it->second);
+		it = cached.erase(it);
+	}
+
+	for (auto &entry : canvases) {
+		if (!enabled || entry.second.size() < 2 || cached.count(entry.first))
+			continue;
+
+		obs_source_t *filter = obs_source_create_private(FILTER_ID, "osn_render_cache", nullptr);
+		if (!filter)
+			continue;
+
+		obs_source_filter_add(entry.first, filter);
+		cached[entry.first] = {obs_source_get_weak_source(entry.first), filter};
+	}
+}
+
+void osn::RenderCache::Stop()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	for (auto &entry : cached)
+		Detach(entry.second);
+	cached.clear();
+	enabled = false;
+}
+
+osn::RenderCache::Stats osn::RenderCache::GetStats()
+{
+	return {frames.load(), renders.load(), reuses.load(), probed.load()};
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace osn {
+// Renders inputs shown on several video contexts once per frame.
+// Every canvas walks its own scene graph, so an input with items on two
+// canvases is normally drawn twice. When shared compositing is on, such
+// inputs get a hidden cache filter: the first canvas drawn for a frame
+// renders the input into a texture, the others sample that texture. The
+// scene items still apply their own per-canvas transforms on top.
+class RenderCache {
+public:
+	struct Stats {
+		uint64_t frames;
+		uint64_t renders;
+		uint64_t reuses;
+		uint64_t probed;
+	};
+
+	static void SetEnabled(bool enabled);
+	static bool Enabled();
+
+	// Attaches or detaches the cache after items moved between canvases
+	static void Refresh();
+	// Removes cache filters a source got by copying the filters of a cached one
+	static void StripCopies(obs_source_t *source);
+	static void Stop();
+
+	static Stats GetStats();
+
+	static const char *FILTER_ID;
+	// Counts how often the source below it renders, lets tests see what the cache saves
+	static const char *PROBE_ID;
+
+private:
+	struct Cached {
+		obs_weak_source_t *parent;
+		obs_source_t *filter;
+	};
+
+	static void RegisterFilter();
+	static void Detach(Cached &cached);
+	static void Strip(obs_source_t *source);
+
+	static void *FilterCreate(obs_data_t *settings, obs_source_t *source);
+	static void FilterDestroy(void *data);
+	static void FilterRender(void *data, gs_effect_t *effect);
+	static void ProbeRender(void *data, gs_effect_t *effect);
+
+	static std::mutex mtx;
+	static std::map<obs_source_t *, Cached> cached;
+	static bool enabled;
+	static bool registered;
+
+	static std::atomic<uint64_t> lastFrameTime;
+	static std::atomic<uint64_t> frames;
+	static std::atomic<uint64_t> renders;
+	static std::atomic<uint64_t> reuses;
+	static std::atomic<uint64_t> probed;
+};
+}
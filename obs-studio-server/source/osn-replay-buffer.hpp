@@ -28,6 +28,7 @@ public:
 	ReplayBuffer()
 	{
 		duration = 20;
+		maxSize = 512;
 		prefix = "Replay";
 		suffix = "";
 		usesStream = false;
@@ -37,6 +38,8 @@ public:
 
 public:
 	uint32_t duration;
+	// Memory budget in MB, the oldest packets are dropped up to the next keyframe once it is exceeded
+	uint32_t maxSize;
 	std::string prefix;
 	std::string suffix;
 	bool usesStream;
@@ -46,6 +49,8 @@ class IReplayBuffer : public IFileOutput {
 public:
 	static void GetDuration(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void SetDuration(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void GetMaxSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void SetMaxSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void GetPrefix(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void SetPrefix(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void GetSuffix(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
@@ -0,0 +1,152 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-scene-preloader.hpp"
+#include <algorithm>
+
+std::mutex osn::ScenePreloader::mtx;
+std::list<osn::ScenePreloader::Entry> osn::ScenePreloader::entries;
+uint32_t osn::ScenePreloader::capacity = 0;
+
+static bool SourceReady(obs_source_t *source)
+{
+	uint32_t flags = obs_source_get_output_flags(source);
+
+	// Media sources report their own state, the frame size stays empty until they play
+	if (flags & OBS_SOURCE_CONTROLLABLE_MEDIA) {
+		enum obs_media_state state = obs_source_media_get_state(source);
+		return state != OBS_MEDIA_STATE_OPENING && state != OBS_MEDIA_STATE_BUFFERING;
+	}
+
+	// Other async sources are ready once their first frame arrived
+	if ((flags & OBS_SOURCE_ASYNC_VIDEO) == OBS_SOURCE_ASYNC_VIDEO)
+		return obs_source_get_width(source) > 0;
+
+	return true;
+}
+
+void osn::ScenePreloader::Drop(Entry &entry)
+{
+	obs_source_t *scene = obs_weak_source_get_source(entry.scene);
+	if (scene) {
+		obs_source_dec_showing(scene);
+		obs_source_release(scene);
+	}
+	obs_weak_source_release(entry.scene);
+}
+
+void osn::ScenePreloader::Evict()
+{
+	uint32_t warm = 0;
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (obs_weak_source_expired(it->scene)) {
+			Drop(*it);
+			it = entries.erase(it);
+			continue;
+		}
+
+		if (!it->pinned && ++warm > capacity) {
+			Drop(*it);
+			it = entries.erase(it);
+			continue;
+		}
+		it++;
+	}
+}
+
+void osn::ScenePreloader::Insert(obs_source_t *scene, bool pinned)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	auto found = std::find_if(entries.begin(), entries.end(),
+				  [scene](const Entry &entry) { return obs_weak_source_references_source(entry.scene, scene); });
+	if (found != entries.end()) {
+		Entry entry = *found;
+		entry.pinned = pinned;
+		entries.erase(found);
+		entries.push_front(entry);
+	} else {
+		obs_source_inc_showing(scene);
+		entries.push_front({obs_source_get_weak_source(scene), pinned});
+	}
+
+	Evict();
+}
+
+void osn::ScenePreloader::Preload(obs_source_t *scene)
+{
+	Insert(scene, true);
+}
+
+void osn::ScenePreloader::Touch(obs_source_t *scene)
+{
+	Insert(scene, false);
+}
+
+void osn::ScenePreloader::Release(obs_source_t *scene)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	for (auto it = entries.begin(); it != entries.end(); it++) {
+		if (!obs_weak_source_references_source(it->scene, scene))
+			continue;
+		Drop(*it);
+		entries.erase(it);
+		return;
+	}
+}
+
+void osn::ScenePreloader::Stop()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	for (auto &entry : entries)
+		Drop(entry);
+	entries.clear();
+}
+
+osn::ScenePreloader::State osn::ScenePreloader::GetState(obs_source_t *scene)
+{
+	State state = {0, 0};
+	obs_source_enum_active_tree(
+		scene,
+		[](obs_source_t *parent, obs_source_t *child, void *data) {
+			State *state = static_cast<State *>(data);
+			// Nested scenes are walked through, only their sources count
+			if (obs_source_get_type(child) != OBS_SOURCE_TYPE_INPUT)
+				return;
+			state->totalSources++;
+			if (SourceReady(child))
+				state->readySources++;
+		},
+		&state);
+	return state;
+}
+
+void osn::ScenePreloader::SetCapacity(uint32_t value)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	capacity = value;
+	Evict();
+}
+
+uint32_t osn::ScenePreloader::Capacity()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	return capacity;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+    Copyright (C) 2016-2022 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <list>
+#include <mutex>
+
+namespace osn {
+// Keeps scenes shown in the background so their sources are loaded before a
+// transition reaches them. A preloaded scene holds a showing reference: its
+// sources get their show callbacks and start opening media and pages, but it
+// stays off program and out of the audio mix. Explicit preloads are pinned
+// until released or used by a transition. Scenes used by transitions stay warm
+// in a bounded most-recently-used list, which is empty unless a capacity is set.
+class ScenePreloader {
+public:
+	struct State {
+		uint32_t readySources;
+		uint32_t totalSources;
+	};
+
+	static void Preload(obs_source_t *scene);
+	static void Release(obs_source_t *scene);
+	// A transition switched to or away from this scene
+	static void Touch(obs_source_t *scene);
+	static void Stop();
+
+	static State GetState(obs_source_t *scene);
+
+	static void SetCapacity(uint32_t capacity);
+	static uint32_t Capacity();
+
+private:
+	struct Entry {
+		obs_weak_source_t *scene;
+		bool pinned;
+	};
+
+	static void Insert(obs_source_t *scene, bool pinned);
+	static void Evict();
+	static void Drop(Entry &entry);
+
+	static std::mutex mtx;
+	// Most recently used first
+	static std::list<Entry> entries;
+	static uint32_t capacity;
+};
+}
@@ -18,7 +18,10 @@
 
 #include "osn-scene.hpp"
 #include <list>
+#include "ipc-pack.hpp"
+#include "ipc-view.hpp"
 #include "osn-error.hpp"
+#include "osn-render-cache.hpp"
 #include "osn-sceneitem.hpp"
 #include "osn-video.hpp"
 #include "shared.hpp"
@@ -156,6 +159,7 @@ void osn::Scene::Release(void *data, const int64_t id, const std::vector<ipc::va
 		obs_sceneitem_remove(item);
 		obs_sceneitem_release(item);
 	}
+	osn::RenderCache::Refresh();
 
 	obs_source_release(source);
 
@@ -189,6 +193,7 @@ void osn::Scene::Remove(void *data, const int64_t id, const std::vector<ipc::val
 		obs_sceneitem_remove(item);
 		obs_sceneitem_release(item);
 	}
+	osn::RenderCache::Refresh();
 
 	obs_source_remove(source);
 	osn::Source::Manager::GetInstance().free(args[0].value_union.ui64);
@@ -227,6 +232,9 @@ void osn::Scene::Duplicate(void *data, const int64_t id, const std::vector<ipc::
 		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to get source from duplicate scene.");
 	}
 
+	// The copied items are shown on the same canvases as the originals
+	osn::RenderCache::Refresh();
+
 	uint64_t uid = osn::Source::Manager::GetInstance().find(source2);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
@@ -299,6 +307,7 @@ void osn::Scene::AddSource(void *data, const int64_t id, const std::vector<ipc::
 	}
 
 	obs_sceneitem_addref(item);
+	osn::RenderCache::Refresh();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value((uint64_t)uid));
@@ -381,21 +390,20 @@ void osn::Scene::OrderItems(void *data, const int64_t id, const std::vector<ipc:
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
-	const std::vector<char> &new_items_order = args[1].value_bin;
-	size_t items_count = new_items_order.size() / sizeof(int64_t);
-
-	obs_scene_set_items_order(scene, (int64_t *)new_items_order.data(), items_count);
-
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	ipc_view::span<int64_t> new_items_order = ipc_view::array<int64_t>(args[1]);
+	obs_scene_set_items_order(scene, const_cast<int64_t *>(new_items_order.data()), new_items_order.size());
 
-	std::list<obs_sceneitem_t *> items;
+	std::vector<obs_sceneitem_t *> items;
+	items.reserve(new_items_order.size());
 	auto cb_items = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
-		std::list<obs_sceneitem_t *> *items = reinterpret_cast<std::list<obs_sceneitem_t *> *>(data);
+		std::vector<obs_sceneitem_t *> *items = reinterpret_cast<std::vector<obs_sceneitem_t *> *>(data);
 		items->push_back(item);
 		return true;
 	};
 	obs_scene_enum_items(scene, cb_items, &items);
 
+	ipc_pack::Writer entries(ipc_pack::Scratch());
+	entries.reserve(items.size() * sizeof(ipc_pack::SceneItemEntry));
 	for (obs_sceneitem_t *item : items) {
 		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
@@ -405,9 +413,11 @@ void osn::Scene::OrderItems(void *data, const int64_t id, const std::vector<ipc:
 			}
 			obs_sceneitem_addref(item);
 		}
-		rval.push_back(ipc::value((uint64_t)uid));
-		rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+		entries.put(ipc_pack::SceneItemEntry{uid, obs_sceneitem_get_id(item)});
 	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(entries.value());
 	AUTO_DEBUG;
 }
 
@@ -460,16 +470,17 @@ void osn::Scene::MoveItem(void *data, const int64_t id, const std::vector<ipc::v
 
 	obs_sceneitem_set_order_position(ed.item, (int(num_items) - 1) - args[2].value_union.i32);
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-
-	std::list<obs_sceneitem_t *> items;
+	std::vector<obs_sceneitem_t *> items;
+	items.reserve(num_items);
 	auto cb_items = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
-		std::list<obs_sceneitem_t *> *items = reinterpret_cast<std::list<obs_sceneitem_t *> *>(data);
+		std::vector<obs_sceneitem_t *> *items = reinterpret_cast<std::vector<obs_sceneitem_t *> *>(data);
 		items->push_back(item);
 		return true;
 	};
 	obs_scene_enum_items(scene, cb_items, &items);
 
+	ipc_pack::Writer entries(ipc_pack::Scratch());
+	entries.reserve(items.size() * sizeof(ipc_pack::SceneItemEntry));
 	for (obs_sceneitem_t *item : items) {
 		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
@@ -479,9 +490,11 @@ void osn::Scene::MoveItem(void *data, const int64_t id, const std::vector<ipc::v
 			}
 			obs_sceneitem_addref(item);
 		}
-		rval.push_back(ipc::value((uint64_t)uid));
-		rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+		entries.put(ipc_pack::SceneItemEntry{uid, obs_sceneitem_get_id(item)});
 	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(entries.value());
 	AUTO_DEBUG;
 }
 
@@ -545,15 +558,16 @@ void osn::Scene::GetItems(void *data, const int64_t id, const std::vector<ipc::v
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
-	std::list<obs_sceneitem_t *> items;
+	std::vector<obs_sceneitem_t *> items;
 	auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
-		std::list<obs_sceneitem_t *> *items = reinterpret_cast<std::list<obs_sceneitem_t *> *>(data);
+		std::vector<obs_sceneitem_t *> *items = reinterpret_cast<std::vector<obs_sceneitem_t *> *>(data);
 		items->push_back(item);
 		return true;
 	};
 	obs_scene_enum_items(scene, cb, &items);
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	ipc_pack::Writer entries(ipc_pack::Scratch());
+	entries.reserve(items.size() * sizeof(ipc_pack::SceneItemEntry));
 	for (obs_sceneitem_t *item : items) {
 		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
 		if (uid == UINT64_MAX) {
@@ -563,9 +577,11 @@ void osn::Scene::GetItems(void *data, const int64_t id, const std::vector<ipc::v
 			}
 			obs_sceneitem_addref(item);
 		}
-		rval.push_back(ipc::value((uint64_t)uid));
-		rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+		entries.put(ipc_pack::SceneItemEntry{uid, obs_sceneitem_get_id(item)});
 	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(entries.value());
 	AUTO_DEBUG;
 }
 
@@ -601,6 +617,7 @@ void osn::Scene::GetItemsInRange(void *data, const int64_t id, const std::vector
 	};
 	obs_scene_enum_items(scene, cb, &ed);
 
+	rval.reserve(1 + ed.items.size());
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	for (obs_sceneitem_t *item : ed.items) {
 		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
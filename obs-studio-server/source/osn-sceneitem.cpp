@@ -19,6 +19,8 @@
 #include "osn-sceneitem.hpp"
 #include <osn-error.hpp>
 #include "osn-source.hpp"
+#include "osn-batch.hpp"
+#include "osn-render-cache.hpp"
 #include "shared.hpp"
 #include <osn-video.hpp>
 
@@ -29,64 +31,65 @@ void osn::SceneItem::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetScene", std::vector<ipc::type>{ipc::type::UInt64}, GetScene));
 	cls->register_function(std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
 	cls->register_function(std::make_shared<ipc::function>("IsVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsVisible));
-	cls->register_function(std::make_shared<ipc::function>("SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetVisible));
 	cls->register_function(std::make_shared<ipc::function>("IsSelected", std::vector<ipc::type>{ipc::type::UInt64}, IsSelected));
-	cls->register_function(std::make_shared<ipc::function>("SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetSelected", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetSelected));
 	cls->register_function(std::make_shared<ipc::function>("IsStreamVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsStreamVisible));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetStreamVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetStreamVisible));
+		osn::Batch::Function("SceneItem", "SetStreamVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetStreamVisible));
 	cls->register_function(std::make_shared<ipc::function>("IsRecordingVisible", std::vector<ipc::type>{ipc::type::UInt64}, IsRecordingVisible));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetRecordingVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetRecordingVisible));
+		osn::Batch::Function("SceneItem", "SetRecordingVisible", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetRecordingVisible));
 	cls->register_function(std::make_shared<ipc::function>("GetPosition", std::vector<ipc::type>{ipc::type::UInt64}, GetPosition));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetPosition", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetPosition));
+		osn::Batch::Function("SceneItem", "SetPosition", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetPosition));
 	cls->register_function(std::make_shared<ipc::function>("GetCanvas", std::vector<ipc::type>{ipc::type::UInt64}, GetCanvas));
 	cls->register_function(std::make_shared<ipc::function>("SetCanvas", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, SetCanvas));
 	cls->register_function(std::make_shared<ipc::function>("GetRotation", std::vector<ipc::type>{ipc::type::UInt64}, GetRotation));
-	cls->register_function(std::make_shared<ipc::function>("SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetRotation", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetRotation));
 	cls->register_function(std::make_shared<ipc::function>("GetScale", std::vector<ipc::type>{ipc::type::UInt64}, GetScale));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
+		osn::Batch::Function("SceneItem", "SetScale", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetScale));
 	cls->register_function(std::make_shared<ipc::function>("GetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64}, GetScaleFilter));
-	cls->register_function(std::make_shared<ipc::function>("SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetScaleFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetScaleFilter));
 	cls->register_function(std::make_shared<ipc::function>("GetAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetAlignment));
-	cls->register_function(std::make_shared<ipc::function>("SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAlignment));
 	cls->register_function(std::make_shared<ipc::function>("GetBounds", std::vector<ipc::type>{ipc::type::UInt64}, GetBounds));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
+		osn::Batch::Function("SceneItem", "SetBounds", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, SetBounds));
 	cls->register_function(std::make_shared<ipc::function>("GetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsAlignment));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
+		osn::Batch::Function("SceneItem", "SetBoundsAlignment", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBoundsAlignment));
 	cls->register_function(std::make_shared<ipc::function>("GetBoundsType", std::vector<ipc::type>{ipc::type::UInt64}, GetBoundsType));
-	cls->register_function(std::make_shared<ipc::function>("SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetBoundsType", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetBoundsType));
 	cls->register_function(std::make_shared<ipc::function>("GetCrop", std::vector<ipc::type>{ipc::type::UInt64}, GetCrop));
-	cls->register_function(std::make_shared<ipc::function>(
-		"SetCrop", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32}, SetCrop));
+	cls->register_function(osn::Batch::Function(
+		"SceneItem", "SetCrop", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32, ipc::type::Int32},
+		SetCrop));
 	cls->register_function(std::make_shared<ipc::function>("GetTransformInfo",
 							       std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float, ipc::type::Float,
 										      ipc::type::Float, ipc::type::Float, ipc::type::UInt32, ipc::type::UInt32,
 										      ipc::type::UInt32, ipc::type::Float, ipc::type::Float},
 							       GetTransformInfo));
-	cls->register_function(std::make_shared<ipc::function>("SetTransformInfo",
-							       std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float, ipc::type::Float,
-										      ipc::type::Float, ipc::type::Float, ipc::type::UInt32, ipc::type::UInt32,
-										      ipc::type::UInt32, ipc::type::Float, ipc::type::Float},
-							       SetTransformInfo));
+	cls->register_function(osn::Batch::Function("SceneItem", "SetTransformInfo",
+						    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float, ipc::type::Float,
+									   ipc::type::Float, ipc::type::Float, ipc::type::UInt32, ipc::type::UInt32,
+									   ipc::type::UInt32, ipc::type::Float, ipc::type::Float},
+						    SetTransformInfo));
 	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
-	cls->register_function(std::make_shared<ipc::function>("MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
-	cls->register_function(std::make_shared<ipc::function>("MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
-	cls->register_function(std::make_shared<ipc::function>("MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
-	cls->register_function(std::make_shared<ipc::function>("MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
-	cls->register_function(std::make_shared<ipc::function>("Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
-	cls->register_function(std::make_shared<ipc::function>("DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
-	cls->register_function(std::make_shared<ipc::function>("DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
+	cls->register_function(osn::Batch::Function("SceneItem", "MoveUp", std::vector<ipc::type>{ipc::type::UInt64}, MoveUp));
+	cls->register_function(osn::Batch::Function("SceneItem", "MoveDown", std::vector<ipc::type>{ipc::type::UInt64}, MoveDown));
+	cls->register_function(osn::Batch::Function("SceneItem", "MoveTop", std::vector<ipc::type>{ipc::type::UInt64}, MoveTop));
+	cls->register_function(osn::Batch::Function("SceneItem", "MoveBottom", std::vector<ipc::type>{ipc::type::UInt64}, MoveBottom));
+	cls->register_function(osn::Batch::Function("SceneItem", "Move", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, Move));
+	cls->register_function(osn::Batch::Function("SceneItem", "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
+	cls->register_function(osn::Batch::Function("SceneItem", "DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
 	cls->register_function(std::make_shared<ipc::function>("GetBlendingMethod", std::vector<ipc::type>{ipc::type::UInt64}, GetBlendingMethod));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetBlendingMethod", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBlendingMethod));
+		osn::Batch::Function("SceneItem", "SetBlendingMethod", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBlendingMethod));
 	cls->register_function(std::make_shared<ipc::function>("GetBlendingMode", std::vector<ipc::type>{ipc::type::UInt64}, GetBlendingMode));
 	cls->register_function(
-		std::make_shared<ipc::function>("SetBlendingMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBlendingMode));
+		osn::Batch::Function("SceneItem", "SetBlendingMode", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetBlendingMode));
 	srv.register_collection(cls);
 }
 
@@ -141,6 +144,7 @@ void osn::SceneItem::Remove(void *data, const int64_t id, const std::vector<ipc:
 	osn::SceneItem::Manager::GetInstance().free(args[0].value_union.ui64);
 	obs_sceneitem_remove(item);
 	obs_sceneitem_release(item);
+	osn::RenderCache::Refresh();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -315,6 +319,7 @@ void osn::SceneItem::SetCanvas(void *data, const int64_t id, const std::vector<i
 	}
 
 	obs_sceneitem_set_canvas(item, canvas);
+	osn::RenderCache::Refresh();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -0,0 +1,78 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-shared-memory.hpp"
+#include <osn-error.hpp>
+#include <obs.h>
+#include <cstring>
+#include "shared.hpp"
+#include "utility.hpp"
+
+void osn::SharedMemory::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("SharedMemory");
+	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::String}, Attach));
+	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{}, Detach));
+	srv.register_collection(cls);
+}
+
+ipc_shm::Region &osn::SharedMemory::GetRegion()
+{
+	static ipc_shm::Region region;
+	return region;
+}
+
+ipc::value osn::SharedMemory::String(const char *data, size_t size)
+{
+	uint32_t slot = 0;
+	char *buffer = GetRegion().Claim(size, slot);
+	if (!buffer)
+		return ipc::value(std::string(data, size));
+
+	memcpy(buffer, data, size);
+	return ipc::value(ipc_shm::Region::Descriptor(slot, size));
+}
+
+ipc::value osn::SharedMemory::Binary(const char *data, size_t size)
+{
+	uint32_t slot = 0;
+	char *buffer = GetRegion().Claim(size, slot);
+	if (!buffer)
+		return ipc::value(std::vector<char>(data, data + size));
+
+	memcpy(buffer, data, size);
+	return ipc::value(ipc_shm::Region::Descriptor(slot, size));
+}
+
+void osn::SharedMemory::Attach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	if (!GetRegion().Open(args[0].value_str)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to map the shared memory region.");
+	}
+
+	blog(LOG_INFO, "Attached shared memory region '%s'", args[0].value_str.c_str());
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::SharedMemory::Detach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	GetRegion().Close();
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
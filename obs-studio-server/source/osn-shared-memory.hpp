@@ -0,0 +1,41 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-server.hpp>
+#include <ipc-shm.hpp>
+#include <string>
+#include <vector>
+
+namespace osn {
+class SharedMemory {
+public:
+	static void Register(ipc::server &);
+
+	// Region attached by the client, closed until the client opts in
+	static ipc_shm::Region &GetRegion();
+
+	// String or Binary payload that goes through the region when it is large
+	// enough, inline otherwise
+	static ipc::value String(const char *data, size_t size);
+	static ipc::value Binary(const char *data, size_t size);
+
+	static void Attach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Detach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-simple-recording.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-audio-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-error.hpp"
@@ -273,7 +274,8 @@ static int CalcCRF(int crf, bool lowCPU = false)
 
 static void UpdateRecordingSettings_crf(enum osn::RecQuality quality, osn::SimpleRecording *recording)
 {
-	std::string id = obs_encoder_get_id(recording->videoEncoder);
+	obs_encoder_t *encoder = osn::EncoderRegistry::Configured(recording, recording->videoEncoder);
+	std::string id = obs_encoder_get_id(encoder);
 	bool ultra_hq = (quality == osn::RecQuality::HigherQuality);
 	int crf = CalcCRF(ultra_hq ? 16 : 23);
 
@@ -285,7 +287,7 @@ static void UpdateRecordingSettings_crf(enum osn::RecQuality quality, osn::Simpl
 	} else if (id.compare(SIMPLE_ENCODER_NVENC_HEVC) == 0) {
 		settings = UpdateRecordingSettings_nvenc_hevc(CalcCRF(crf));
 	} else if (id.compare(SIMPLE_ENCODER_QSV) == 0 || id.compare(ADVANCED_ENCODER_QSV) == 0) {
-		settings = UpdateRecordingSettings_qsv11(CalcCRF(crf), recording->videoEncoder);
+		settings = UpdateRecordingSettings_qsv11(CalcCRF(crf), encoder);
 	} else if (id.compare(SIMPLE_ENCODER_AMD) == 0 || id.compare(SIMPLE_ENCODER_AMD_HEVC) == 0 || id.compare(ADVANCED_ENCODER_AMD) == 0) {
 		settings = UpdateRecordingSettings_amd_cqp(CalcCRF(crf));
 	} else if (id.compare(APPLE_SOFTWARE_VIDEO_ENCODER) == 0 || id.compare(APPLE_HARDWARE_VIDEO_ENCODER) == 0 ||
@@ -299,20 +301,28 @@ static void UpdateRecordingSettings_crf(enum osn::RecQuality quality, osn::Simpl
 	if (!settings)
 		return;
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(recording->videoEncoder, obs_video_mix_get(recording->canvas, OBS_STREAMING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(recording->canvas, OBS_STREAMING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(recording->videoEncoder, obs_video_mix_get(recording->canvas, OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(encoder, obs_video_mix_get(recording->canvas, OBS_MAIN_VIDEO_RENDERING));
 	}
-	obs_encoder_update(recording->videoEncoder, settings);
+	obs_encoder_update(encoder, settings);
 	obs_data_release(settings);
 }
 
 void osn::SimpleRecording::UpdateEncoders()
 {
-	if (videoEncoder && obs_encoder_active(videoEncoder))
+	// The stream encoders are configured by the streaming output instead
+	if (quality != RecQuality::Stream) {
+		osn::EncoderRegistry::Unshare(this, videoEncoder);
+		osn::EncoderRegistry::Unshare(this, audioEncoder);
+	}
+
+	obs_encoder_t *videoEnc = osn::EncoderRegistry::Configured(this, videoEncoder);
+	if (videoEnc && obs_encoder_active(videoEnc))
 		return;
 
-	if (audioEncoder && obs_encoder_active(audioEncoder))
+	obs_encoder_t *audioEnc = osn::EncoderRegistry::Configured(this, audioEncoder);
+	if (audioEnc && obs_encoder_active(audioEnc))
 		return;
 
 	switch (quality) {
@@ -376,10 +386,10 @@ void osn::ISimpleRecording::Start(void *data, const int64_t id, const std::vecto
 			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid audio encoder.");
 		}
 
-		obs_encoder_set_audio(recording->audioEncoder, obs_get_audio());
-		obs_output_set_audio_encoder(recording->output, recording->audioEncoder, 0);
+		obs_encoder_set_audio(osn::EncoderRegistry::Configured(recording, recording->audioEncoder), obs_get_audio());
+		obs_output_set_audio_encoder(recording->output, osn::EncoderRegistry::Acquire(recording, recording->audioEncoder, 0), 0);
 
-		obs_output_set_video_encoder(recording->output, recording->videoEncoder);
+		obs_output_set_video_encoder(recording->output, osn::EncoderRegistry::Acquire(recording, recording->videoEncoder));
 	}
 
 	if (!recording->path.size()) {
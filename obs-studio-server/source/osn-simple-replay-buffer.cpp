@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-simple-replay-buffer.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-audio-encoder.hpp"
 #include "osn-error.hpp"
 #include "shared.hpp"
@@ -29,6 +30,8 @@ void osn::ISimpleReplayBuffer::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("GetDuration", std::vector<ipc::type>{ipc::type::UInt64}, GetDuration));
 	cls->register_function(std::make_shared<ipc::function>("SetDuration", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetDuration));
+	cls->register_function(std::make_shared<ipc::function>("GetMaxSize", std::vector<ipc::type>{ipc::type::UInt64}, GetMaxSize));
+	cls->register_function(std::make_shared<ipc::function>("SetMaxSize", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetMaxSize));
 	cls->register_function(std::make_shared<ipc::function>("GetPrefix", std::vector<ipc::type>{ipc::type::UInt64}, GetPrefix));
 	cls->register_function(std::make_shared<ipc::function>("SetPrefix", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, SetPrefix));
 	cls->register_function(std::make_shared<ipc::function>("GetSuffix", std::vector<ipc::type>{ipc::type::UInt64}, GetSuffix));
@@ -120,13 +123,13 @@ void osn::ISimpleReplayBuffer::Start(void *data, const int64_t id, const std::ve
 	}
 
 	obs_encoder_set_audio(audioEncoder, obs_get_audio());
-	obs_output_set_audio_encoder(replayBuffer->output, audioEncoder, 0);
+	obs_output_set_audio_encoder(replayBuffer->output, osn::EncoderRegistry::Acquire(replayBuffer, audioEncoder, 0), 0);
 
 	if (!videoEncoder) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid video encoder.");
 	}
 
-	obs_output_set_video_encoder(replayBuffer->output, videoEncoder);
+	obs_output_set_video_encoder(replayBuffer->output, osn::EncoderRegistry::Acquire(replayBuffer, videoEncoder));
 
 	if (!replayBuffer->path.size()) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid recording path.");
@@ -134,7 +137,7 @@ void osn::ISimpleReplayBuffer::Start(void *data, const int64_t id, const std::ve
 
 	const char *rbPrefix = replayBuffer->prefix.c_str();
 	const char *rbSuffix = replayBuffer->suffix.c_str();
-	int64_t rbSize = replayBuffer->usesStream ? 0 : 512;
+	int64_t rbSize = replayBuffer->maxSize;
 
 	std::string f;
 	if (rbPrefix && *rbPrefix) {
@@ -196,6 +199,7 @@ void osn::ISimpleReplayBuffer::GetLegacySettings(void *data, const int64_t id, c
 	replayBuffer->prefix = utility::GetSafeString(config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBPrefix"));
 	replayBuffer->suffix = utility::GetSafeString(config_get_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSuffix"));
 	replayBuffer->duration = config_get_int(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBTime");
+	replayBuffer->maxSize = config_get_int(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSize");
 
 	replayBuffer->usesStream = config_get_bool(ConfigManager::getInstance().getBasic(), "SimpleOutput", "replayBufferUseStreamOutput");
 
@@ -225,6 +229,7 @@ void osn::ISimpleReplayBuffer::SetLegacySettings(void *data, const int64_t id, c
 	config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBPrefix", replayBuffer->prefix.c_str());
 	config_set_string(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSuffix", replayBuffer->suffix.c_str());
 	config_set_int(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBTime", replayBuffer->duration);
+	config_set_int(ConfigManager::getInstance().getBasic(), "SimpleOutput", "RecRBSize", replayBuffer->maxSize);
 	config_set_bool(ConfigManager::getInstance().getBasic(), "SimpleOutput", "replayBufferUseStreamOutput", replayBuffer->usesStream);
 
 	config_save_safe(ConfigManager::getInstance().getBasic(), "tmp", nullptr);
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-simple-streaming.hpp"
+#include "osn-encoder-registry.hpp"
 #include "osn-audio-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-error.hpp"
@@ -267,18 +268,21 @@ void osn::SimpleStreaming::UpdateEncoders()
 	if (!videoEncoder || !audioEncoder)
 		return;
 
-	if (obs_encoder_active(videoEncoder))
+	obs_encoder_t *videoEnc = osn::EncoderRegistry::Unshare(this, videoEncoder);
+	obs_encoder_t *audioEnc = osn::EncoderRegistry::Unshare(this, audioEncoder);
+
+	if (obs_encoder_active(videoEnc))
 		return;
 
-	if (obs_encoder_active(audioEncoder))
+	if (obs_encoder_active(audioEnc))
 		return;
 
-	obs_data_t *videoEncSettings = obs_encoder_get_settings(videoEncoder);
-	obs_data_t *audioEncSettings = obs_encoder_get_settings(audioEncoder);
+	obs_data_t *videoEncSettings = obs_encoder_get_settings(videoEnc);
+	obs_data_t *audioEncSettings = obs_encoder_get_settings(audioEnc);
 	uint32_t vBitrate = obs_data_get_int(videoEncSettings, "bitrate");
 	uint32_t aBitrate = obs_data_get_int(audioEncSettings, "bitrate");
 
-	std::string id = obs_encoder_get_id(videoEncoder);
+	std::string id = obs_encoder_get_id(videoEnc);
 	if (id.compare("amd_amf_h264") == 0)
 		UpdateStreamingSettings_amd(videoEncSettings, vBitrate);
 
@@ -309,19 +313,19 @@ void osn::SimpleStreaming::UpdateEncoders()
 		// case VIDEO_FORMAT_P010:
 		break;
 	default:
-		obs_encoder_set_preferred_video_format(videoEncoder, VIDEO_FORMAT_NV12);
+		obs_encoder_set_preferred_video_format(videoEnc, VIDEO_FORMAT_NV12);
 	}
 
-	obs_encoder_update(videoEncoder, videoEncSettings);
-	obs_encoder_update(audioEncoder, audioEncSettings);
+	obs_encoder_update(videoEnc, videoEncSettings);
+	obs_encoder_update(audioEnc, audioEncSettings);
 
 	obs_data_release(videoEncSettings);
 	obs_data_release(audioEncSettings);
 
 	if (obs_get_multiple_rendering()) {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_STREAMING_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(videoEnc, obs_video_mix_get(canvas, OBS_STREAMING_VIDEO_RENDERING));
 	} else {
-		obs_encoder_set_video_mix(videoEncoder, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
+		obs_encoder_set_video_mix(videoEnc, obs_video_mix_get(canvas, OBS_MAIN_VIDEO_RENDERING));
 	}
 }
 
@@ -356,10 +360,10 @@ void osn::ISimpleStreaming::Start(void *data, const int64_t id, const std::vecto
 	}
 
 	streaming->UpdateEncoders();
-	obs_encoder_set_audio(streaming->audioEncoder, obs_get_audio());
-	obs_output_set_audio_encoder(streaming->output, streaming->audioEncoder, 0);
+	obs_encoder_set_audio(osn::EncoderRegistry::Configured(streaming, streaming->audioEncoder), obs_get_audio());
+	obs_output_set_audio_encoder(streaming->output, osn::EncoderRegistry::Acquire(streaming, streaming->audioEncoder, 0), 0);
 
-	obs_output_set_video_encoder(streaming->output, streaming->videoEncoder);
+	obs_output_set_video_encoder(streaming->output, osn::EncoderRegistry::Acquire(streaming, streaming->videoEncoder));
 
 	if (streaming->enableTwitchVOD) {
 		streaming->twitchVODSupported = streaming->isTwitchVODSupported();
@@ -28,6 +28,9 @@
 #include <obs.hpp>
 #include "osn-error.hpp"
 #include "osn-common.hpp"
+#include "osn-batch.hpp"
+#include "osn-render-cache.hpp"
+#include "osn-shared-memory.hpp"
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
@@ -141,9 +144,9 @@ void osn::Source::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetStatus", std::vector<ipc::type>{ipc::type::UInt64}, GetStatus));
 	cls->register_function(std::make_shared<ipc::function>("GetId", std::vector<ipc::type>{ipc::type::UInt64}, GetId));
 	cls->register_function(std::make_shared<ipc::function>("GetMuted", std::vector<ipc::type>{ipc::type::UInt64}, GetMuted));
-	cls->register_function(std::make_shared<ipc::function>("SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
+	cls->register_function(osn::Batch::Function("Source", "SetMuted", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetMuted));
 	cls->register_function(std::make_shared<ipc::function>("GetEnabled", std::vector<ipc::type>{ipc::type::UInt64}, GetEnabled));
-	cls->register_function(std::make_shared<ipc::function>("SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
+	cls->register_function(osn::Batch::Function("Source", "SetEnabled", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, SetEnabled));
 
 	cls->register_function(
 		std::make_shared<ipc::function>("SendMouseClick",
@@ -226,8 +229,10 @@ void osn::Source::Release(void *data, const int64_t id, const std::vector<ipc::v
 		}
 
 		obs_source_release(src);
+		osn::RenderCache::Refresh();
 	} else {
 		obs_source_remove(src);
+		osn::RenderCache::Refresh();
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -281,8 +286,8 @@ void osn::Source::CallHandler(void *data, const int64_t id, const std::vector<ip
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
-	std::string function_name = args[1].value_str.c_str();
-	std::string function_input = args[2].value_str.c_str();
+	const std::string &function_name = args[1].value_str;
+	const std::string &function_input = args[2].value_str;
 
 	calldata_t cd;
 	calldata_init(&cd);
@@ -322,8 +327,9 @@ void osn::Source::GetSettings(void *data, const int64_t id, const std::vector<ip
 	}
 
 	obs_data_t *sets = obs_source_get_settings(src);
+	const char *json = obs_data_get_full_json(sets);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_data_get_full_json(sets)));
+	rval.push_back(osn::SharedMemory::String(json, json ? strlen(json) : 0));
 	obs_data_release(sets);
 	AUTO_DEBUG;
 }
@@ -22,6 +22,7 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "osn-source.hpp"
+#include "osn-scene-preloader.hpp"
 #include "shared.hpp"
 
 void osn::Transition::Register(ipc::server &srv)
@@ -42,6 +43,11 @@ void osn::Transition::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
 	cls->register_function(
 		std::make_shared<ipc::function>("Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
+	cls->register_function(std::make_shared<ipc::function>("Preload", std::vector<ipc::type>{ipc::type::UInt64}, Preload));
+	cls->register_function(std::make_shared<ipc::function>("ReleasePreload", std::vector<ipc::type>{ipc::type::UInt64}, ReleasePreload));
+	cls->register_function(std::make_shared<ipc::function>("GetPreloadState", std::vector<ipc::type>{ipc::type::UInt64}, GetPreloadState));
+	cls->register_function(std::make_shared<ipc::function>("GetWarmCacheSize", std::vector<ipc::type>{}, GetWarmCacheSize));
+	cls->register_function(std::make_shared<ipc::function>("SetWarmCacheSize", std::vector<ipc::type>{ipc::type::UInt32}, SetWarmCacheSize));
 	srv.register_collection(cls);
 }
 
@@ -195,6 +201,7 @@ void osn::Transition::Set(void *data, const int64_t id, const std::vector<ipc::v
 	}
 
 	obs_transition_set(transition, source);
+	osn::ScenePreloader::Touch(source);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -215,9 +222,79 @@ void osn::Transition::Start(void *data, const int64_t id, const std::vector<ipc:
 
 	uint32_t ms = args[1].value_union.ui32;
 
+	obs_source_t *previous = obs_transition_get_active_source(transition);
 	bool result = obs_transition_start(transition, OBS_TRANSITION_MODE_AUTO, ms, source);
 
+	// Both ends stay warm, switching back is as quick as switching forward. Touching only
+	// once the transition shows the scene keeps an evicted preload from hiding it meanwhile.
+	if (previous) {
+		osn::ScenePreloader::Touch(previous);
+		obs_source_release(previous);
+	}
+	osn::ScenePreloader::Touch(source);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(result));
 	AUTO_DEBUG;
 }
+
+static void PushPreloadState(std::vector<ipc::value> &rval, obs_source_t *scene)
+{
+	osn::ScenePreloader::State state = osn::ScenePreloader::GetState(scene);
+	rval.push_back(ipc::value(state.readySources));
+	rval.push_back(ipc::value(state.totalSources));
+}
+
+void osn::Transition::Preload(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_source_t *scene = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Scene reference is not valid.");
+	}
+
+	osn::ScenePreloader::Preload(scene);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	PushPreloadState(rval, scene);
+	AUTO_DEBUG;
+}
+
+void osn::Transition::ReleasePreload(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_source_t *scene = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Scene reference is not valid.");
+	}
+
+	osn::ScenePreloader::Release(scene);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Transition::GetPreloadState(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_source_t *scene = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Scene reference is not valid.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	PushPreloadState(rval, scene);
+	AUTO_DEBUG;
+}
+
+void osn::Transition::GetWarmCacheSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::ScenePreloader::Capacity()));
+	AUTO_DEBUG;
+}
+
+void osn::Transition::SetWarmCacheSize(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::ScenePreloader::SetCapacity(args[0].value_union.ui32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
@@ -41,8 +41,8 @@ void osn::VideoEncoder::Register(ipc::server &srv)
 
 void osn::VideoEncoder::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::string encoderId = args[0].value_str;
-	std::string name = args[1].value_str;
+	const std::string &encoderId = args[0].value_str;
+	const std::string &name = args[1].value_str;
 
 	std::string settingsJson = args[2].value_str;
 	if (settingsJson.empty())
@@ -97,7 +97,7 @@ void osn::VideoEncoder::SetName(void *data, const int64_t id, const std::vector<
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Video encoder reference is not valid.");
 	}
 
-	std::string name = args[1].value_str;
+	const std::string &name = args[1].value_str;
 	obs_encoder_set_name(encoder, name.c_str());
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
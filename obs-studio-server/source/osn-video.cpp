@@ -21,6 +21,7 @@
 #include <obs.h>
 #include "osn-error.hpp"
 #include "shared.hpp"
+#include "osn-render-cache.hpp"
 
 // DELETE ME WHEN REMOVING NODEOBS
 #include "nodeobs_configManager.hpp"
@@ -47,6 +48,10 @@ void osn::Video::Register(ipc::server &srv)
 		std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32,
 				       ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 		SetLegacySettings));
+
+	cls->register_function(std::make_shared<ipc::function>("GetSharedCompositing", std::vector<ipc::type>{}, GetSharedCompositing));
+	cls->register_function(std::make_shared<ipc::function>("SetSharedCompositing", std::vector<ipc::type>{ipc::type::Int32}, SetSharedCompositing));
+	cls->register_function(std::make_shared<ipc::function>("GetCompositingStats", std::vector<ipc::type>{}, GetCompositingStats));
 	srv.register_collection(cls);
 }
 
@@ -64,6 +69,33 @@ void osn::Video::GetTotalFrames(void *data, const int64_t id, const std::vector<
 	AUTO_DEBUG;
 }
 
+void osn::Video::GetSharedCompositing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t)osn::RenderCache::Enabled()));
+	AUTO_DEBUG;
+}
+
+void osn::Video::SetSharedCompositing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::RenderCache::SetEnabled(!!args[0].value_union.i32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Video::GetCompositingStats(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	osn::RenderCache::Stats stats = osn::RenderCache::GetStats();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(stats.frames));
+	rval.push_back(ipc::value(stats.renders));
+	rval.push_back(ipc::value(stats.reuses));
+	rval.push_back(ipc::value(stats.probed));
+	AUTO_DEBUG;
+}
+
 void osn::Video::GetVideoContext(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	obs_video_info *canvas = osn::Video::Manager::GetInstance().find(args[0].value_union.ui64);
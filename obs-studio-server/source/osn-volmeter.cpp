@@ -18,11 +18,15 @@
 
 #include "osn-volmeter.hpp"
 #include "osn-error.hpp"
+#include "osn-audio-math.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <thread>
 
 std::mutex mtx;
 
@@ -37,6 +41,12 @@ osn::Volmeter::Volmeter(obs_fader_type type)
 	self = obs_volmeter_create(type);
 	if (!self)
 		throw std::exception();
+
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+		published.magnitude[ch].store(0.0f, std::memory_order_relaxed);
+		published.peak[ch].store(0.0f, std::memory_order_relaxed);
+		published.input_peak[ch].store(0.0f, std::memory_order_relaxed);
+	}
 }
 
 osn::Volmeter::~Volmeter()
@@ -60,10 +70,9 @@ void osn::Volmeter::Register(ipc::server &srv)
 void osn::Volmeter::ClearVolmeters()
 {
 	Manager::GetInstance().for_each([](const std::shared_ptr<osn::Volmeter> &volmeter) {
-		if (volmeter->id2) {
-			obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter->id2);
-			delete volmeter->id2;
-			volmeter->id2 = nullptr;
+		if (volmeter->callback_attached) {
+			obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter.get());
+			volmeter->callback_attached = false;
 		}
 	});
 
@@ -105,10 +114,9 @@ void osn::Volmeter::Destroy(void *data, const int64_t id, const std::vector<ipc:
 	}
 
 	Manager::GetInstance().free(uid);
-	if (meter->id2) { // Ensure there are no more callbacks
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+	if (meter->callback_attached) { // Ensure there are no more callbacks
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_attached = false;
 	}
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -169,9 +177,9 @@ void osn::Volmeter::AddCallback(void *data, const int64_t id, const std::vector<
 
 	meter->callback_count++;
 	if (meter->callback_count == 1) {
-		meter->id2 = new uint64_t;
-		*meter->id2 = meter->id;
-		obs_volmeter_add_callback(meter->self, OBSCallback, meter->id2);
+		// The meter outlives its callback, Destroy removes it first
+		obs_volmeter_add_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_attached = true;
 	}
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
@@ -190,9 +198,8 @@ void osn::Volmeter::RemoveCallback(void *data, const int64_t id, const std::vect
 
 	meter->callback_count--;
 	if (meter->callback_count == 0) {
-		obs_volmeter_remove_callback(meter->self, OBSCallback, meter->id2);
-		delete meter->id2;
-		meter->id2 = nullptr;
+		obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
+		meter->callback_attached = false;
 	}
 
 	rval.push_back(ipc::value(uint64_t(ErrorCode::Ok)));
@@ -211,51 +218,85 @@ void osn::Volmeter::Query(void *data, const int64_t id, const std::vector<ipc::v
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+	AudioData current_data = meter->Snapshot();
 
-	// Reset audio data if OBSCallBack is idle
-	if (meter->current_data.lastUpdateTime != std::chrono::milliseconds(0)) {
-		if (CheckIdle(GetTime(), meter->current_data.lastUpdateTime)) {
-			meter->current_data.resetData();
+	// Report silence if OBSCallBack is idle
+	if (current_data.lastUpdateTime != std::chrono::milliseconds(0)) {
+		if (CheckIdle(GetTime(), current_data.lastUpdateTime)) {
+			current_data.resetData();
 		}
 	}
 
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value(current_data.ch));
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < current_data.ch; ch++) {
+		rval.push_back(ipc::value(current_data.magnitude[ch]));
+		rval.push_back(ipc::value(current_data.peak[ch]));
+		rval.push_back(ipc::value(current_data.input_peak[ch]));
 	}
 
-	ulock.unlock();
-
 	AUTO_DEBUG;
 }
 
 void osn::Volmeter::OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
 				const float input_peak[MAX_AUDIO_CHANNELS])
 {
-	std::unique_lock<std::mutex> ulockMutex(mtx);
-	auto meter = Manager::GetInstance().find(*reinterpret_cast<uint64_t *>(param));
-	if (!meter) {
-		return;
+	// Runs on the audio thread, no locks from here on
+	Volmeter *meter = reinterpret_cast<Volmeter *>(param);
+	meter->Publish(obs_volmeter_get_nr_channels(meter->self), magnitude, peak, input_peak);
+}
+
+void osn::Volmeter::Publish(int32_t ch, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
+			    const float input_peak[MAX_AUDIO_CHANNELS])
+{
+	// Sanitize all channels in one pass before publishing them
+	float levels[3][MAX_AUDIO_CHANNELS];
+	memcpy(levels[0], magnitude, sizeof(levels[0]));
+	memcpy(levels[1], peak, sizeof(levels[1]));
+	memcpy(levels[2], input_peak, sizeof(levels[2]));
+	audio_math::SanitizeLevels(&levels[0][0], 3 * MAX_AUDIO_CHANNELS);
+
+	// An odd sequence tells readers a publication is in progress
+	uint32_t sequence = published.sequence.load(std::memory_order_relaxed);
+	published.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	published.lastUpdateTime.store(GetTime().count(), std::memory_order_relaxed);
+	published.ch.store(ch, std::memory_order_relaxed);
+	for (size_t i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		published.magnitude[i].store(levels[0][i], std::memory_order_relaxed);
+		published.peak[i].store(levels[1][i], std::memory_order_relaxed);
+		published.input_peak[i].store(levels[2][i], std::memory_order_relaxed);
 	}
 
-#define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
-#define PREVIOUS_FRAME_WEIGHT
+	published.sequence.store(sequence + 2, std::memory_order_release);
+}
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
+osn::Volmeter::AudioData osn::Volmeter::Snapshot() const
+{
+	AudioData data;
+	uint32_t before, after;
+
+	do {
+		before = published.sequence.load(std::memory_order_acquire);
+		if (before & 1) {
+			std::this_thread::yield();
+			continue;
+		}
 
-	meter->current_data.lastUpdateTime = GetTime();
-	meter->current_data.ch = obs_volmeter_get_nr_channels(meter->self);
-	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
-		meter->current_data.magnitude[ch] = MAKE_FLOAT_SANE(magnitude[ch]);
-		meter->current_data.peak[ch] = MAKE_FLOAT_SANE(peak[ch]);
-		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
-	}
+		data.lastUpdateTime = std::chrono::milliseconds(published.lastUpdateTime.load(std::memory_order_relaxed));
+		data.ch = std::min<int32_t>(published.ch.load(std::memory_order_relaxed), MAX_AUDIO_CHANNELS);
+		for (size_t i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+			data.magnitude[i] = published.magnitude[i].load(std::memory_order_relaxed);
+			data.peak[i] = published.peak[i].load(std::memory_order_relaxed);
+			data.input_peak[i] = published.input_peak[i].load(std::memory_order_relaxed);
+		}
 
-#undef MAKE_FLOAT_SANE
+		std::atomic_thread_fence(std::memory_order_acquire);
+		after = published.sequence.load(std::memory_order_relaxed);
+	} while ((before & 1) || before != after);
+
+	return data;
 }
 
 std::chrono::milliseconds osn::Volmeter::GetTime()
@@ -276,29 +317,28 @@ bool osn::Volmeter::CheckIdle(std::chrono::milliseconds currentTime, std::chrono
 	return false;
 }
 
-void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
+void osn::Volmeter::getAudioData(uint64_t id, ipc_pack::Writer &meters)
 {
 	std::unique_lock<std::mutex> ulockMutex(mtx);
 
+	ipc_pack::MeterHeader header = {0, 1};
 	auto meter = Manager::GetInstance().find(id);
 	if (!meter) {
-		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
+		// Keeps the records in step with the queried ids
+		meters.put(header);
+		return;
 	}
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
-
-	rval.push_back(ipc::value(meter->current_data.ch));
+	AudioData current_data = meter->Snapshot();
 
 	auto source = osn::Source::Manager::GetInstance().find(meter->uid_source);
-	bool isMuted = source ? obs_source_muted(source) : true;
-	rval.push_back(ipc::value(isMuted));
+	header.channels = uint32_t(current_data.ch);
+	header.muted = source ? obs_source_muted(source) : true;
+	meters.put(header);
 
-	if (isMuted)
+	if (header.muted)
 		return;
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
-	}
+	for (size_t ch = 0; ch < header.channels; ch++)
+		meters.put(ipc_pack::MeterChannel{current_data.magnitude[ch], current_data.peak[ch], current_data.input_peak[ch]});
 }
\ No newline at end of file
@@ -21,6 +21,8 @@
 #include <memory>
 #include <queue>
 #include <array>
+#include <atomic>
+#include <ipc-pack.hpp>
 #include "obs.h"
 #include "utility.hpp"
 
@@ -48,7 +50,7 @@ private:
 	obs_volmeter_t *self;
 	uint64_t id;
 	size_t callback_count = 0;
-	uint64_t *id2 = nullptr;
+	bool callback_attached = false;
 	uint64_t uid_source = 0;
 
 	struct AudioData {
@@ -67,8 +69,23 @@ private:
 		}
 	};
 
-	AudioData current_data;
-	std::mutex current_data_mtx;
+	// Levels published by the audio thread under a sequence lock: the audio
+	// thread is the only writer and never waits, readers retry their copy
+	// when a publication overlapped it
+	struct PublishedData {
+		std::atomic<uint32_t> sequence{0};
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> magnitude;
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> peak;
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> input_peak;
+		std::atomic<int64_t> lastUpdateTime{0};
+		std::atomic<int32_t> ch{0};
+	};
+
+	PublishedData published;
+
+	void Publish(int32_t ch, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
+		     const float input_peak[MAX_AUDIO_CHANNELS]);
+	AudioData Snapshot() const;
 
 public:
 	Volmeter(obs_fader_type type);
@@ -78,7 +95,7 @@ public:
 	static void Register(ipc::server &);
 
 	static void ClearVolmeters();
-	static void getAudioData(uint64_t id, std::vector<ipc::value> &rval);
+	static void getAudioData(uint64_t id, ipc_pack::Writer &meters);
 
 	static void Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Destroy(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
@@ -19,6 +19,9 @@
 #include "util-crashmanager.h"
 #include "util-metricsprovider.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <codecvt>
 #include <filesystem>
@@ -36,6 +39,8 @@
 #include <vector>
 #include <filesystem>
 #include <random>
+#include <shared_mutex>
+#include <unordered_map>
 
 #ifdef WIN32
 #include "StackWalker.h"
@@ -73,7 +78,6 @@ std::vector<std::string> handledOBSCrashes;
 PDH_HQUERY cpuQuery;
 PDH_HCOUNTER cpuTotal;
 std::vector<nlohmann::json> breadcrumbs;
-std::queue<std::pair<int, std::string>> lastActions;
 std::vector<std::string> warnings;
 std::mutex messageMutex;
 util::MetricsProvider metricsClient;
@@ -82,6 +86,22 @@ HANDLE memoryDumpEvent = INVALID_HANDLE_VALUE;
 std::filesystem::path memoryDumpFolder;
 #endif
 
+// IPC calls are recorded as interned (class, function) ids in a fixed size ring and only
+// turned back into names when a report is written. A ring entry packs the id in the low
+// 32 bits and, for failed calls, the error code in the 16 bits above it.
+static constexpr uint32_t MaximumInternedCalls = 4096;
+static constexpr uint64_t ServerCallRingSize = 1024; // Must be a power of two
+static constexpr size_t MaximumActionsReported = 50;
+static constexpr uint64_t ServerCallRecorded = 1ull << 62;
+static constexpr uint64_t ServerCallFailed = 1ull << 63;
+static constexpr uint64_t ServerCallNoReply = 0xFFFF;
+static std::array<std::string, MaximumInternedCalls> internedCallNames;
+static std::atomic<uint32_t> internedCallCount{1}; // Id 0 stands for calls past the table limit
+static std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>> internedCalls;
+static std::shared_mutex internedCallsMutex;
+static std::array<std::atomic<uint64_t>, ServerCallRingSize> serverCallRing;
+static std::atomic<uint64_t> serverCallHead{0};
+
 std::string appState = "starting"; // "starting","idle","encoding","shutdown"
 std::string reportServerUrl = "";
 // Crashpad variables
@@ -985,42 +1005,122 @@ nlohmann::json util::CrashManager::ComputeBreadcrumbs()
 #endif
 }
 
+static uint32_t InternServerCall(const std::string &cname, const std::string &fname)
+{
+	{
+		std::shared_lock lock(internedCallsMutex);
+		auto functions = internedCalls.find(cname);
+		if (functions != internedCalls.end()) {
+			auto id = functions->second.find(fname);
+			if (id != functions->second.end())
+				return id->second;
+		}
+	}
+
+	std::unique_lock lock(internedCallsMutex);
+	auto &functions = internedCalls[cname];
+	auto id = functions.find(fname);
+	if (id != functions.end())
+		return id->second;
+
+	uint32_t next = internedCallCount.load(std::memory_order_relaxed);
+	if (next >= MaximumInternedCalls)
+		return 0;
+
+	// The name is published before the count so the crash path can read it without the lock
+	internedCallNames[next] = cname + "::" + fname;
+	internedCallCount.store(next + 1, std::memory_order_release);
+	functions.emplace(fname, next);
+	return next;
+}
+
+static void RecordServerCall(uint64_t entry)
+{
+	uint64_t index = serverCallHead.fetch_add(1, std::memory_order_relaxed);
+	serverCallRing[index & (ServerCallRingSize - 1)].store(entry, std::memory_order_release);
+}
+
+static std::string ServerCallName(uint64_t entry)
+{
+	uint32_t id = uint32_t(entry);
+	if (id == 0 || id >= internedCallCount.load(std::memory_order_acquire))
+		return "unknown::unknown";
+	return internedCallNames[id];
+}
+
+// Visit the recorded calls from oldest to newest, slots that were never written are skipped
+template<typename Callback> static void ForEachServerCall(Callback callback)
+{
+	uint64_t head = serverCallHead.load(std::memory_order_acquire);
+	uint64_t first = head > ServerCallRingSize ? head - ServerCallRingSize : 0;
+
+	for (uint64_t index = first; index < head; index++) {
+		uint64_t entry = serverCallRing[index & (ServerCallRingSize - 1)].load(std::memory_order_acquire);
+		if (entry & ServerCallRecorded)
+			callback(entry);
+	}
+}
+
 nlohmann::json util::CrashManager::ComputeActions()
 {
-#ifdef WIN32
 	nlohmann::json result = nlohmann::json::array();
+	uint64_t last = 0;
+	int counter = 0;
 
-	while (!lastActions.empty()) {
-		auto counter = lastActions.front().first;
-		auto message = lastActions.front().second;
+	// Consecutive calls to the same method are collapsed, with the repeat count appended
+	auto flush = [&]() {
+		if (last == 0)
+			return;
 
-		// Update the message to reflect the count amount, if applicable
-		if (counter > 0) {
+		std::string message = ServerCallName(last);
+		if (counter > 0)
 			message = message + std::string("|") + std::to_string(counter);
+		result.push_back(message);
+	};
+
+	ForEachServerCall([&](uint64_t entry) {
+		if (entry & ServerCallFailed)
+			return;
+
+		if (entry == last) {
+			counter++;
+			return;
 		}
 
-		result.push_back(message);
-		lastActions.pop();
-	}
+		flush();
+		last = entry;
+		counter = 0;
+	});
+	flush();
+
+	// Only the newest actions are reported, like the old action queue did
+	if (result.size() > MaximumActionsReported)
+		result.erase(result.begin(), result.begin() + (result.size() - MaximumActionsReported));
 
 	return result;
-#else
-	return NULL;
-#endif
 }
 
 nlohmann::json util::CrashManager::ComputeWarnings()
 {
-#ifdef WIN32
-	nlohmann::json result;
+	nlohmann::json result = nlohmann::json::array();
 
+#ifdef WIN32
 	for (auto &msg : warnings)
 		result.push_back(msg);
+#endif
+
+	ForEachServerCall([&](uint64_t entry) {
+		if (!(entry & ServerCallFailed))
+			return;
+
+		uint64_t code = (entry >> 32) & 0xFFFF;
+		if (code == ServerCallNoReply)
+			result.push_back(std::string("No return params on method ") + ServerCallName(entry));
+		else
+			result.push_back(std::string("Server call returned error number ") + std::to_string(code) + " on method " + ServerCallName(entry));
+	});
 
 	return result;
-#else
-	return NULL;
-#endif
 }
 
 void BindCrtHandlesToStdHandles(bool bindStdIn, bool bindStdOut, bool bindStdErr)
@@ -1184,24 +1284,6 @@ void util::CrashManager::AddWarning(const std::string &warning)
 #endif
 }
 
-void RegisterAction(const std::string &message)
-{
-#ifdef WIN32
-	static const int MaximumActionsRegistered = 50;
-	std::lock_guard<std::mutex> lock(messageMutex);
-
-	// Check if this and the last message are the same, if true just add a counter
-	if (lastActions.size() > 0 && message.compare(lastActions.back().second) == 0) {
-		lastActions.back().first++;
-	} else {
-		lastActions.push({0, message});
-		if (lastActions.size() >= MaximumActionsRegistered) {
-			lastActions.pop();
-		}
-	}
-#endif
-}
-
 void util::CrashManager::AddBreadcrumb(const nlohmann::json &message)
 {
 #ifdef WIN32
@@ -1271,26 +1353,19 @@ std::string util::CrashManager::getAppState()
 
 void util::CrashManager::ProcessPreServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args)
 {
-	std::string jsonEntry = cname + std::string("::") + fname;
-
-	// Perform this only if this user have a high crash rate (TODO: this check must be implemented)
-	/*
-	nlohmann::json ipcValues = nlohmann::json::array();
-	IPCValuesToData(args, ipcValues);
-	jsonEntry["ipc values"] = ipcValues;
-	*/
-
-	RegisterAction(jsonEntry);
+	RecordServerCall(ServerCallRecorded | InternServerCall(cname, fname));
 }
 
 void util::CrashManager::ProcessPostServerCall(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args)
 {
-	if (args.size() == 0) {
-		AddWarning(std::string("No return params on method ") + fname + std::string(" for class ") + cname);
-	} else if ((ErrorCode)args[0].value_union.ui64 != ErrorCode::Ok) {
-		AddWarning(std::string("Server call returned error number ") + std::to_string(args[0].value_union.ui64) + " on method " + fname +
-			   std::string(" for class ") + cname);
+	uint64_t code = ServerCallNoReply;
+	if (args.size() > 0) {
+		if ((ErrorCode)args[0].value_union.ui64 == ErrorCode::Ok)
+			return;
+		code = std::min<uint64_t>(args[0].value_union.ui64, ServerCallNoReply - 1);
 	}
+
+	RecordServerCall(ServerCallRecorded | ServerCallFailed | (code << 32) | InternServerCall(cname, fname));
 }
 
 void util::CrashManager::DisableReports()
@@ -0,0 +1,175 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Framing for Batch.Apply: fire-and-forget calls packed back to back into one
+// binary value, each as [u32 class][class][u32 function][function][u32 argc]
+// followed by argc values of [u8 type][payload]. Numbers are stored at their
+// native size, strings and binaries are length prefixed.
+namespace ipc_batch {
+static inline void AppendRaw(std::vector<char> &buf, const void *data, size_t size)
+{
+	const char *bytes = reinterpret_cast<const char *>(data);
+	buf.insert(buf.end(), bytes, bytes + size);
+}
+
+static inline void AppendBytes(std::vector<char> &buf, const char *data, size_t size)
+{
+	uint32_t length = uint32_t(size);
+	AppendRaw(buf, &length, sizeof(length));
+	AppendRaw(buf, data, size);
+}
+
+static inline void Append(std::vector<char> &buf, const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args)
+{
+	AppendBytes(buf, cname.data(), cname.size());
+	AppendBytes(buf, fname.data(), fname.size());
+
+	uint32_t argc = uint32_t(args.size());
+	AppendRaw(buf, &argc, sizeof(argc));
+	for (auto &arg : args) {
+		uint8_t type = uint8_t(arg.type);
+		AppendRaw(buf, &type, sizeof(type));
+		switch (arg.type) {
+		case ipc::type::String:
+			AppendBytes(buf, arg.value_str.data(), arg.value_str.size());
+			break;
+		case ipc::type::Binary:
+			AppendBytes(buf, arg.value_bin.data(), arg.value_bin.size());
+			break;
+		case ipc::type::Float:
+			AppendRaw(buf, &arg.value_union.fp32, sizeof(float));
+			break;
+		case ipc::type::Double:
+			AppendRaw(buf, &arg.value_union.fp64, sizeof(double));
+			break;
+		case ipc::type::Int32:
+			AppendRaw(buf, &arg.value_union.i32, sizeof(int32_t));
+			break;
+		case ipc::type::Int64:
+			AppendRaw(buf, &arg.value_union.i64, sizeof(int64_t));
+			break;
+		case ipc::type::UInt32:
+			AppendRaw(buf, &arg.value_union.ui32, sizeof(uint32_t));
+			break;
+		case ipc::type::UInt64:
+			AppendRaw(buf, &arg.value_union.ui64, sizeof(uint64_t));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static inline bool ReadRaw(const std::vector<char> &buf, size_t &offset, void *data, size_t size)
+{
+	if (buf.size() - offset < size)
+		return false;
+	memcpy(data, buf.data() + offset, size);
+	offset += size;
+	return true;
+}
+
+template<typename T> static inline bool ReadValue(const std::vector<char> &buf, size_t &offset, std::vector<ipc::value> &args)
+{
+	T value;
+	if (!ReadRaw(buf, offset, &value, sizeof(value)))
+		return false;
+	args.push_back(ipc::value(value));
+	return true;
+}
+
+static inline bool ReadBytes(const std::vector<char> &buf, size_t &offset, const char *&data, size_t &size)
+{
+	uint32_t length = 0;
+	if (!ReadRaw(buf, offset, &length, sizeof(length)) || buf.size() - offset < length)
+		return false;
+	data = buf.data() + offset;
+	size = length;
+	offset += length;
+	return true;
+}
+
+// Reads the call at offset and advances past it, false at the end or on malformed input
+static inline bool Next(const std::vector<char> &buf, size_t &offset, std::string &cname, std::string &fname, std::vector<ipc::value> &args)
+{
+	const char *data = nullptr;
+	size_t size = 0;
+
+	if (offset >= buf.size() || !ReadBytes(buf, offset, data, size))
+		return false;
+	cname.assign(data, size);
+	if (!ReadBytes(buf, offset, data, size))
+		return false;
+	fname.assign(data, size);
+
+	uint32_t argc = 0;
+	if (!ReadRaw(buf, offset, &argc, sizeof(argc)))
+		return false;
+
+	args.clear();
+	for (uint32_t i = 0; i < argc; i++) {
+		uint8_t type = 0;
+		if (!ReadRaw(buf, offset, &type, sizeof(type)))
+			return false;
+
+		bool ok = false;
+		switch (ipc::type(type)) {
+		case ipc::type::String:
+			ok = ReadBytes(buf, offset, data, size);
+			if (ok)
+				args.push_back(ipc::value(std::string(data, size)));
+			break;
+		case ipc::type::Binary:
+			ok = ReadBytes(buf, offset, data, size);
+			if (ok)
+				args.push_back(ipc::value(std::vector<char>(data, data + size)));
+			break;
+		case ipc::type::Float:
+			ok = ReadValue<float>(buf, offset, args);
+			break;
+		case ipc::type::Double:
+			ok = ReadValue<double>(buf, offset, args);
+			break;
+		case ipc::type::Int32:
+			ok = ReadValue<int32_t>(buf, offset, args);
+			break;
+		case ipc::type::Int64:
+			ok = ReadValue<int64_t>(buf, offset, args);
+			break;
+		case ipc::type::UInt32:
+			ok = ReadValue<uint32_t>(buf, offset, args);
+			break;
+		case ipc::type::UInt64:
+			ok = ReadValue<uint64_t>(buf, offset, args);
+			break;
+		default:
+			break;
+		}
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Packed arrays: homogeneous numeric data (uid lists, meter levels) sent as a
+// single Binary value instead of one ipc::value per number. Elements are stored
+// back to back at their native size.
+namespace ipc_pack {
+// Per thread buffer reused across calls so building a packed reply does not
+// allocate once its capacity has grown to the usual reply size
+static inline std::vector<char> &Scratch()
+{
+	static thread_local std::vector<char> buffer;
+	buffer.clear();
+	return buffer;
+}
+
+class Writer {
+public:
+	Writer(std::vector<char> &buffer) : m_buffer(buffer) {}
+
+	void reserve(size_t bytes)
+	{
+		m_buffer.reserve(m_buffer.size() + bytes);
+	}
+
+	template<typename T> void put(const T &value)
+	{
+		put(&value, 1);
+	}
+
+	template<typename T> void put(const T *values, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "ipc_pack::Writer needs a trivially copyable type");
+		const char *bytes = reinterpret_cast<const char *>(values);
+		m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T) * count);
+	}
+
+	ipc::value value() const
+	{
+		return ipc::value(m_buffer);
+	}
+
+private:
+	std::vector<char> &m_buffer;
+};
+
+class Reader {
+public:
+	Reader(const ipc::value &value) : m_data(value.value_bin.data()), m_size(value.value_bin.size()) {}
+
+	// Fails without consuming anything when the buffer is too short
+	template<typename T> bool get(T &value)
+	{
+		return get(&value, 1);
+	}
+
+	template<typename T> bool get(T *values, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "ipc_pack::Reader needs a trivially copyable type");
+		size_t bytes = sizeof(T) * count;
+		if (m_size - m_offset < bytes)
+			return false;
+		memcpy(values, m_data + m_offset, bytes);
+		m_offset += bytes;
+		return true;
+	}
+
+	size_t remaining() const
+	{
+		return m_size - m_offset;
+	}
+
+private:
+	const char *m_data;
+	size_t m_size;
+	size_t m_offset = 0;
+};
+
+// Scene item listing: a uid and the scene local item id per item
+struct SceneItemEntry {
+	uint64_t uid;
+	int64_t itemId;
+};
+
+// Volmeter levels, one record per queried meter in query order. A record with
+// no channels belongs to a meter that no longer exists, a muted record carries
+// no levels.
+struct MeterHeader {
+	uint32_t channels;
+	uint32_t muted;
+};
+
+struct MeterChannel {
+	float magnitude;
+	float peak;
+	float inputPeak;
+};
+
+// Bulk fader access, one record per queried fader in query order. A fader that
+// no longer exists reads as silence.
+struct FaderValues {
+	float db;
+	float deflection;
+	float mul;
+};
+
+enum FaderField : int32_t { FaderDeziBel = 0, FaderDeflection = 1, FaderMultiplier = 2 };
+
+// Output telemetry, one record per sampler tick. Counters are cumulative since
+// the output started, rates are computed between consecutive samples.
+struct OutputSample {
+	uint64_t sequence;
+	uint64_t timestamp;
+	uint64_t totalBytes;
+	double kbitsPerSec;
+	float congestion;
+	uint32_t droppedFrames;
+	uint32_t totalFrames;
+	uint32_t skippedFrames;
+	uint32_t encodedFrames;
+	uint32_t laggedFrames;
+	uint32_t renderedFrames;
+	uint32_t reserved;
+};
+} // namespace ipc_pack
@@ -0,0 +1,288 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "ipc-shm.hpp"
+#include <new>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Slots start on their own cache line, away from the header's atomics
+#define SLOT_ALIGNMENT 64
+
+static size_t HeaderSize()
+{
+	return (sizeof(ipc_shm::Header) + SLOT_ALIGNMENT - 1) & ~size_t(SLOT_ALIGNMENT - 1);
+}
+
+#ifdef WIN32
+static std::wstring MappingName(const std::string &name)
+{
+	std::wstring wname(L"Local\\");
+	wname.append(name.begin(), name.end());
+	return wname;
+}
+#else
+static std::string MappingName(const std::string &name)
+{
+	return "/" + name;
+}
+#endif
+
+ipc_shm::Region::~Region()
+{
+	Close();
+}
+
+bool ipc_shm::Region::Create(const std::string &name, uint32_t slotCount, uint32_t slotSize)
+{
+	Close();
+	if (slotCount == 0 || slotCount > MAX_SLOTS || slotSize == 0)
+		return false;
+
+	size_t size = HeaderSize() + size_t(slotCount) * slotSize;
+	void *memory = nullptr;
+
+#ifdef WIN32
+	HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size & 0xFFFFFFFF),
+					    MappingName(name).c_str());
+	if (!mapping)
+		return false;
+	if (GetLastError() == ERROR_ALREADY_EXISTS) {
+		CloseHandle(mapping);
+		return false;
+	}
+
+	memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (!memory) {
+		CloseHandle(mapping);
+		return false;
+	}
+	m_mapping = mapping;
+#else
+	// A region left behind by a crashed client with a recycled pid
+	shm_unlink(MappingName(name).c_str());
+
+	int fd = shm_open(MappingName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd == -1)
+		return false;
+
+	if (ftruncate(fd, off_t(size)) != 0) {
+		close(fd);
+		shm_unlink(MappingName(name).c_str());
+		return false;
+	}
+
+	memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (memory == MAP_FAILED) {
+		shm_unlink(MappingName(name).c_str());
+		return false;
+	}
+#endif
+
+	m_header = new (memory) Header();
+	m_header->magic = MAGIC;
+	m_header->slotCount = slotCount;
+	m_header->slotSize = slotSize;
+	m_header->threshold.store(0);
+	for (uint32_t i = 0; i < MAX_SLOTS; i++)
+		m_header->slots[i].store(SLOT_FREE);
+
+	m_name = name;
+	m_size = size;
+	m_owner = true;
+	m_linked = true;
+	return true;
+}
+
+bool ipc_shm::Region::Open(const std::string &name)
+{
+	Close();
+	void *memory = nullptr;
+	size_t size = 0;
+
+#ifdef WIN32
+	HANDLE mapping = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, MappingName(name).c_str());
+	if (!mapping)
+		return false;
+
+	memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	if (!memory) {
+		CloseHandle(mapping);
+		return false;
+	}
+
+	MEMORY_BASIC_INFORMATION info = {};
+	VirtualQuery(memory, &info, sizeof(info));
+	size = info.RegionSize;
+	m_mapping = mapping;
+#else
+	int fd = shm_open(MappingName(name).c_str(), O_RDWR, 0600);
+	if (fd == -1)
+		return false;
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || size_t(st.st_size) < HeaderSize()) {
+		close(fd);
+		return false;
+	}
+	size = size_t(st.st_size);
+
+	memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (memory == MAP_FAILED)
+		return false;
+#endif
+
+	m_header = reinterpret_cast<Header *>(memory);
+	m_size = size;
+	m_name = name;
+	m_owner = false;
+	m_linked = false;
+
+	// Refuse anything that does not look like a region of ours
+	if (m_header->magic != MAGIC || m_header->slotCount > MAX_SLOTS || HeaderSize() + size_t(m_header->slotCount) * m_header->slotSize > m_size) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void ipc_shm::Region::Unlink()
+{
+#ifndef WIN32
+	// Windows drops the mapping name with its last handle
+	if (m_owner && m_linked)
+		shm_unlink(MappingName(m_name).c_str());
+#endif
+	m_linked = false;
+}
+
+void ipc_shm::Region::Close()
+{
+	if (!m_header)
+		return;
+
+	Unlink();
+#ifdef WIN32
+	UnmapViewOfFile(m_header);
+	CloseHandle((HANDLE)m_mapping);
+#else
+	munmap(m_header, m_size);
+#endif
+
+	m_header = nullptr;
+	m_mapping = nullptr;
+	m_size = 0;
+	m_owner = false;
+	m_name.clear();
+}
+
+void ipc_shm::Region::SetThreshold(uint32_t threshold)
+{
+	if (m_header)
+		m_header->threshold.store(threshold, std::memory_order_relaxed);
+}
+
+uint32_t ipc_shm::Region::Threshold() const
+{
+	return m_header ? m_header->threshold.load(std::memory_order_relaxed) : 0;
+}
+
+char *ipc_shm::Region::SlotData(uint32_t slot) const
+{
+	return reinterpret_cast<char *>(m_header) + HeaderSize() + size_t(slot) * m_header->slotSize;
+}
+
+char *ipc_shm::Region::Claim(size_t size, uint32_t &slot)
+{
+	if (!m_header)
+		return nullptr;
+
+	uint32_t threshold = Threshold();
+	if (threshold == 0 || size < threshold || size > m_header->slotSize)
+		return nullptr;
+
+	for (uint32_t i = 0; i < m_header->slotCount; i++) {
+		uint32_t expected = SLOT_FREE;
+		if (m_header->slots[i].compare_exchange_strong(expected, SLOT_BUSY, std::memory_order_acquire)) {
+			slot = i;
+			return SlotData(i);
+		}
+	}
+	return nullptr;
+}
+
+void ipc_shm::Region::Release(uint32_t slot)
+{
+	if (m_header && slot < m_header->slotCount)
+		m_header->slots[slot].store(SLOT_FREE, std::memory_order_release);
+}
+
+const char *ipc_shm::Region::Resolve(uint64_t descriptor, size_t &size) const
+{
+	uint32_t slot = uint32_t(descriptor >> 32);
+	size = size_t(uint32_t(descriptor & 0xFFFFFFFF));
+	if (!m_header || slot >= m_header->slotCount || size > m_header->slotSize)
+		return nullptr;
+	return SlotData(slot);
+}
+
+ipc_shm::View::View(Region &region, const ipc::value &value)
+{
+	switch (value.type) {
+	case ipc::type::String:
+		m_data = value.value_str.data();
+		m_size = value.value_str.size();
+		break;
+	case ipc::type::Binary:
+		m_data = value.value_bin.data();
+		m_size = value.value_bin.size();
+		break;
+	case ipc::type::UInt64:
+		m_data = region.Resolve(value.value_union.ui64, m_size);
+		if (m_data) {
+			m_region = &region;
+			m_slot = uint32_t(value.value_union.ui64 >> 32);
+			m_shared = true;
+		} else {
+			m_size = 0;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (!m_data) {
+		m_data = "";
+		m_size = 0;
+	}
+}
+
+ipc_shm::View::~View()
+{
+	if (m_shared)
+		m_region->Release(m_slot);
+}
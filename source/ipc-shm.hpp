@@ -0,0 +1,127 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "ipc-value.hpp"
+
+// Slot based shared memory region for payloads too large to push through the
+// socket. The client creates and owns the region, the server attaches to it by
+// name. A writer claims a free slot, copies its payload in and sends a UInt64
+// descriptor (slot << 32 | size) in place of the String or Binary value; the
+// reader views the bytes in place and frees the slot when it is done.
+namespace ipc_shm {
+const uint32_t MAGIC = 0x4d48534f; // 'OSHM'
+const uint32_t MAX_SLOTS = 32;
+const uint32_t SLOT_FREE = 0;
+const uint32_t SLOT_BUSY = 1;
+
+struct Header {
+	uint32_t magic;
+	uint32_t slotCount;
+	uint32_t slotSize;
+	// Payloads below this size stay inline, zero turns the region off without
+	// another round trip to the server
+	std::atomic<uint32_t> threshold;
+	std::atomic<uint32_t> slots[MAX_SLOTS];
+};
+
+class Region {
+public:
+	Region() = default;
+	~Region();
+	Region(Region const &) = delete;
+	void operator=(Region const &) = delete;
+
+	// Client side, maps a fresh region of slotCount * slotSize bytes
+	bool Create(const std::string &name, uint32_t slotCount, uint32_t slotSize);
+	// Server side, maps a region created by the client
+	bool Open(const std::string &name);
+	// Drops the name once both sides have mapped the region
+	void Unlink();
+	void Close();
+
+	bool IsOpen() const
+	{
+		return m_header != nullptr;
+	}
+	const std::string &Name() const
+	{
+		return m_name;
+	}
+
+	void SetThreshold(uint32_t threshold);
+	uint32_t Threshold() const;
+
+	// Returns a slot for a payload of the given size, or nullptr when the
+	// payload should go inline: region off, below threshold, too large or
+	// every slot busy
+	char *Claim(size_t size, uint32_t &slot);
+	void Release(uint32_t slot);
+
+	// Resolves a descriptor, claims nothing
+	const char *Resolve(uint64_t descriptor, size_t &size) const;
+
+	static uint64_t Descriptor(uint32_t slot, size_t size)
+	{
+		return (uint64_t(slot) << 32) | uint64_t(uint32_t(size));
+	}
+
+private:
+	char *SlotData(uint32_t slot) const;
+
+	std::string m_name;
+	Header *m_header = nullptr;
+	size_t m_size = 0;
+	bool m_owner = false;
+	bool m_linked = false;
+	void *m_mapping = nullptr;
+};
+
+// Read-only view of a String or Binary value that may have travelled through
+// the region, frees the slot on destruction
+class View {
+public:
+	View(Region &region, const ipc::value &value);
+	~View();
+	View(View const &) = delete;
+	void operator=(View const &) = delete;
+
+	const char *data() const
+	{
+		return m_data;
+	}
+	size_t size() const
+	{
+		return m_size;
+	}
+	std::string str() const
+	{
+		return std::string(m_data, m_size);
+	}
+
+private:
+	Region *m_region = nullptr;
+	uint32_t m_slot = 0;
+	bool m_shared = false;
+	const char *m_data = nullptr;
+	size_t m_size = 0;
+};
+} // namespace ipc_shm
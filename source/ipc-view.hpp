@@ -0,0 +1,91 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include "ipc-value.hpp"
+
+// Read-only accessors over the payload of an ipc::value so handlers can look at
+// their arguments in place instead of copying them into locals. The views are
+// only valid as long as the value they were taken from.
+namespace ipc_view {
+template<typename T> class span {
+public:
+	span() = default;
+	span(const T *data, size_t size) : m_data(data), m_size(size) {}
+
+	const T *data() const
+	{
+		return m_data;
+	}
+	size_t size() const
+	{
+		return m_size;
+	}
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+	const T &operator[](size_t index) const
+	{
+		return m_data[index];
+	}
+	const T *begin() const
+	{
+		return m_data;
+	}
+	const T *end() const
+	{
+		return m_data + m_size;
+	}
+
+private:
+	const T *m_data = nullptr;
+	size_t m_size = 0;
+};
+
+static inline std::string_view str(const ipc::value &value)
+{
+	return std::string_view(value.value_str.data(), value.value_str.size());
+}
+
+static inline span<char> bin(const ipc::value &value)
+{
+	return span<char>(value.value_bin.data(), value.value_bin.size());
+}
+
+// Binary value holding a packed array of T, trailing bytes that do not make up
+// a whole element are ignored. The binary buffer comes from the allocator, so
+// it is aligned for any fundamental type.
+template<typename T> static inline span<T> array(const ipc::value &value)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "ipc_view::array needs a trivially copyable element type");
+	return span<T>(reinterpret_cast<const T *>(value.value_bin.data()), value.value_bin.size() / sizeof(T));
+}
+
+// Same as array, bounded by a byte count sent alongside the binary
+template<typename T> static inline span<T> array(const ipc::value &value, uint64_t bytes)
+{
+	span<T> items = array<T>(value);
+	return span<T>(items.data(), std::min<size_t>(items.size(), size_t(bytes / sizeof(T))));
+}
+} // namespace ipc_view
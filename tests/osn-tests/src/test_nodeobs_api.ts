@@ -61,6 +61,30 @@ describe(testName, function() {
         expect(stats.diskSpaceAvailable).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetPerformanceStatistics, 'diskSpaceAvailable'));
     });
 
+    it('Get startup timeline', function() {
+        const timeline = osn.NodeObs.OBS_API_getStartupTimeline();
+        const names = timeline.map((event: any) => event.name);
+
+        expect(names).to.include('spawn', 'Process spawn is missing from the startup timeline');
+        expect(names).to.include('socket ready', 'Socket readiness is missing from the startup timeline');
+        expect(names).to.include('first ipc call', 'First IPC call is missing from the startup timeline');
+        expect(names).to.include('obs_startup', 'initAPI phases are missing from the startup timeline');
+
+        let previous = 0;
+        timeline.forEach((event: any) => {
+            expect(event.process).to.be.oneOf(['client', 'server'], 'Wrong startup event process');
+            expect(event.start).to.be.at.least(previous, 'Startup events are not ordered');
+            expect(event.duration).to.be.at.least(0, 'Invalid startup event duration');
+            previous = event.start;
+        });
+
+        const fs = require('fs');
+        const path = require('path');
+        const tracePath = path.join(__dirname, '..', 'osnData/slobs-client', 'node-obs', 'startup-trace.json');
+        const trace = JSON.parse(fs.readFileSync(tracePath, 'utf8'));
+        expect(trace.traceEvents.length).to.equal(timeline.length, 'Trace file does not hold the startup timeline');
+    });
+
     it('Get hotkeys of all sources and process them', function() {
         let obsHotkeys: TOBSHotkey[];
 
@@ -154,6 +178,42 @@ describe(testName, function() {
         scene.release();
     });
 
+    it('Get hotkey changes since a revision', function() {
+        const full = osn.NodeObs.OBS_API_QueryHotkeysSince(0);
+        expect(full.reset).to.equal(true, 'Query from revision 0 did not return the full list');
+
+        const sceneName = 'hotkeys_revision_scene';
+        const scene = osn.SceneFactory.create(sceneName);
+        const input = osn.InputFactory.create('color_source', 'hotkeys_revision_color');
+        const sceneItem = scene.add(input);
+
+        // Only the show and hide hotkeys of the new item are sent
+        const added = osn.NodeObs.OBS_API_QueryHotkeysSince(full.revision);
+        expect(added.reset).to.equal(false, 'Incremental query returned the full list');
+        expect(added.revision).to.be.greaterThan(full.revision, 'Revision did not advance');
+        expect(added.hotkeys.length).to.be.greaterThan(0, 'Item hotkeys were not reported');
+        added.hotkeys.forEach(function(hotkey: TOBSHotkey) {
+            expect(hotkey.ObjectName).to.equal(sceneName, 'Unrelated hotkey was reported as changed');
+        });
+
+        sceneItem.remove();
+        const removed = osn.NodeObs.OBS_API_QueryHotkeysSince(added.revision);
+        added.hotkeys.forEach(function(hotkey: TOBSHotkey) {
+            expect(removed.removed).to.include(hotkey.HotkeyId, 'Removed hotkey was not reported');
+        });
+
+        const unchanged = osn.NodeObs.OBS_API_QueryHotkeysSince(removed.revision);
+        expect(unchanged.hotkeys.length).to.equal(0, 'Hotkeys changed without any update');
+        expect(unchanged.removed.length).to.equal(0, 'Hotkeys were removed without any update');
+
+        // The cached full list agrees with the index
+        const hotkeys: TOBSHotkey[] = osn.NodeObs.OBS_API_QueryHotkeys();
+        expect(hotkeys.length).to.equal(osn.NodeObs.OBS_API_QueryHotkeysSince(0).hotkeys.length, 'Cached hotkey list is out of date');
+
+        input.release();
+        scene.release();
+    });
+
     it('Get and set the browser source acceleration', function() {
         expect(osn.NodeObs.GetBrowserAcceleration()).
             to.equal(true, 'Invalid browser source acceleration default value');
@@ -0,0 +1,90 @@
+import 'mocha'
+import { expect } from 'chai'
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler'
+import { deleteConfigFiles } from '../util/general';
+
+const testName = 'nodeobs_display';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Create offscreen display and read a frame back', () => {
+        const key = 'offscreen_display';
+
+        expect(function() {
+            osn.NodeObs.OBS_content_createOffscreenDisplay(key, 320, 180, 0);
+        }).to.not.throw();
+
+        const frame = osn.NodeObs.OBS_content_readOffscreenDisplay(key);
+        expect(frame.width).to.equal(320, 'Wrong offscreen frame width');
+        expect(frame.height).to.equal(180, 'Wrong offscreen frame height');
+        expect(frame.pixels.length).to.equal(320 * 180 * 4, 'Wrong offscreen frame size');
+        expect(frame.renderTime).to.be.greaterThan(0, 'Frame render time was not measured');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+    });
+
+    it('Render padding color into offscreen display', () => {
+        const key = 'offscreen_padding';
+
+        osn.NodeObs.OBS_content_createOffscreenDisplay(key, 320, 180, 0);
+        osn.NodeObs.OBS_content_setPaddingColor(key, 255, 0, 0, 255);
+
+        // Top left pixel lies in the padding, pixels are BGRA
+        const frame = osn.NodeObs.OBS_content_readOffscreenDisplay(key);
+        expect(frame.pixels[0]).to.be.lessThan(8, 'Wrong blue channel in padding');
+        expect(frame.pixels[1]).to.be.lessThan(8, 'Wrong green channel in padding');
+        expect(frame.pixels[2]).to.be.greaterThan(247, 'Wrong red channel in padding');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+    });
+
+    it('Get offscreen display frame timing', () => {
+        const key = 'offscreen_timing';
+        const frameCount = 10;
+
+        osn.NodeObs.OBS_content_createOffscreenDisplay(key, 320, 180, 0);
+        for (let i = 0; i < frameCount; i++) {
+            osn.NodeObs.OBS_content_readOffscreenDisplay(key);
+        }
+
+        const timing = osn.NodeObs.OBS_content_getDisplayFrameTiming(key);
+        expect(timing.frames).to.equal(frameCount, 'Wrong number of rendered frames');
+        expect(timing.average).to.be.greaterThan(0, 'Average frame time was not measured');
+        expect(timing.max).to.be.at.least(timing.average, 'Max frame time is lower than the average');
+        logInfo(testName, 'Offscreen display average frame time: ' + timing.average.toFixed(3) + 'ms');
+
+        osn.NodeObs.OBS_content_destroyDisplay(key);
+    });
+});
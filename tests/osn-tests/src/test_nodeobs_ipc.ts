@@ -0,0 +1,99 @@
+import 'mocha'
+import { expect } from 'chai'
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler'
+import { deleteConfigFiles } from '../util/general';
+import { EOBSInputTypes } from '../util/obs_enums';
+
+const testName = 'nodeobs_ipc';
+
+// Reads the settings of an input holding a payload of the given size and
+// returns the throughput in MB/s
+function measureSettingsThroughput(input: osn.IInput, size: number, iterations: number): number {
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < iterations; i++) {
+        const settings = input.slowUncachedSettings;
+        expect(settings.payload.length).to.equal(size, 'Wrong payload size');
+    }
+    const elapsed = Number(process.hrtime.bigint() - start) / 1e9;
+    return (size * iterations) / (1024 * 1024) / elapsed;
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Read large settings through shared memory', () => {
+        const payload = 'a'.repeat(256 * 1024);
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'shm_settings', { payload: payload });
+
+        expect(osn.NodeObs.IPC.enableSharedMemory(1024)).to.equal(true, 'Shared memory could not be enabled');
+        expect(input.slowUncachedSettings.payload).to.equal(payload, 'Wrong settings read through shared memory');
+
+        osn.NodeObs.IPC.disableSharedMemory();
+        expect(input.slowUncachedSettings.payload).to.equal(payload, 'Wrong settings read inline');
+
+        input.release();
+    });
+
+    it('Save settings through shared memory', () => {
+        osn.NodeObs.IPC.enableSharedMemory(1);
+
+        const settings = osn.NodeObs.OBS_settings_getSettings('Output').data;
+        expect(settings.length).to.be.greaterThan(0, 'No output settings read through shared memory');
+        expect(function() {
+            osn.NodeObs.OBS_settings_saveSettings('Output', settings);
+        }).to.not.throw();
+        expect(osn.NodeObs.OBS_settings_getSettings('Output').data).to.eql(settings, 'Settings changed after saving them unmodified');
+
+        osn.NodeObs.IPC.disableSharedMemory();
+    });
+
+    it('Benchmark settings throughput against payload size', () => {
+        const sizes = [1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024];
+        const iterations = 20;
+
+        sizes.forEach(function(size) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'shm_bench_' + size, { payload: 'b'.repeat(size) });
+
+            osn.NodeObs.IPC.disableSharedMemory();
+            const inline = measureSettingsThroughput(input, size, iterations);
+
+            osn.NodeObs.IPC.enableSharedMemory(1);
+            const shared = measureSettingsThroughput(input, size, iterations);
+            osn.NodeObs.IPC.disableSharedMemory();
+
+            logInfo(testName, (size / 1024) + 'KB payload: ' + inline.toFixed(1) + 'MB/s inline, ' + shared.toFixed(1) + 'MB/s shared memory');
+            input.release();
+        });
+    });
+});
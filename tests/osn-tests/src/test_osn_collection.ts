@@ -0,0 +1,206 @@
+import 'mocha'
+import { expect } from 'chai'
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { OBSHandler } from '../util/obs_handler'
+import { deleteConfigFiles } from '../util/general';
+import { EOBSInputTypes, EOBSFilterTypes } from '../util/obs_enums';
+
+const testName = 'osn-collection';
+
+function itemInfo(name: string, x: number, y: number): osn.ISceneItemInfo {
+    return {
+        name: name,
+        crop: { left: 0, top: 0, right: 0, bottom: 0 },
+        scaleX: 1,
+        scaleY: 1,
+        visible: true,
+        x: x,
+        y: y,
+        rotation: 0,
+        streamVisible: true,
+        recordingVisible: true,
+        scaleFilter: osn.EScaleType.Disable,
+        blendingMode: osn.EBlendingMode.Normal
+    };
+}
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Load a collection with sources, filters, scenes and items', () => {
+        const result = osn.loadCollection({
+            sources: [
+                {
+                    name: 'collection_color_1',
+                    type: EOBSInputTypes.ColorSource,
+                    settings: { width: 400, height: 300 },
+                    filters: [{ name: 'collection_filter', type: EOBSFilterTypes.Color, settings: {}, enabled: false }],
+                    muted: false,
+                    volume: 1,
+                    syncOffset: { sec: 0, nsec: 0 },
+                    deinterlaceMode: osn.EDeinterlaceMode.Disable,
+                    deinterlaceFieldOrder: osn.EDeinterlaceFieldOrder.Top
+                },
+                {
+                    name: 'collection_color_2',
+                    type: EOBSInputTypes.ColorSource,
+                    settings: {},
+                    filters: [],
+                    muted: false,
+                    volume: 1,
+                    syncOffset: { sec: 0, nsec: 0 },
+                    deinterlaceMode: osn.EDeinterlaceMode.Disable,
+                    deinterlaceFieldOrder: osn.EDeinterlaceFieldOrder.Top
+                }
+            ],
+            scenes: [
+                {
+                    name: 'collection_scene',
+                    items: [itemInfo('collection_color_1', 10, 20), itemInfo('collection_color_2', 30, 40)]
+                }
+            ]
+        });
+
+        expect(result.failed.length).to.equal(0, 'Some collection entries failed to load');
+        expect(result.inputs.length).to.equal(2, 'Wrong number of loaded inputs');
+        expect(result.inputs[0].name).to.equal('collection_color_1', 'Wrong input name');
+        expect(result.inputs[0].settings.width).to.equal(400, 'Input settings were not applied');
+
+        const filter = result.inputs[0].findFilter('collection_filter');
+        expect(filter).to.not.equal(undefined, 'Filter was not added to the input');
+        expect(filter.enabled).to.equal(false, 'Filter enabled state was not applied');
+
+        expect(result.scenes.length).to.equal(1, 'Wrong number of loaded scenes');
+        expect(result.scenes[0].scene.name).to.equal('collection_scene', 'Wrong scene name');
+        expect(result.scenes[0].items.length).to.equal(2, 'Wrong number of scene items');
+        expect(result.scenes[0].items[1].source.name).to.equal('collection_color_2', 'Wrong scene item source');
+        expect(result.scenes[0].items[1].position.x).to.equal(30, 'Scene item position was not applied');
+        expect(result.scenes[0].scene.getItems().length).to.equal(2, 'Scene does not hold the loaded items');
+
+        result.scenes[0].scene.release();
+        result.inputs.forEach(function(input) {
+            input.release();
+        });
+    });
+
+    it('Load inputs concurrently', () => {
+        const sources: osn.SourceInfo[] = [];
+        for (let i = 0; i < 16; i++) {
+            // Image sources touch graphics when created and stay on the loading thread
+            sources.push({
+                name: 'collection_parallel_' + i,
+                type: (i % 4 == 0) ? EOBSInputTypes.ImageSource : EOBSInputTypes.ColorSource,
+                settings: { width: 100 + i },
+                filters: [{ name: 'collection_parallel_filter', type: EOBSFilterTypes.Color, settings: {}, enabled: true }],
+                muted: false,
+                volume: 1,
+                syncOffset: { sec: 0, nsec: 0 },
+                deinterlaceMode: osn.EDeinterlaceMode.Disable,
+                deinterlaceFieldOrder: osn.EDeinterlaceFieldOrder.Top
+            });
+        }
+
+        const result = osn.loadCollection({ sources: sources, scenes: [], workers: 4 });
+
+        expect(result.failed.length).to.equal(0, 'Some inputs failed to load');
+        expect(result.inputs.length).to.equal(sources.length, 'Wrong number of loaded inputs');
+        expect(result.createTimes.length).to.equal(sources.length, 'Missing input construction times');
+
+        const totalCreateTime = result.createTimes.reduce((sum, time) => sum + time, 0);
+        logInfo(testName, 'Constructed ' + sources.length + ' inputs in ' + totalCreateTime.toFixed(3) + 'ms of constructor time');
+
+        // Inputs come back in the order they were described, whichever thread built them
+        result.inputs.forEach(function(input, index) {
+            expect(input.name).to.equal('collection_parallel_' + index, 'Wrong input order');
+            expect(input.id).to.equal(sources[index].type, 'Wrong input type');
+            expect(input.settings.width).to.equal(100 + index, 'Input settings were not applied');
+            expect(input.filters.length).to.equal(1, 'Filter was not added to the input');
+            expect(result.createTimes[index]).to.be.greaterThan(0, 'Input construction was not timed');
+            input.release();
+        });
+    });
+
+    it('Report sources that fail to load', () => {
+        const result = osn.loadCollection({
+            sources: [],
+            scenes: [{ name: 'collection_missing', items: [itemInfo('collection_does_not_exist', 0, 0)] }]
+        });
+
+        expect(result.failed).to.include('collection_does_not_exist', 'Missing source was not reported');
+        expect(result.scenes[0].items.length).to.equal(1, 'Failed item did not keep its slot');
+        expect(result.scenes[0].items[0]).to.equal(null, 'Item was created for a missing source');
+
+        result.scenes[0].scene.release();
+    });
+
+    it('Add items to an existing scene on another canvas', () => {
+        const context = osn.VideoFactory.create();
+        context.video = {
+            fpsNum: 30,
+            fpsDen: 1,
+            baseWidth: 1080,
+            baseHeight: 1920,
+            outputWidth: 1080,
+            outputHeight: 1920,
+            outputFormat: osn.EVideoFormat.NV12,
+            colorspace: osn.EColorSpace.CS709,
+            range: osn.ERangeType.Partial,
+            scaleType: osn.EScaleType.Lanczos,
+            fpsType: osn.EFPSType.Fractional
+        };
+
+        // An input already owns the name, it must not get a scene twin
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'collection_canvas_color', {});
+        const scene = osn.SceneFactory.create('collection_canvas_scene');
+        // Scale is left out, client cache and server must agree on the default
+        const unscaled = { ...itemInfo('collection_canvas_color', 5, 6), scaleX: undefined, scaleY: undefined };
+        const items = osn.addItems(scene, [itemInfo('collection_does_not_exist', 0, 0), unscaled], context);
+
+        expect(items.length).to.equal(2, 'Results do not line up with the described items');
+        expect(items[0]).to.equal(null, 'Item was created for a missing source');
+        expect(items[1].source.name).to.equal('collection_canvas_color', 'Wrong scene item source');
+        expect(items[1].video.video.baseWidth).to.equal(1080, 'Item was not added to the requested canvas');
+        expect(items[1].scale.x).to.equal(1, 'Wrong default scale');
+        expect(items[1].scale.y).to.equal(1, 'Wrong default scale');
+        expect(scene.getItems().length).to.equal(1, 'Scene does not hold the added item');
+
+        const clash = osn.loadCollection({ sources: [], scenes: [{ name: 'collection_canvas_color', items: [] }] });
+        expect(clash.scenes[0]).to.equal(null, 'A scene was created with the name of an input');
+        expect(clash.failed).to.include('collection_canvas_color', 'Name clash was not reported');
+
+        items[1].remove();
+        scene.release();
+        input.release();
+        context.destroy();
+    });
+});
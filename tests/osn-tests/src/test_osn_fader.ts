@@ -158,4 +158,65 @@ describe(testName, () => {
             expect(multiplier).to.equal(1, GetErrorMessage(ETestErrorMsg.Multiplier, faderTypeStr));
         });
     });
+
+    it('Get and set many faders in one call', () => {
+        const faders: osn.IFader[] = [];
+        for (let i = 0; i < 32; i++) {
+            faders.push(osn.FaderFactory.create(osn.EFaderType.Cubic));
+        }
+
+        const levels = faders.map((fader, index) => -index);
+        const set = osn.FaderFactory.setValues(faders, osn.EFaderField.DeziBel, levels);
+        expect(set.length).to.equal(faders.length, 'Wrong number of fader values');
+
+        const values = osn.FaderFactory.getValues(faders);
+        values.forEach(function(value, index) {
+            expect(value.db).to.be.closeTo(-index, 0.001, 'Bulk decibel value was not applied');
+            expect(value.db).to.be.closeTo(faders[index].db, 0.001, 'Bulk and single decibel values differ');
+            expect(value.mul).to.be.closeTo(faders[index].mul, 0.001, 'Bulk and single multipliers differ');
+            expect(value.deflection).to.be.closeTo(faders[index].deflection, 0.001, 'Bulk and single deflections differ');
+        });
+
+        // Non-finite values are clamped before they reach libobs
+        const clamped = osn.FaderFactory.setValues(faders.slice(0, 2), osn.EFaderField.Deflection, [NaN, Infinity]);
+        expect(clamped[0].deflection).to.equal(0, 'NaN deflection was not clamped');
+        expect(clamped[1].deflection).to.equal(1, 'Infinite deflection was not clamped');
+
+        // The same work through one call per fader and value
+        const iterations = 10;
+        let start = process.hrtime.bigint();
+        for (let i = 0; i < iterations; i++) {
+            faders.forEach(function(fader) {
+                fader.db;
+                fader.deflection;
+                fader.mul;
+            });
+        }
+        const single = Number(process.hrtime.bigint() - start) / 1e6 / iterations;
+
+        start = process.hrtime.bigint();
+        for (let i = 0; i < iterations; i++) {
+            osn.FaderFactory.getValues(faders);
+        }
+        const bulk = Number(process.hrtime.bigint() - start) / 1e6 / iterations;
+        logInfo(testName, 'Reading ' + faders.length + ' faders: ' + single.toFixed(3) + 'ms per value, ' + bulk.toFixed(3) + 'ms in bulk');
+
+        faders.forEach(function(fader) {
+            fader.destroy();
+        });
+    });
+
+    it('Benchmark level sanitization kernels', () => {
+        const sizes = [24, 256, 4096];
+
+        sizes.forEach(function(size) {
+            const iterations = Math.ceil(1000000 / size);
+            const timing = osn.FaderFactory.benchmarkSanitize(size, iterations);
+            expect(timing).to.not.equal(undefined, 'Vector and scalar kernels disagree');
+
+            const scalar = timing.scalar / (size * iterations);
+            const simd = timing.simd / (size * iterations);
+            logInfo(testName, size + ' levels: ' + scalar.toFixed(3) + 'ns scalar, ' + simd.toFixed(3) + 'ns simd per level');
+        });
+    });
 });
@@ -110,6 +110,17 @@ describe(testName, () => {
         expect(locale).to.equal('pt-BR', GetErrorMessage(ETestErrorMsg.Locale));
     });
 
+    it('Set output stop deadline and get it', () => {
+        const deadline = osn.Global.outputStopDeadline;
+        expect(deadline).to.equal(20000, 'Wrong default output stop deadline');
+
+        osn.Global.outputStopDeadline = 5000;
+        expect(osn.Global.outputStopDeadline).to.equal(5000, 'Output stop deadline was not set');
+        expect(osn.Global.pendingOutputs).to.equal(0, 'Outputs are pending without any output');
+
+        osn.Global.outputStopDeadline = deadline;
+    });
+
     it('Fail test - Get source from empty output channel', () => {
         let input: ISource;
         let channel: number = 5;
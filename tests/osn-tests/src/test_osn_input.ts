@@ -236,6 +236,29 @@ describe(testName, () => {
         });
     });
 
+    it('Create inputs and read their settings asynchronously', async () => {
+        const names = ['async_color_1', 'async_color_2', 'async_color_3'];
+
+        // All creations are in flight at the same time
+        const inputs = await Promise.all(names.map(function(name, index) {
+            return osn.InputFactory.createAsync(EOBSInputTypes.ColorSource, name, { width: 100 + index });
+        }));
+
+        for (let i = 0; i < inputs.length; i++) {
+            expect(inputs[i].name).to.equal(names[i], GetErrorMessage(ETestErrorMsg.InputName, EOBSInputTypes.ColorSource));
+
+            const settings = await inputs[i].getSettingsAsync();
+            expect(settings.width).to.equal(100 + i, GetErrorMessage(ETestErrorMsg.InputSetting, EOBSInputTypes.ColorSource));
+
+            const properties = await inputs[i].getPropertiesAsync();
+            expect(properties.first()).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.InputSetting, EOBSInputTypes.ColorSource));
+        }
+
+        inputs.forEach(function(input) {
+            input.release();
+        });
+    });
+
     it('Get volume value from input source', () => {
         let volume: number = undefined;
 
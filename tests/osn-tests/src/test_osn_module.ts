@@ -82,4 +82,22 @@ describe(testName, () => {
         // Checking if returned modules are the ones opened
         expect(modules).to.include.members(moduleTypes, GetErrorMessage(ETestErrorMsg.Modules));
     });
+
+    it('Get module load timings', () => {
+        const timings = osn.ModuleFactory.loadTimings();
+        expect(timings.length).to.be.greaterThan(0, 'No module load timings were recorded');
+
+        const loaded = timings.filter(timing => timing.loaded);
+        expect(loaded.length).to.be.greaterThan(0, 'No module was reported as loaded');
+
+        loaded.forEach(function(timing) {
+            expect(timing.binPath).to.not.equal('', 'Module binary path is empty');
+            expect(timing.openTime).to.be.at.least(0, 'Invalid module open time');
+            expect(timing.initTime).to.be.at.least(0, 'Invalid module init time');
+        });
+
+        // Modules opened through the factory in the previous test are timed as well
+        const opened = timings.filter(timing => timing.openTime > 0);
+        expect(opened.length).to.be.greaterThan(0, 'Opened modules did not report an open time');
+    });
 });
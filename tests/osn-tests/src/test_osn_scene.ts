@@ -295,6 +295,59 @@ describe(testName, () => {
         scene.release();
     });
 
+    it('Get all scene items in a scene asynchronously', async () => {
+        const sceneName = 'getItemsAsync_test';
+        const scene = osn.SceneFactory.create(sceneName);
+        const firstInput = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'getItemsAsync_input1');
+        const secondInput = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'getItemsAsync_input2');
+        const firstSceneItem = scene.add(firstInput);
+        const secondSceneItem = scene.add(secondInput);
+
+        const sceneItems = await scene.getItemsAsync();
+        expect(sceneItems.length).to.equal(2, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+        expect(sceneItems[0].source.name).to.equal('getItemsAsync_input1', ETestErrorMsg.SceneItemPosition);
+        expect(sceneItems[1].source.name).to.equal('getItemsAsync_input2', ETestErrorMsg.SceneItemPosition);
+
+        firstSceneItem.source.release();
+        firstSceneItem.remove();
+        secondSceneItem.source.release();
+        secondSceneItem.remove();
+        scene.release();
+    });
+
+    it('Get scene items after moving one', async () => {
+        const sceneName = 'moveItemOrder_test';
+        const inputNames = ['moveItemOrder_input1', 'moveItemOrder_input2', 'moveItemOrder_input3'];
+        const scene = osn.SceneFactory.create(sceneName);
+        const sceneItems = inputNames.map(name => scene.add(osn.InputFactory.create(EOBSInputTypes.ImageSource, name)));
+
+        // Caching the current order first so moveItem has to replace it
+        expect(scene.getItems().map(item => item.source.name)).to.eql(inputNames, ETestErrorMsg.SceneItemPosition);
+
+        // Moving the back most item to the front
+        scene.moveItem(2, 0);
+
+        const expectedNames = [inputNames[1], inputNames[2], inputNames[0]];
+        const movedSceneItems = scene.getItems();
+        expect(movedSceneItems.map(item => item.source.name)).to.eql(expectedNames, ETestErrorMsg.SceneItemPositionAfterMove);
+        expect(movedSceneItems.map(item => item.id)).to.eql([sceneItems[1].id, sceneItems[2].id, sceneItems[0].id], ETestErrorMsg.SceneItemPositionAfterMove);
+
+        // The cached order has to match what the server reports. Removing an item drops the
+        // cached order, so the next query is answered by the server
+        const extraSceneItem = scene.add(osn.InputFactory.create(EOBSInputTypes.ImageSource, 'moveItemOrder_extra'));
+        extraSceneItem.source.release();
+        extraSceneItem.remove();
+
+        const serverSceneItems = await scene.getItemsAsync();
+        expect(serverSceneItems.map(item => item.source.name)).to.eql(expectedNames, ETestErrorMsg.SceneItemPositionAfterMove);
+
+        sceneItems.forEach(sceneItem => {
+            sceneItem.source.release();
+            sceneItem.remove();
+        });
+        scene.release();
+    });
+
     it('Fail test - Get scene from name that don\'t exist ', () => {
         expect(function() {
             const failSceneFromName = osn.SceneFactory.fromName('does_not_exist');
@@ -367,6 +367,37 @@ describe(testName, () => {
         sceneItem.remove();
     });
 
+    it('Move a multi-selection of scene items', async () => {
+        const scene = osn.SceneFactory.fromName(sceneName);
+        const source = osn.InputFactory.fromName(sourceName);
+        const sceneItems: osn.ISceneItem[] = [];
+        for (let i = 0; i < 30; i++) {
+            sceneItems.push(scene.add(source));
+        }
+
+        // Consecutive setters are sent to the server as one batch, in order
+        sceneItems.forEach(function(sceneItem, index) {
+            sceneItem.position = { x: index, y: 1 };
+            sceneItem.position = { x: index * 2, y: 2 };
+            sceneItem.scale = { x: 0.5, y: 0.5 };
+            sceneItem.rotation = index;
+        });
+        await Promise.resolve();
+
+        sceneItems.forEach(function(sceneItem, index) {
+            const info = sceneItem.transformInfo;
+            expect(info.pos.x).to.be.closeTo(index * 2, 0.001, GetErrorMessage(ETestErrorMsg.PositionX));
+            expect(info.pos.y).to.be.closeTo(2, 0.001, GetErrorMessage(ETestErrorMsg.PositionY));
+            expect(info.scale.x).to.be.closeTo(0.5, 0.001, GetErrorMessage(ETestErrorMsg.ScaleX));
+            expect(info.rot).to.be.closeTo(index, 0.001, GetErrorMessage(ETestErrorMsg.Rotation));
+        });
+
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.remove();
+        });
+        source.release();
+    });
+
     it('Set crop value and get it', () => {
         let crop: ICrop = {top: 5, bottom: 5, left: 3, right:3};
 
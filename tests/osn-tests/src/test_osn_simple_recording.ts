@@ -419,4 +419,297 @@ describe(testName, () => {
 
         osn.SimpleRecordingFactory.destroy(recording);
     });
+
+    it('Get simple recording telemetry', async () => {
+        const recording = osn.SimpleRecordingFactory.create();
+        recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+        recording.format = ERecordingFormat.MP4;
+        recording.quality = ERecordingQuality.HighQuality;
+        recording.video = obs.defaultVideoContext;
+        recording.videoEncoder =
+            osn.VideoEncoderFactory.create('obs_x264', 'video-encoder');
+        recording.audioEncoder = osn.AudioEncoderFactory.create();
+        recording.signalHandler = (signal) => {obs.signals.push(signal)};
+
+        const pushed: osn.IOutputTelemetrySample[] = [];
+        recording.telemetryHandler = (samples) => { pushed.push(...samples); };
+
+        recording.start();
+
+        let signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        await sleep(3000);
+
+        const history = recording.getTelemetry();
+        expect(history.length).to.be.greaterThan(2, 'Recording was not sampled');
+        for (let i = 1; i < history.length; i++) {
+            expect(history[i].sequence).to.equal(history[i - 1].sequence + 1, 'Telemetry samples are not consecutive');
+            expect(history[i].totalBytes).to.be.at.least(history[i - 1].totalBytes, 'Recorded bytes went backwards');
+        }
+        expect(history[history.length - 1].totalBytes).to.be.greaterThan(0, 'No bytes were recorded');
+
+        const last = history[history.length - 1].sequence;
+        expect(recording.getTelemetry(last).length).to.equal(0, 'Samples before the given sequence were returned');
+        expect(pushed.length).to.be.greaterThan(0, 'Telemetry handler was not called');
+
+        recording.telemetryHandler = null;
+        recording.stop();
+
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+
+        osn.SimpleRecordingFactory.destroy(recording);
+    });
+
+    it('Destroy simple recording while it is active', async () => {
+        const recording = osn.SimpleRecordingFactory.create();
+        recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+        recording.format = ERecordingFormat.MP4;
+        recording.quality = ERecordingQuality.HighQuality;
+        recording.video = obs.defaultVideoContext;
+        recording.videoEncoder =
+            osn.VideoEncoderFactory.create('obs_x264', 'video-encoder');
+        recording.audioEncoder = osn.AudioEncoderFactory.create();
+
+        // Signals of the torn down output must not reach the queue shared with the other tests
+        const signals: osn.EOutputSignal[] = [];
+        recording.signalHandler = (signal) => {signals.push(signal)};
+
+        recording.start();
+
+        for (let i = 0; i < 100 && signals.length == 0; i++) {
+            await sleep(100);
+        }
+
+        expect(signals.length).to.be.greaterThan(0, 'Recording did not signal its start');
+        if (signals[0].signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputDidNotStart, signals[0].code.toString(), signals[0].error));
+        }
+
+        await sleep(500);
+
+        // Teardown finishes in the background, destroying must not wait for it
+        const destroyStart = Date.now();
+        osn.SimpleRecordingFactory.destroy(recording);
+        expect(osn.Global.pendingOutputs).to.be.at.most(1, 'Wrong number of pending outputs');
+        expect(Date.now() - destroyStart).to.be.lessThan(1000, 'Destroying an active recording blocked');
+
+        for (let i = 0; i < 50 && osn.Global.pendingOutputs > 0; i++) {
+            await sleep(100);
+        }
+        expect(osn.Global.pendingOutputs).to.equal(0, 'Recording was not torn down');
+    });
+
+    it('Share video encoder between simple recordings', async () => {
+        const recordings: osn.ISimpleRecording[] = [];
+        for (let i = 0; i < 2; i++) {
+            const recording = osn.SimpleRecordingFactory.create();
+            recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+            recording.format = ERecordingFormat.MP4;
+            recording.quality = ERecordingQuality.HighQuality;
+            recording.fileFormat = 'shared-encoder-' + i + '-%CCYY-%MM-%DD %hh-%mm-%ss';
+            recording.video = obs.defaultVideoContext;
+            recording.videoEncoder =
+                osn.VideoEncoderFactory.create('obs_x264', 'video-encoder-' + i);
+            recording.audioEncoder = osn.AudioEncoderFactory.create();
+            recording.signalHandler = (signal) => {obs.signals.push(signal)};
+            recordings.push(recording);
+        }
+
+        expect(osn.Global.encoderSharing).to.equal(true, 'Encoder sharing is not enabled by default');
+
+        for (const recording of recordings) {
+            recording.start();
+
+            const signalInfo = await obs.getNextSignalInfo(
+                EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+            if (signalInfo.signal == EOBSOutputSignal.Stop) {
+                throw Error(GetErrorMessage(
+                    ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+            }
+        }
+
+        // The second recording encodes with the first one's encoder, its own stays idle
+        expect(recordings[0].videoEncoder.active).to.equal(true, 'First video encoder is not active');
+        expect(recordings[1].videoEncoder.active).to.equal(false, 'Identical video encoders were not shared');
+
+        await sleep(500);
+
+        for (const recording of recordings) {
+            recording.stop();
+
+            await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+            const signalInfo = await obs.getNextSignalInfo(
+                EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+            if (signalInfo.code != 0) {
+                throw Error(GetErrorMessage(
+                    ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+            }
+
+            await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        }
+
+        for (const recording of recordings) {
+            osn.SimpleRecordingFactory.destroy(recording);
+        }
+    });
+
+    it('Start simple recording again right after stopping it', async () => {
+        const recording = osn.SimpleRecordingFactory.create();
+        recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+        recording.format = ERecordingFormat.MP4;
+        recording.quality = ERecordingQuality.HighQuality;
+        recording.video = obs.defaultVideoContext;
+        recording.videoEncoder =
+            osn.VideoEncoderFactory.create('obs_x264', 'video-encoder');
+        recording.audioEncoder = osn.AudioEncoderFactory.create();
+        recording.signalHandler = (signal) => {obs.signals.push(signal)};
+
+        recording.start();
+
+        let signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        await sleep(500);
+
+        // The first output is still stopping when the second one is created
+        recording.stop();
+        recording.start();
+
+        // Signals the first output queued before the restart may still come first
+        do {
+            signalInfo = await obs.getNextSignalInfo(
+                EOBSOutputType.Recording, EOBSOutputSignal.Start);
+        } while (signalInfo.signal != EOBSOutputSignal.Start);
+
+        await sleep(1000);
+
+        recording.stop();
+
+        // A late stop of the first output would show up ahead of the stopping signal
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+        expect(signalInfo.signal).to.equal(
+            EOBSOutputSignal.Stopping, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        expect(signalInfo.signal).to.equal(
+            EOBSOutputSignal.Stop, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+        signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        expect(signalInfo.signal).to.equal(
+            EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.RecordingOutput));
+
+        osn.SimpleRecordingFactory.destroy(recording);
+    });
+
+    it('Restart a simple recording with new settings while its encoder is shared', async () => {
+        const recordings: osn.ISimpleRecording[] = [];
+        for (let i = 0; i < 2; i++) {
+            const recording = osn.SimpleRecordingFactory.create();
+            recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+            recording.format = ERecordingFormat.MP4;
+            recording.quality = ERecordingQuality.HighQuality;
+            recording.fileFormat = 'unshare-encoder-' + i + '-%CCYY-%MM-%DD %hh-%mm-%ss';
+            recording.video = obs.defaultVideoContext;
+            recording.videoEncoder =
+                osn.VideoEncoderFactory.create('obs_x264', 'unshare-video-encoder-' + i);
+            recording.audioEncoder = osn.AudioEncoderFactory.create();
+            recording.signalHandler = (signal) => {obs.signals.push(signal)};
+            recordings.push(recording);
+        }
+
+        for (const recording of recordings) {
+            recording.start();
+
+            const signalInfo = await obs.getNextSignalInfo(
+                EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+            if (signalInfo.signal == EOBSOutputSignal.Stop) {
+                throw Error(GetErrorMessage(
+                    ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+            }
+        }
+
+        // The second recording keeps encoding with the first one's encoder
+        const sharedEncoder = recordings[0].videoEncoder;
+        const sharedCrf = sharedEncoder.settings.crf;
+
+        await sleep(500);
+
+        recordings[0].stop();
+        await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+        await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+        await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        expect(sharedEncoder.active).to.equal(true, 'Shared video encoder stopped with its owner');
+
+        recordings[0].quality = ERecordingQuality.HigherQuality;
+        recordings[0].start();
+
+        const signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.Recording, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.RecordOutputDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        // The new settings went to a duplicate kept on the server, the client still sees its own encoder
+        expect(recordings[0].videoEncoder.name).to.equal(sharedEncoder.name, 'Video encoder of the recording was replaced');
+        expect(sharedEncoder.active).to.equal(true, 'Shared video encoder is not active');
+        expect(sharedEncoder.settings.crf).to.equal(sharedCrf, 'Shared video encoder settings changed');
+
+        await sleep(500);
+
+        for (const recording of recordings) {
+            recording.stop();
+
+            await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Stopping);
+            const stopInfo = await obs.getNextSignalInfo(
+                EOBSOutputType.Recording, EOBSOutputSignal.Stop);
+
+            if (stopInfo.code != 0) {
+                throw Error(GetErrorMessage(
+                    ETestErrorMsg.RecordOutputStoppedWithError, stopInfo.code.toString(), stopInfo.error));
+            }
+
+            await obs.getNextSignalInfo(EOBSOutputType.Recording, EOBSOutputSignal.Wrote);
+        }
+
+        for (const recording of recordings) {
+            osn.SimpleRecordingFactory.destroy(recording);
+        }
+    });
 });
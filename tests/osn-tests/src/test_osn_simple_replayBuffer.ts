@@ -68,6 +68,8 @@ describe(testName, () => {
             '', "Invalid muxerSettings default value");
         expect(replayBuffer.duration).to.equal(
             20, "Invalid duration default value");
+        expect(replayBuffer.maxSize).to.equal(
+            512, "Invalid maxSize default value");
         expect(replayBuffer.prefix).to.equal(
             'Replay', "Invalid prefix default value");
         expect(replayBuffer.suffix).to.equal(
@@ -81,6 +83,7 @@ describe(testName, () => {
         replayBuffer.noSpace = false;
         replayBuffer.video = obs.defaultVideoContext;
         replayBuffer.duration = 60;
+        replayBuffer.maxSize = 128;
         replayBuffer.prefix = 'Prefix';
         replayBuffer.suffix = 'Suffix';
         replayBuffer.usesStream = true;
@@ -95,6 +98,8 @@ describe(testName, () => {
             false, "Invalid noSpace value");
         expect(replayBuffer.duration).to.equal(
             60, "Invalid duration value");
+        expect(replayBuffer.maxSize).to.equal(
+            128, "Invalid maxSize value");
         expect(replayBuffer.prefix).to.equal(
             'Prefix', "Invalid prefix value");
         expect(replayBuffer.suffix).to.equal(
@@ -375,4 +380,81 @@ describe(testName, () => {
         osn.SimpleRecordingFactory.destroy(recording);
         osn.SimpleStreamingFactory.destroy(stream);
     });
+
+    it('Benchmark simple replay buffer saves', async () => {
+        const saveCount = 5;
+        const replayBuffer = osn.SimpleReplayBufferFactory.create();
+        replayBuffer.path = path.join(path.normalize(__dirname), '..', 'osnData');
+        replayBuffer.format = osn.ERecordingFormat.MP4;
+        replayBuffer.video = obs.defaultVideoContext;
+        replayBuffer.signalHandler = (signal) => {obs.signals.push(signal)};
+        replayBuffer.duration = 30;
+        replayBuffer.maxSize = 64;
+
+        const recording = osn.SimpleRecordingFactory.create();
+        recording.path = path.join(path.normalize(__dirname), '..', 'osnData');
+        recording.format = osn.ERecordingFormat.MP4;
+        recording.quality = osn.ERecordingQuality.HigherQuality;
+        recording.video = obs.defaultVideoContext;
+        recording.videoEncoder =
+            osn.VideoEncoderFactory.create('obs_x264', 'video-encoder');
+        recording.audioEncoder = osn.AudioEncoderFactory.create();
+        replayBuffer.recording = recording;
+
+        replayBuffer.start();
+        recording.start();
+
+        let signalInfo = await obs.getNextSignalInfo(
+            EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Start);
+
+        if (signalInfo.signal == EOBSOutputSignal.Stop) {
+            throw Error(GetErrorMessage(
+                ETestErrorMsg.ReplayBufferDidNotStart, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        await sleep(2000);
+
+        const before = replayBuffer.getTelemetry();
+        const laggedBefore = osn.Global.laggedFrames;
+        const saveTimes: number[] = [];
+
+        for (let i = 0; i < saveCount; i++) {
+            const saveStart = Date.now();
+            replayBuffer.save();
+
+            await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Writing);
+            signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Wrote);
+            expect(signalInfo.signal).to.equal(EOBSOutputSignal.Wrote, GetErrorMessage(ETestErrorMsg.ReplayBuffer));
+            saveTimes.push(Date.now() - saveStart);
+        }
+
+        await sleep(1000);
+
+        const after = replayBuffer.getTelemetry();
+        const first = before[before.length - 1];
+        const last = after[after.length - 1];
+        const encoded = last.encodedFrames - first.encodedFrames;
+        const skipped = last.skippedFrames - first.skippedFrames;
+        const dropped = last.droppedFrames - first.droppedFrames;
+
+        logInfo(testName, 'Replay buffer saves: ' + saveTimes.join('ms, ') + 'ms');
+        logInfo(testName, 'Frames while saving: ' + encoded + ' encoded, ' + skipped + ' skipped, ' + dropped + ' dropped, ' +
+            (osn.Global.laggedFrames - laggedBefore) + ' lagged, ' + last.kbitsPerSec.toFixed(0) + ' kbps');
+
+        expect(encoded).to.be.greaterThan(0, 'No frames were encoded while saving');
+        expect(skipped + dropped).to.be.lessThan(Math.max(2, encoded * 0.02), 'Saving the replay buffer stalled encoding');
+
+        replayBuffer.stop();
+        recording.stop();
+
+        await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stopping);
+        signalInfo = await obs.getNextSignalInfo(EOBSOutputType.ReplayBuffer, EOBSOutputSignal.Stop);
+
+        if (signalInfo.code != 0) {
+            throw Error(GetErrorMessage(ETestErrorMsg.ReplayBufferStoppedWithError, signalInfo.code.toString(), signalInfo.error));
+        }
+
+        osn.SimpleReplayBufferFactory.destroy(replayBuffer);
+        osn.SimpleRecordingFactory.destroy(recording);
+    });
 });
@@ -1,12 +1,13 @@
 import 'mocha'
 import { expect } from 'chai'
 import * as osn from '../osn';
+import path = require('path');
 import { logInfo, logEmptyLine } from '../util/logger';
 import { IScene, ITransition, ISettings, ISource } from '../osn';
 import { OBSHandler } from '../util/obs_handler';
-import { deleteConfigFiles } from '../util/general';
+import { deleteConfigFiles, sleep } from '../util/general';
 import * as transitionSettings from '../util/transition_settings';
-import { EOBSTransitionTypes } from '../util/obs_enums';
+import { EOBSInputTypes, EOBSTransitionTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
 const testName = 'osn-transition';
@@ -133,6 +134,43 @@ describe(testName, () => {
         scene.release();         
     });
 
+    it('Preload a scene before transitioning to it', async () => {
+        const transition = osn.TransitionFactory.create(EOBSTransitionTypes.Cut, 'preload_transition');
+        osn.Global.setOutputSource(0, transition);
+        const scene = osn.SceneFactory.create('preload_scene');
+
+        // A media input only reports ready once it opened its file
+        const media = path.join(path.normalize(__dirname), '..', '..', '..', 'obs-studio-server', 'resources', 'roboto.png');
+        const input = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'preload_media', { local_file: media, is_local_file: true });
+        scene.add(input);
+
+        let state = osn.TransitionFactory.preload(scene);
+        expect(state.totalSources).to.equal(1, 'Preloaded scene reports the wrong number of sources');
+        expect(input.showing).to.equal(true, 'Preloaded scene is not showing');
+
+        // Poll until every source reports ready
+        for (let i = 0; i < 50 && !state.ready; i++) {
+            await sleep(100);
+            state = osn.TransitionFactory.preloadState(scene);
+        }
+        expect(state.ready).to.equal(true, 'Preloaded scene never became ready');
+        expect(state.readySources).to.equal(state.totalSources, 'Ready sources do not add up');
+
+        // The warm cache is opt-in, without it the preload is dropped once the transition shows the scene
+        expect(osn.TransitionFactory.warmCacheSize).to.equal(0, 'Warm cache is not disabled by default');
+
+        transition.start(0, scene);
+        expect(input.showing).to.equal(true, 'Scene stopped showing when the transition started');
+
+        osn.TransitionFactory.releasePreload(scene);
+        expect(input.showing).to.equal(true, 'Scene stopped showing when its preload was released');
+
+        osn.Global.setOutputSource(0, undefined);
+        transition.release();
+        input.release();
+        scene.release();
+    });
+
     it('Fail test - Try to get source from transition without setting in to transition', () => {
         let source: ISource;
         let transition: ITransition;
@@ -3,7 +3,8 @@ import { expect } from 'chai';
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { OBSHandler } from '../util/obs_handler';
-import { deleteConfigFiles } from '../util/general';
+import { deleteConfigFiles, sleep } from '../util/general';
+import { EOBSInputTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 import { EFPSType } from '../osn';
 
@@ -159,4 +160,57 @@ describe(testName, () => {
 
         context.destroy();
     });
+
+    it('Render inputs shared between video contexts once per frame', async () => {
+        const firstContext = osn.VideoFactory.create();
+        const secondContext = osn.VideoFactory.create();
+
+        const scene = osn.SceneFactory.create('shared_compositing_scene');
+        osn.Global.setOutputSource(0, scene);
+        const source = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'shared_compositing_color', { width: 200, height: 200 });
+
+        osn.VideoFactory.sharedCompositing = true;
+        expect(osn.VideoFactory.sharedCompositing).to.equal(true, 'Shared compositing was not enabled');
+
+        // The probe counts the input's own renders, the cache is attached on top of it below
+        const probe = osn.FilterFactory.create('osn_render_probe', 'shared_compositing_probe');
+        source.addFilter(probe);
+
+        // The same input shown on both canvases with different transforms
+        const firstItem = scene.add(source);
+        firstItem.video = firstContext;
+        firstItem.position = { x: 10, y: 10 };
+        const secondItem = scene.add(source);
+        secondItem.video = secondContext;
+        secondItem.position = { x: 100, y: 300 };
+        secondItem.scale = { x: 2, y: 2 };
+
+        await sleep(500);
+
+        const before = osn.VideoFactory.compositingStats;
+        await sleep(1000);
+        const after = osn.VideoFactory.compositingStats;
+
+        const frames = after.frames - before.frames;
+        const probed = after.probed - before.probed;
+        const reuses = after.reuses - before.reuses;
+        logInfo(testName, 'Shared compositing: ' + frames + ' frames, ' + probed + ' input renders, ' + reuses + ' reuses');
+
+        // One render of the input per frame, the second canvas samples the cache
+        expect(frames).to.be.greaterThan(0, 'No frame drew the shared input');
+        expect(probed).to.be.closeTo(frames, 1, 'Shared input was not rendered once per frame');
+        expect(reuses).to.be.greaterThan(0, 'Second canvas did not reuse the cached input');
+
+        osn.VideoFactory.sharedCompositing = false;
+        expect(osn.VideoFactory.sharedCompositing).to.equal(false, 'Shared compositing was not disabled');
+
+        firstItem.remove();
+        secondItem.remove();
+        source.removeFilter(probe);
+        probe.release();
+        source.release();
+        scene.release();
+        secondContext.destroy();
+        firstContext.destroy();
+    });
 });
@@ -33,6 +33,8 @@ export interface IConfigProgress {
     description: string;
     percentage?: number;
     continent?: string;
+    candidate?: string;
+    measurements?: { [name: string]: number };
 }
 
 export interface IVec2 {